@@ -0,0 +1,754 @@
+#include "mgutility/chrono/cache.hpp"
+#include "mgutility/chrono/columns.hpp"
+#include "mgutility/chrono/detect.hpp"
+#include "mgutility/chrono/duration.hpp"
+#include "mgutility/chrono/filter.hpp"
+#include "mgutility/chrono/format.hpp"
+#include "mgutility/chrono/incremental.hpp"
+#include "mgutility/chrono/instrument.hpp"
+#include "mgutility/chrono/parallel.hpp"
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/parse_many.hpp"
+#include "mgutility/chrono/plan.hpp"
+#include "mgutility/chrono/profiles.hpp"
+#include "mgutility/chrono/stream.hpp"
+#include "mgutility/chrono/tz.hpp"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<date/date.h>)
+#include <date/date.h>
+#define CHRONO_PARSE_BENCH_HAS_DATE
+#endif
+#endif
+
+#if defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+#define CHRONO_PARSE_BENCH_HAS_STD_PARSE
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHRONO_PARSE_BENCH_HAS_STRPTIME
+#endif
+
+// trunk-ignore-all(clang-format)
+
+namespace {
+
+auto make_tm(int32_t year) -> std::tm {
+  std::tm time_struct{};
+  time_struct.tm_year = year - 1900;
+  time_struct.tm_mon = 11;
+  time_struct.tm_mday = 31;
+  time_struct.tm_hour = 23;
+  time_struct.tm_min = 59;
+  time_struct.tm_sec = 59;
+  return time_struct;
+}
+
+// Per-call cost of the civil to epoch conversion, which must not depend on the year.
+void BM_mktime(benchmark::State &state) {
+  const auto time_struct = make_tm(static_cast<int32_t>(state.range(0)));
+  for (auto _ : state) {
+    std::time_t result{};
+    benchmark::DoNotOptimize(time_struct);
+    benchmark::DoNotOptimize(mgutility::chrono::detail::mktime(result, time_struct));
+    benchmark::DoNotOptimize(result);
+  }
+}
+BENCHMARK(BM_mktime)->Arg(1900)->Arg(1970)->Arg(2025)->Arg(2500)->Arg(5000)->Arg(7500)->Arg(9999);
+
+void BM_days_from_civil(benchmark::State &state) {
+  auto year = static_cast<int32_t>(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(year);
+    benchmark::DoNotOptimize(mgutility::chrono::detail::days_from_civil(year, 12, 31));
+  }
+}
+BENCHMARK(BM_days_from_civil)->Arg(1900)->Arg(1970)->Arg(2025)->Arg(2500)->Arg(5000)->Arg(7500)->Arg(9999);
+
+/**
+ * A single parse benchmark: one input, the chrono_parse format and the
+ * equivalent formats of the reference parsers (nullptr when a reference
+ * cannot express it).
+ */
+struct bench_case {
+  const char *name;
+  const char *format;
+  const char *input;
+  const char *strptime_format;
+  const char *std_format;
+};
+
+// One case per README specifier, plus fraction, offset, AM/PM, common log
+// layouts and failure variants.
+const bench_case bench_cases[] = {
+    {"Y", "{:%Y}", "2023", "%Y", nullptr},
+    {"m", "{:%m}", "05", "%m", nullptr},
+    {"d", "{:%d}", "14", "%d", nullptr},
+    {"H", "{:%H}", "16", "%H", nullptr},
+    {"M", "{:%M}", "31", "%M", nullptr},
+    {"S", "{:%S}", "59", "%S", nullptr},
+    {"F", "{:%F}", "2023-05-04", "%Y-%m-%d", "%F"},
+    {"T", "{:%T}", "16:31:59", "%H:%M:%S", nullptr},
+    {"FT", "{:%FT%T}", "2023-05-04T16:31:59", "%Y-%m-%dT%H:%M:%S", "%FT%T"},
+    {"f_short", "{:%FT%T.%f}", "2023-05-04T16:31:59.8", nullptr, "%FT%T"},
+    {"f_long", "{:%FT%T.%f}", "2023-05-04T16:31:59.123456789", nullptr, "%FT%T"},
+    {"z_utc", "{:%FT%T%z}", "2023-05-04T16:31:59Z", "%Y-%m-%dT%H:%M:%S%z", nullptr},
+    {"z_hhmm", "{:%FT%T%z}", "2023-05-04T18:31:59+0200", "%Y-%m-%dT%H:%M:%S%z", "%FT%T%z"},
+    {"z_hh_mm", "{:%FT%T%z}", "2023-05-04T18:31:59+02:00", "%Y-%m-%dT%H:%M:%S%z", "%FT%T%Ez"},
+    {"p", "{:%FT%H:%M:%S %p}", "2023-05-04T04:31:59 PM", "%Y-%m-%dT%I:%M:%S %p", "%FT%I:%M:%S %p"},
+    {"f_z", "{:%FT%T.%f%z}", "2023-05-04T18:31:59.123+0200", nullptr, "%FT%T%z"},
+    {"http", "{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:37 GMT", "%a, %d %b %Y %H:%M:%S GMT",
+     "%a, %d %b %Y %T GMT"},
+    {"syslog", "{:%b %e %T}", "Apr  3 14:05:01", "%b %e %H:%M:%S", "%b %e %T"},
+    {"I", "{:%F %I:%M %p}", "2023-05-04 04:31 PM", "%Y-%m-%d %I:%M %p", "%F %I:%M %p"},
+    {"y", "{:%y%m%d}", "230504", "%y%m%d", "%y%m%d"},
+    {"j", "{:%Y-%j}", "2024-060", "%Y-%j", "%Y-%j"},
+    {"GVu", "{:%G-W%V-%u}", "2020-W53-7", nullptr, "%G-W%V-%u"},
+    {"s", "{:%s}", "1682871738", "%s", nullptr},
+    {"fail_date", "{:%FT%T}", "2023-04-31T12:00:00", "%Y-%m-%dT%H:%M:%S", "%FT%T"},
+    {"fail_format", "{:%FT%T}", "not-a-date", "%Y-%m-%dT%H:%M:%S", "%FT%T"},
+    {"fail_fraction", "{:%FT%T.%f}", "2023-04-30T16:22:18.A", nullptr, nullptr},
+};
+
+void run_chrono_parse(benchmark::State &state, const bench_case &bench) {
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, bench.format, bench.input));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+
+#ifdef CHRONO_PARSE_BENCH_HAS_STRPTIME
+void run_strptime(benchmark::State &state, const bench_case &bench) {
+  for (auto _ : state) {
+    std::tm time_struct{};
+    const char *end = strptime(bench.input, bench.strptime_format, &time_struct);
+    benchmark::DoNotOptimize(end);
+    // timegm() resets tm_gmtoff
+    const long offset = time_struct.tm_gmtoff; // NOLINT(google-runtime-int)
+    benchmark::DoNotOptimize(timegm(&time_struct) - offset);
+  }
+}
+#endif
+
+// The baseline of the README performance claim.
+void run_get_time(benchmark::State &state, const bench_case &bench) {
+  for (auto _ : state) {
+    std::tm time_struct{};
+    std::istringstream stream{bench.input};
+    stream >> std::get_time(&time_struct, bench.strptime_format);
+    benchmark::DoNotOptimize(stream.fail());
+    benchmark::DoNotOptimize(std::mktime(&time_struct));
+  }
+}
+
+#ifdef CHRONO_PARSE_BENCH_HAS_STD_PARSE
+void run_std_parse(benchmark::State &state, const bench_case &bench) {
+  for (auto _ : state) {
+    std::chrono::sys_time<std::chrono::nanoseconds> time_point{};
+    std::istringstream stream{bench.input};
+    stream >> std::chrono::parse(bench.std_format, time_point);
+    benchmark::DoNotOptimize(stream.fail());
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+#endif
+
+#ifdef CHRONO_PARSE_BENCH_HAS_DATE
+void run_date_parse(benchmark::State &state, const bench_case &bench) {
+  for (auto _ : state) {
+    date::sys_time<std::chrono::nanoseconds> time_point{};
+    std::istringstream stream{bench.input};
+    stream >> date::parse(bench.std_format, time_point);
+    benchmark::DoNotOptimize(stream.fail());
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+#endif
+
+void register_bench_cases() {
+  for (const auto &bench : bench_cases) {
+    const std::string prefix = std::string{"BM_specifier/"} + bench.name + "/";
+    benchmark::RegisterBenchmark((prefix + "chrono_parse").c_str(), run_chrono_parse, bench);
+    if (bench.strptime_format != nullptr) {
+#ifdef CHRONO_PARSE_BENCH_HAS_STRPTIME
+      benchmark::RegisterBenchmark((prefix + "strptime_timegm").c_str(), run_strptime, bench);
+#endif
+      if (std::string{bench.strptime_format}.find("%z") == std::string::npos) {
+        benchmark::RegisterBenchmark((prefix + "get_time_mktime").c_str(), run_get_time, bench);
+      }
+    }
+    if (bench.std_format != nullptr) {
+#ifdef CHRONO_PARSE_BENCH_HAS_STD_PARSE
+      benchmark::RegisterBenchmark((prefix + "std_chrono_parse").c_str(), run_std_parse, bench);
+#endif
+#ifdef CHRONO_PARSE_BENCH_HAS_DATE
+      benchmark::RegisterBenchmark((prefix + "date_parse").c_str(), run_date_parse, bench);
+#endif
+    }
+  }
+}
+
+// A format used on a hot path, interpreted on every call versus compiled once.
+void BM_format_runtime(benchmark::State &state) {
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, "{:%FT%T.%f%z}", "2023-05-04T18:31:59.123+0200"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_format_runtime);
+
+void BM_format_compiled(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, format, "2023-05-04T18:31:59.123+0200"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_format_compiled);
+
+// A format known only at run time, reparsed on every call versus made into a
+// plan once; 0 is a fixed-width layout parsed at precomputed offsets, 1 has
+// variable-width fields and runs the plan's operations.
+const char *const plan_formats[] = {"{:%d.%m.%Y %H:%M:%S}", "{:%FT%T.%f%z}"};
+const char *const plan_inputs[] = {"04.05.2023 18:31:59", "2023-05-04T18:31:59.123+0200"};
+
+void BM_plan_reparse(benchmark::State &state) {
+  const std::string format = plan_formats[state.range(0)];
+  const mgutility::string_view date_str = plan_inputs[state.range(0)];
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, format, date_str));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_plan_reparse)->DenseRange(0, 1);
+
+void BM_plan(benchmark::State &state) {
+  const auto plan = mgutility::chrono::make_parser(std::string{plan_formats[state.range(0)]});
+  const mgutility::string_view date_str = plan_inputs[state.range(0)];
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, plan, date_str));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_plan)->DenseRange(0, 1);
+
+// Durations from configs and latency logs: 0 is ISO 8601, 1 has Go-style
+// unit suffixes. The baseline matches each component with std::regex.
+const char *const duration_inputs[] = {"PT1H30M15.250S", "1h30m15.25s"};
+
+auto regex_duration(const std::regex &pattern, const std::string &str) -> std::chrono::nanoseconds {
+  std::chrono::nanoseconds duration{};
+  for (std::sregex_iterator it{str.begin(), str.end(), pattern}, end; it != end; ++it) {
+    const double count = std::stod((*it)[1].str());
+    const std::string unit = (*it)[2].str();
+    const double seconds = unit == "H" || unit == "h" ? 3600 : unit == "M" || unit == "m" ? 60 : unit == "ms" ? 1e-3 : 1;
+    duration += std::chrono::nanoseconds{static_cast<int64_t>(count * seconds * 1e9)};
+  }
+  return duration;
+}
+
+void BM_duration_regex(benchmark::State &state) {
+  const std::regex pattern{state.range(0) == 0 ? "([0-9]+(?:[.,][0-9]+)?)([HMS])" : "([0-9]+(?:[.][0-9]+)?)(ms|h|m|s)"};
+  const std::string str = duration_inputs[state.range(0)];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(regex_duration(pattern, str));
+  }
+  state.SetLabel(duration_inputs[state.range(0)]);
+}
+BENCHMARK(BM_duration_regex)->DenseRange(0, 1);
+
+void BM_parse_duration(benchmark::State &state) {
+  const auto layout =
+      state.range(0) == 0 ? mgutility::chrono::duration_layout::iso8601 : mgutility::chrono::duration_layout::units;
+  const mgutility::string_view str = duration_inputs[state.range(0)];
+  std::chrono::nanoseconds duration{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse_duration(duration, layout, str));
+    benchmark::DoNotOptimize(duration);
+  }
+  state.SetLabel(duration_inputs[state.range(0)]);
+}
+BENCHMARK(BM_parse_duration)->DenseRange(0, 1);
+
+// The RFC 3339 profile against the same layout as a format string.
+void BM_profile_rfc3339(benchmark::State &state) {
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, mgutility::chrono::formats::rfc3339,
+                                                      "2023-05-04T18:31:59.123+02:00"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_profile_rfc3339);
+
+// The success path of the diagnostics overloads against the error_code ones.
+void BM_diagnostics_runtime(benchmark::State &state) {
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, "{:%FT%T.%f%z}", "2023-05-04T18:31:59.123+0200", mgutility::chrono::diagnostics));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_diagnostics_runtime);
+
+void BM_diagnostics_compiled(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, format, "2023-05-04T18:31:59.123+0200", mgutility::chrono::diagnostics));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_diagnostics_compiled);
+
+// Instrumentation policies against BM_format_compiled: no_instrumentation
+// must match it, as its hooks compile away.
+template <typename Policy> void BM_instrumented(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse<std::chrono::system_clock, Policy>(
+        time_point, format, "2023-05-04T18:31:59.123+0200"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK_TEMPLATE(BM_instrumented, mgutility::chrono::no_instrumentation);
+BENCHMARK_TEMPLATE(BM_instrumented, mgutility::chrono::count_instrumentation);
+BENCHMARK_TEMPLATE(BM_instrumented, mgutility::chrono::cycle_instrumentation);
+
+// Integer microseconds for a columnar sink: one step against a time point
+// followed by a cast.
+void BM_epoch_micros_cast(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, format, "2023-05-04T18:31:59.123+0200"));
+    benchmark::DoNotOptimize(std::chrono::duration_cast<std::chrono::microseconds>(time_point.time_since_epoch()).count());
+  }
+}
+BENCHMARK(BM_epoch_micros_cast);
+
+void BM_epoch_micros(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  int64_t count = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse_epoch<std::micro>(count, format, "2023-05-04T18:31:59.123+0200"));
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_epoch_micros);
+
+// Formatting, the inverse of parsing, against strftime.
+void BM_format_to(benchmark::State &state) {
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  const auto time_point = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
+  char buffer[64];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::format_to(buffer, format, time_point, std::chrono::hours{2}));
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_format_to);
+
+void BM_strftime(benchmark::State &state) {
+  const auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) + 7200;
+  char buffer[64];
+  for (auto _ : state) {
+    std::tm time_struct{};
+#ifdef CHRONO_PARSE_BENCH_HAS_STRPTIME
+    gmtime_r(&time, &time_struct);
+#else
+    time_struct = *std::gmtime(&time);
+#endif
+    benchmark::DoNotOptimize(std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S+0200", &time_struct));
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_strftime);
+
+constexpr std::size_t column_size = 4096;
+
+// A column of distinct timestamps one second and one millisecond apart.
+auto make_column(const char *format) -> std::vector<std::string> {
+  std::vector<std::string> column;
+  column.reserve(column_size);
+  for (std::size_t i = 0; i < column_size; ++i) {
+    char buffer[64];
+    const auto minute = static_cast<int>(i / 60 % 60);
+    const auto second = static_cast<int>(i % 60);
+    std::snprintf(buffer, sizeof(buffer), format, static_cast<int>(i % 24), minute, second, static_cast<int>(i % 1000));
+    column.emplace_back(buffer);
+  }
+  return column;
+}
+
+auto make_views(const std::vector<std::string> &column) -> std::vector<mgutility::string_view> {
+  std::vector<mgutility::string_view> views;
+  views.reserve(column.size());
+  for (const auto &str : column) {
+    views.emplace_back(str.data(), str.size());
+  }
+  return views;
+}
+
+const char *const column_formats[] = {"{:%FT%T}", "{:%FT%T.%f}", "{:%FT%T%z}"};
+const char *const column_layouts[] = {"2023-04-30T%02d:%02d:%02d", "2023-04-30T%02d:%02d:%02d.%03d",
+                                      "2023-04-30T%02d:%02d:%02d+0200"};
+
+// Baseline: one parse() call per element.
+void BM_column_parse_loop(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  std::vector<std::chrono::system_clock::time_point> output(views.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < views.size(); ++i) {
+      benchmark::DoNotOptimize(mgutility::chrono::parse(output[i], column_formats[index], views[i]));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_column_parse_loop)->DenseRange(0, 2);
+
+void BM_column_parse_many(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  std::vector<std::chrono::system_clock::time_point> output(views.size());
+  std::vector<std::errc> errors(views.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse_many(column_formats[index], views.data(), views.size(),
+                                                           output.data(), errors.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_column_parse_many)->DenseRange(0, 2);
+
+// One pass that also fills year/month/day/hour partition columns from an
+// arena; compare with BM_column_parse_loop.
+void BM_column_parse_columns(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  mgutility::chrono::column_arena arena{};
+  for (auto _ : state) {
+    arena.reset();
+    mgutility::chrono::time_columns<std::milli> columns{
+        arena, views.size(),
+        mgutility::chrono::column_year | mgutility::chrono::column_month | mgutility::chrono::column_day |
+            mgutility::chrono::column_hour};
+    benchmark::DoNotOptimize(
+        mgutility::chrono::parse_columns(column_formats[index], views.data(), views.size(), columns));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_column_parse_columns)->DenseRange(0, 2);
+
+// The column shares its date, so every element after the first reuses the
+// cached prefix; compare with BM_column_parse_loop.
+void BM_column_cached_parser(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  std::vector<std::chrono::system_clock::time_point> output(views.size());
+  mgutility::chrono::cached_parser<> parser{column_formats[index]};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < views.size(); ++i) {
+      benchmark::DoNotOptimize(parser.parse(output[i], views[i]));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_column_cached_parser)->DenseRange(0, 2);
+
+// Selecting the hour from 14:00 of the column, which holds 1/24 of it, by
+// parsing and comparing each element.
+auto filter_window(std::size_t index) -> std::pair<std::chrono::system_clock::time_point, std::chrono::system_clock::time_point> {
+  // 2023-04-30T14:00:00 at the offset of the column
+  const std::chrono::system_clock::time_point from{std::chrono::seconds{1682863200 - (index == 2 ? 7200 : 0)}};
+  return {from, from + std::chrono::hours{1}};
+}
+
+void BM_filter_parse(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  const auto window = filter_window(index);
+  std::vector<std::size_t> selected(views.size());
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < views.size(); ++i) {
+      std::chrono::system_clock::time_point time_point{};
+      if (!mgutility::chrono::parse(time_point, column_formats[index], views[i]) && !(time_point < window.first) &&
+          time_point < window.second) {
+        selected[count++] = i;
+      }
+    }
+    benchmark::DoNotOptimize(count);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_filter_parse)->DenseRange(0, 2);
+
+// The same selection with time_filter, which rejects the other hours by
+// comparing bytes.
+void BM_filter_select(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  const auto views = make_views(column);
+  const auto window = filter_window(index);
+  const mgutility::chrono::time_filter<> filter{column_formats[index], window.first, window.second,
+                                                std::chrono::minutes{index == 2 ? 120 : 0}};
+  std::vector<std::size_t> selected(views.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(filter.select(views.data(), views.size(), selected.data()));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * views.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_filter_select)->DenseRange(0, 2);
+
+// Mixed-source ingestion: the input is in the last of four candidate
+// formats. The cascade tries each format with the throwing parse(); the
+// detector remembers the winning format after the first record.
+const char *const detect_formats[] = {"{:%FT%T%z}", "{:%Y/%m/%d %T}", "{:%F %T}", "{:%d.%m.%Y %H:%M:%S %p}"};
+
+void BM_detect_cascade(benchmark::State &state) {
+  for (auto _ : state) {
+    std::chrono::system_clock::time_point time_point{};
+    for (const auto *format : detect_formats) {
+      try {
+        time_point = mgutility::chrono::parse(format, "30.04.2023 04:22:18 PM");
+        break;
+      } catch (const std::system_error &) {
+      }
+    }
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_detect_cascade);
+
+void BM_detect_cached(benchmark::State &state) {
+  mgutility::chrono::format_detector<> detector{detect_formats[0], detect_formats[1], detect_formats[2],
+                                                detect_formats[3]};
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(detector.parse(time_point, "30.04.2023 04:22:18 PM"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_detect_cached);
+
+// Alternating sources defeat the cache; shapes rule out the other formats.
+void BM_detect_alternating(benchmark::State &state) {
+  mgutility::chrono::format_detector<> detector{detect_formats[0], detect_formats[1], detect_formats[2],
+                                                detect_formats[3]};
+  const char *const inputs[] = {"30.04.2023 04:22:18 PM", "2023-04-30T16:22:18Z"};
+  std::chrono::system_clock::time_point time_point{};
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(detector.parse(time_point, inputs[i++ & 1U]));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_detect_alternating);
+
+// Scaling curve of parallel_parse() over a 1M element column; compare the
+// items_per_second of each thread count with the single-threaded run.
+void BM_parallel_parse(benchmark::State &state) {
+  const auto column = make_column(column_layouts[1]);
+  const auto views = make_views(column);
+  std::vector<mgutility::string_view> input;
+  input.reserve(views.size() * 256);
+  for (int i = 0; i < 256; ++i) {
+    input.insert(input.end(), views.begin(), views.end());
+  }
+  std::vector<std::chrono::system_clock::time_point> output(input.size());
+  const mgutility::chrono::parallel_options options{static_cast<unsigned>(state.range(0)), 0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        mgutility::chrono::parallel_parse(column_formats[1], input.data(), input.size(), output.data(), nullptr, options));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_parallel_parse)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+#ifdef CHRONO_PARSE_BENCH_HAS_STRPTIME
+const char *const column_strptime_formats[] = {"%Y-%m-%dT%H:%M:%S", nullptr, "%Y-%m-%dT%H:%M:%S%z"};
+
+void BM_column_strptime_timegm(benchmark::State &state) {
+  const auto index = static_cast<std::size_t>(state.range(0));
+  const auto column = make_column(column_layouts[index]);
+  std::vector<std::time_t> output(column.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < column.size(); ++i) {
+      std::tm time_struct{};
+      benchmark::DoNotOptimize(strptime(column[i].c_str(), column_strptime_formats[index], &time_struct));
+      const long offset = time_struct.tm_gmtoff; // NOLINT(google-runtime-int)
+      output[i] = timegm(&time_struct) - offset;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column.size()));
+  state.SetLabel(column_formats[index]);
+}
+BENCHMARK(BM_column_strptime_timegm)->Arg(0)->Arg(2);
+#endif
+
+// Zone names resolve through the shared zone database; compare with the
+// numeric offset path they replace.
+void BM_zone_offset(benchmark::State &state) {
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, "{:%F %T %z}", "2023-05-04 18:31:59 +0300"));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_zone_offset);
+
+void BM_zone_name(benchmark::State &state) {
+  const auto &database = mgutility::chrono::get_tzdb();
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, "{:%F %T %Z}", "2023-05-04 18:31:59 Europe/Istanbul", database));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_zone_name);
+
+void BM_zone_abbreviation(benchmark::State &state) {
+  const auto &database = mgutility::chrono::get_tzdb();
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, "{:%F %T %Z}", "2023-05-04 18:31:59 CET", database));
+    benchmark::DoNotOptimize(time_point);
+  }
+}
+BENCHMARK(BM_zone_abbreviation);
+
+// A synthetic log of timestamped lines with messages of varying length, fed
+// whole and in 4 KiB chunks as a socket reader would.
+auto make_log() -> std::string {
+  const auto column = make_column(column_layouts[0]);
+  std::string log;
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    log += column[i];
+    log += " INFO request served in ";
+    log.append(i % 64, 'x');
+    log += '\n';
+  }
+  return log;
+}
+
+void BM_stream_feed(benchmark::State &state) {
+  const auto log = make_log();
+  const auto chunk_size = state.range(0) == 0 ? log.size() : static_cast<std::size_t>(state.range(0));
+  auto reader = mgutility::chrono::make_record_reader(mgutility::chrono::compile("{:%FT%T}"));
+  int64_t sum = 0;
+  const auto on_record = [&](std::chrono::system_clock::time_point time_point, mgutility::string_view rest) {
+    sum += time_point.time_since_epoch().count() + static_cast<int64_t>(rest.size());
+  };
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < log.size(); i += chunk_size) {
+      reader.feed(mgutility::string_view{log.data() + i, std::min(chunk_size, log.size() - i)}, on_record);
+    }
+    reader.finish(on_record);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * column_size));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log.size()));
+}
+BENCHMARK(BM_stream_feed)->Arg(0)->Arg(4096);
+
+// Splitting alone, the lower bound for BM_stream_feed
+void BM_stream_memchr(benchmark::State &state) {
+  const auto log = make_log();
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (const char *first = log.data(), *last = log.data() + log.size();; ++count) {
+      const void *found = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+      if (found == nullptr) {
+        break;
+      }
+      first = static_cast<const char *>(found) + 1;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * log.size()));
+}
+BENCHMARK(BM_stream_memchr);
+
+// A timestamp arriving from a protocol decoder, fed whole (0), one byte at a
+// time (1) or in 4-byte pieces, against parsing it in one piece with a plan.
+const char incremental_input[] = "2023-05-04T18:31:59.123+0200";
+
+void BM_incremental_plan(benchmark::State &state) {
+  const auto plan = mgutility::chrono::make_parser("{:%FT%T.%f%z}");
+  std::chrono::system_clock::time_point time_point{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mgutility::chrono::parse(time_point, plan, incremental_input));
+    benchmark::DoNotOptimize(time_point);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (sizeof(incremental_input) - 1)));
+}
+BENCHMARK(BM_incremental_plan);
+
+void BM_incremental_feed(benchmark::State &state) {
+  mgutility::chrono::incremental_parser<> parser{"{:%FT%T.%f%z}"};
+  const mgutility::string_view input = incremental_input;
+  const auto piece = state.range(0) == 0 ? input.size() : static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    parser.reset();
+    for (std::size_t i = 0; i < input.size(); i += piece) {
+      parser.feed(input.substr(i, piece));
+    }
+    benchmark::DoNotOptimize(parser.finish());
+    benchmark::DoNotOptimize(parser.time());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_incremental_feed)->Arg(0)->Arg(1)->Arg(4);
+
+} // namespace
+
+int main(int argc, char **argv) {
+  register_bench_cases();
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,41 @@
+// Code size and latency of one specifier set, built by scripts/footprint.sh
+// with -DFOOTPRINT_FORMAT='"{:%FT%T}"' -DFOOTPRINT_INPUT='"..."'.
+// FOOTPRINT_RUNTIME parses with the format string instead of a compiled
+// format, and FOOTPRINT_NO_MAIN leaves only the parsing code in the object.
+#include "mgutility/chrono/parse.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+extern "C" auto footprint_parse(const char *str, std::size_t size, int64_t *count) -> int {
+#ifdef FOOTPRINT_RUNTIME
+  const mgutility::string_view format = FOOTPRINT_FORMAT;
+#else
+  MGUTILITY_CNSTXPR auto format = mgutility::chrono::compile(FOOTPRINT_FORMAT);
+#endif
+  return static_cast<int>(mgutility::chrono::parse_epoch<std::nano>(*count, format, mgutility::string_view{str, size},
+                                                                    mgutility::chrono::diagnostics)
+                              .error);
+}
+
+#ifndef FOOTPRINT_NO_MAIN
+int main() {
+  constexpr int iterations = 1000000;
+  const char input[] = FOOTPRINT_INPUT;
+  int64_t count = 0;
+  int64_t checksum = 0;
+  int failures = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    // Keep the input opaque so the parse is not hoisted out of the loop
+    const char *volatile str = input;
+    failures += footprint_parse(str, sizeof(input) - 1, &count);
+    checksum += count;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  std::printf("%.1f %d %lld\n", std::chrono::duration<double, std::nano>(elapsed).count() / iterations, failures,
+              static_cast<long long>(checksum));
+  return failures != 0;
+}
+#endif
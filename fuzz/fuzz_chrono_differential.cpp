@@ -0,0 +1,152 @@
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+// trunk-ignore-all(clang-format)
+
+// Compares parse_epoch() with strptime() + timegm() for every specifier the
+// C library parses the same way: %Y %m %d %H %M %S %F %T %y %e %I %p %b %B
+// %a %A %z and %s. The input picks a format, an instant and an offset, and
+// up to three edits of the canonical date string:
+//   - the canonical string must parse to the instant with both parsers;
+//   - after mutation, whenever both parsers accept the whole string they
+//     must agree.
+// %j, %G, %V and %u are left out because strptime() does not turn them into
+// a date, and %f and %Z because it has no equivalent.
+
+namespace {
+
+struct reference_format {
+  const char *format;          ///< Our format.
+  const char *strptime_format; ///< The same layout for strptime().
+  bool offset;                 ///< The layout ends with an offset.
+  int64_t resolution;          ///< The smallest unit of the layout in seconds.
+};
+
+const reference_format formats[] = {
+    {"{:%FT%T}", "%Y-%m-%dT%H:%M:%S", false, 1},
+    {"{:%Y%m%d%H%M%S}", "%Y%m%d%H%M%S", false, 1},
+    {"{:%F %T%z}", "%Y-%m-%d %H:%M:%S%z", true, 1},
+    {"{:%a, %d %b %Y %T %z}", "%a, %d %b %Y %H:%M:%S %z", true, 1},
+    {"{:%A, %B %e %Y %I:%M:%S %p}", "%A, %B %e %Y %I:%M:%S %p", false, 1},
+    {"{:%b %e %T %Y}", "%b %e %H:%M:%S %Y", false, 1},
+    {"{:%y-%m-%d %H:%M}", "%y-%m-%d %H:%M", false, 60},
+    {"{:%s}", "%s", false, 1},
+};
+
+// Four-digit years even after an offset of up to 14 hours
+constexpr int64_t min_seconds = -30610224000 + 50400; // 1000-01-01T14:00:00Z
+constexpr int64_t max_seconds = 253402300799 - 50400; // 9999-12-31T09:59:59Z
+constexpr int64_t min_short_year = -31536000; // 1969-01-01T00:00:00Z
+constexpr int64_t max_short_year = 3124223999; // 2068-12-31T23:59:59Z
+
+class reader {
+public:
+  reader(const uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+
+  auto next(std::size_t bytes) -> uint64_t {
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes && pos_ < size_; ++i) {
+      value = (value << 8) | data_[pos_++];
+    }
+    return value;
+  }
+
+private:
+  const uint8_t *data_;
+  std::size_t size_;
+  std::size_t pos_{};
+};
+
+void fail(const char *what, const reference_format &format, const std::string &input, int64_t ours,
+          int64_t theirs) {
+  std::string escaped;
+  for (const char chr : input) {
+    char hex[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::snprintf(hex, sizeof(hex), "\\x%02x", static_cast<unsigned char>(chr));
+    escaped += chr >= ' ' && chr <= '~' ? std::string(1, chr) : std::string(hex);
+  }
+  std::fprintf(stderr, "fuzz_chrono_differential: %s\n  format %s\n  input  \"%s\"\n  ours %lld, strptime %lld\n", what,
+               format.format, escaped.c_str(), static_cast<long long>(ours), static_cast<long long>(theirs));
+  std::abort();
+}
+
+auto parse_ours(const std::string &input, const reference_format &format, int64_t &seconds) -> bool {
+  return mgutility::chrono::parse_epoch<std::ratio<1>>(seconds, format.format, input, mgutility::chrono::diagnostics)
+      .ok();
+}
+
+auto parse_theirs(const std::string &input, const reference_format &format, int64_t &seconds) -> bool {
+  std::tm time_struct{};
+  const char *end = strptime(input.c_str(), format.strptime_format, &time_struct);
+  if (end == nullptr || *end != '\0') {
+    return false;
+  }
+  // timegm() resets tm_gmtoff
+  const long offset = time_struct.tm_gmtoff; // NOLINT(google-runtime-int)
+  seconds = static_cast<int64_t>(timegm(&time_struct)) - offset;
+  return true;
+}
+
+auto render(const reference_format &format, int64_t seconds, int32_t offset) -> std::string {
+  const auto local = static_cast<std::time_t>(seconds + offset);
+  std::tm time_struct{};
+  gmtime_r(&local, &time_struct);
+  time_struct.tm_gmtoff = offset;
+  char buffer[128]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  const std::size_t size = std::strftime(buffer, sizeof(buffer), format.strptime_format, &time_struct);
+  return std::string(buffer, size);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerInitialize(int * /*argc*/, char *** /*argv*/) {
+  // strptime() reads %s in the local time zone
+  setenv("TZ", "UTC", 1);
+  tzset();
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size) {
+  reader input{data, size};
+  const auto &format = formats[input.next(1) % (sizeof(formats) / sizeof(formats[0]))];
+  const bool short_year = std::strstr(format.format, "%y") != nullptr;
+  const int64_t low = short_year ? min_short_year : min_seconds;
+  const int64_t high = short_year ? max_short_year : max_seconds;
+  int64_t seconds = low + static_cast<int64_t>(input.next(5) % static_cast<uint64_t>(high - low + 1));
+  seconds -= ((seconds % format.resolution) + format.resolution) % format.resolution;
+  // strptime() accepts offsets up to 12 hours
+  const int32_t offset = format.offset ? (static_cast<int32_t>(input.next(2) % 1441) - 720) * 60 : 0;
+
+  std::string text = render(format, seconds, offset);
+  int64_t ours = 0;
+  int64_t theirs = 0;
+  if (!parse_ours(text, format, ours) || ours != seconds) {
+    fail("canonical input rejected or misread", format, text, ours, seconds);
+  }
+  if (!parse_theirs(text, format, theirs) || theirs != seconds) {
+    // The reference is wrong about its own output, e.g. for distant years
+    return 0;
+  }
+
+  // A few edits keep most mutated strings close enough to parse
+  for (uint64_t edits = input.next(1) % 4; edits != 0 && !text.empty(); --edits) {
+    const std::size_t pos = static_cast<std::size_t>(input.next(1)) % text.size();
+    const auto byte = static_cast<char>(input.next(1));
+    if (byte == '\0') {
+      text.erase(pos, 1);
+    } else {
+      text[pos] = byte;
+    }
+  }
+  if (parse_ours(text, format, ours) && parse_theirs(text, format, theirs) && ours != theirs) {
+    fail("parsers disagree", format, text, ours, theirs);
+  }
+  return 0;
+}
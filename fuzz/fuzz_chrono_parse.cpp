@@ -0,0 +1,176 @@
+#include "mgutility/chrono/cache.hpp"
+#include "mgutility/chrono/detect.hpp"
+#include "mgutility/chrono/duration.hpp"
+#include "mgutility/chrono/incremental.hpp"
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/parse_many.hpp"
+#include "mgutility/chrono/plan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+// Parses an arbitrary format and date string through every entry point and
+// checks that they agree. The input is one byte with the length of the
+// format, the format, then the date string. A newline in the date string
+// splits it into two dates, which the parsers that keep state between inputs
+// (cached_parser and format_detector) read in turn; without one the date is
+// read twice. Every string is copied into a buffer of its exact size, so
+// AddressSanitizer reports any read past its end.
+
+namespace {
+
+using time_point = std::chrono::system_clock::time_point;
+
+void check(bool condition, const char *what) {
+  if (!condition) {
+    std::fprintf(stderr, "fuzz_chrono_parse: %s\n", what);
+    std::abort();
+  }
+}
+
+// Compiled formats reject an invalid format before reading the input, while
+// a format string may fail on the input first, so they only have to agree
+// that parsing failed.
+auto same(const mgutility::chrono::parse_result &compiled, const mgutility::chrono::parse_result &result) -> bool {
+  if (compiled.stage == mgutility::chrono::parse_stage::format) {
+    return !result.ok();
+  }
+  return compiled.error == result.error && compiled.stage == result.stage && compiled.position == result.position &&
+         compiled.specifier == result.specifier;
+}
+
+// Checks every entry point that keeps no state between inputs against
+// parse() for one date, and returns the result of parse().
+auto check_input(mgutility::string_view format, mgutility::string_view date, time_point &expected)
+    -> mgutility::chrono::parse_result {
+  const auto result = mgutility::chrono::parse(expected, format, date, mgutility::chrono::diagnostics);
+  check(!result.ok() || result.position <= date.size(), "position past the end of a parsed input");
+  check(result.ok() == (result.stage == mgutility::chrono::parse_stage::none), "stage disagrees with error");
+
+  // The compiled operations, the plan's fixed-width path and the batch kernel
+  // must give the same answer as the format string; formats too long for a
+  // plan are rejected when it is made
+  const auto plan = mgutility::chrono::make_parser(format);
+  if (plan.error() != std::errc::value_too_large) {
+    time_point actual{};
+    const auto plan_result = mgutility::chrono::parse(actual, plan, date, mgutility::chrono::diagnostics);
+    check(same(plan_result, result), "parse_plan disagrees with parse()");
+    check(!result.ok() || actual == expected, "parse_plan time point differs");
+  }
+
+  // The incremental parser reads the input whole and one byte at a time; the
+  // end of a successful parse differs, as it leaves the skipped character
+  mgutility::chrono::incremental_parser<> incremental{format};
+  if (incremental.error() == std::errc{}) {
+    for (int pass = 0; pass < 2; ++pass) {
+      incremental.reset();
+      for (std::size_t i = 0; i < date.size() && pass == 1; ++i) {
+        incremental.feed(date.substr(i, 1));
+      }
+      incremental.feed(pass == 0 ? date : mgutility::string_view{});
+      const auto status = incremental.finish();
+      const auto incremental_result = incremental.result();
+      check(!incremental_result.ok() || incremental_result.position <= date.size(),
+            "incremental position past the end of a parsed input");
+      check((status == mgutility::chrono::feed_status::done) == result.ok(), "incremental_parser status differs");
+      check(incremental_result.error == result.error && incremental_result.stage == result.stage &&
+                incremental_result.specifier == result.specifier,
+            "incremental_parser disagrees with parse()");
+      check((result.stage != mgutility::chrono::parse_stage::field &&
+             result.stage != mgutility::chrono::parse_stage::separator) ||
+                incremental_result.position == result.position,
+            "incremental_parser position differs");
+      check(!result.ok() || incremental.time() == expected, "incremental_parser time point differs");
+    }
+  }
+
+  time_point batch{};
+  std::errc batch_error{};
+  mgutility::chrono::parse_many(format, &date, 1, &batch, &batch_error);
+  check(batch_error == result.error, "parse_many() error differs");
+  check(!result.ok() || batch == expected, "parse_many() time point differs");
+
+  int64_t seconds = 0;
+  const auto epoch_result = mgutility::chrono::parse_epoch<std::ratio<1>>(seconds, format, date, mgutility::chrono::diagnostics);
+  check(epoch_result.ok() || !result.ok(), "parse_epoch() rejects what parse() accepts");
+
+  // The duration parsers read the same input and must stay within it
+  for (const auto layout : {mgutility::chrono::duration_layout::iso8601, mgutility::chrono::duration_layout::units}) {
+    std::chrono::nanoseconds duration{};
+    const auto duration_result = mgutility::chrono::parse_duration(duration, layout, date, mgutility::chrono::diagnostics);
+    check(duration_result.position <= date.size(), "duration position past the end of the input");
+  }
+  std::chrono::nanoseconds clock_duration{};
+  mgutility::chrono::parse_duration(clock_duration, format, date, mgutility::chrono::diagnostics);
+  return result;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+  const std::size_t format_size = data[0] < size - 1 ? data[0] : size - 1;
+  std::unique_ptr<char[]> format_buffer(new char[format_size]);
+  std::memcpy(format_buffer.get(), data + 1, format_size);
+  const mgutility::string_view format{format_buffer.get(), format_size};
+
+  const auto *const first = data + 1 + format_size;
+  const auto *const last = data + size;
+  const auto *split = static_cast<const uint8_t *>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+  const std::size_t first_size = static_cast<std::size_t>((split != nullptr ? split : last) - first);
+  const std::size_t second_size = split != nullptr ? static_cast<std::size_t>(last - split - 1) : first_size;
+  std::unique_ptr<char[]> first_buffer(new char[first_size]);
+  std::unique_ptr<char[]> second_buffer(new char[second_size]);
+  std::memcpy(first_buffer.get(), first, first_size);
+  std::memcpy(second_buffer.get(), split != nullptr ? split + 1 : first, second_size);
+  const mgutility::string_view dates[] = {{first_buffer.get(), first_size}, {second_buffer.get(), second_size}};
+
+  time_point expected[2]{};
+  mgutility::chrono::parse_result results[2]{};
+  results[0] = check_input(format, dates[0], expected[0]);
+  results[1] = split != nullptr ? check_input(format, dates[1], expected[1]) : results[0];
+  expected[1] = expected[split != nullptr ? 1 : 0];
+
+  // The cached prefix of one date must not leak into the next; the first
+  // date comes back last to hit the cache it filled
+  mgutility::chrono::cached_parser<> cached{format};
+  for (const int i : {0, 1, 0}) {
+    time_point actual{};
+    const auto cached_result = cached.parse(actual, dates[i], mgutility::chrono::diagnostics);
+    check(same(cached_result, results[i]), "cached_parser disagrees with parse()");
+    check(!results[i].ok() || actual == expected[i], "cached_parser time point differs");
+  }
+
+  // The detector parses a date in a format of its shape that parses, and in
+  // the format it reports as last
+  mgutility::chrono::format_detector<> detector{format, "{:%FT%T%z}", "{:%FT%T}"};
+  for (const int i : {0, 1, 0}) {
+    bool parses = false;
+    for (std::size_t index = 0; index < detector.size(); ++index) {
+      time_point unused{};
+      parses = parses || (mgutility::chrono::detail::match_shape(detector.format(index), dates[i]) &&
+                          mgutility::chrono::parse(unused, detector.format(index), dates[i]) == std::error_code{});
+    }
+    time_point actual{};
+    const bool detected = detector.parse(actual, dates[i]) == std::errc{};
+    check(detected == parses, "format_detector disagrees with the shapes that parse");
+    if (detected) {
+      const auto chosen = detector.format(detector.last());
+      time_point reference{};
+      check(mgutility::chrono::detail::match_shape(chosen, dates[i]), "format_detector used a format of another shape");
+      check(mgutility::chrono::parse(reference, chosen, dates[i]) == std::error_code{} && actual == reference,
+            "format_detector time point differs");
+    }
+  }
+  return 0;
+}
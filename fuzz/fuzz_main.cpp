@@ -0,0 +1,223 @@
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// trunk-ignore-all(clang-format)
+
+// Runs a fuzz target where libFuzzer is not available, e.g. with GCC. It
+// accepts the libFuzzer flags the CMake targets and scripts use:
+//
+//   fuzz_target [-runs=N] [-max_total_time=S] [-seed=N] [-max_len=N] [file|dir]...
+//
+// Every file, and every file in a directory, is run once; then inputs made by
+// randomly mutating them (or random bytes without any) are run until -runs
+// or -max_total_time is reached. An input that crashes is written to
+// crash-input. The final statistics use libFuzzer's names.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, std::size_t size);
+extern "C" __attribute__((weak)) int LLVMFuzzerInitialize(int *argc, char ***argv);
+
+namespace {
+
+const uint8_t *current_data = nullptr;
+std::size_t current_size = 0;
+
+// Saves the input being run, using only async-signal-safe calls.
+extern "C" void save_crash(int signal) {
+#if !defined(_WIN32)
+  const int descriptor = ::open("crash-input", O_WRONLY | O_CREAT | O_TRUNC, 0644); // NOLINT
+  if (descriptor >= 0) {
+    const ssize_t written = ::write(descriptor, current_data, current_size);
+    (void)written;
+    ::close(descriptor);
+  }
+  const char message[] = "fuzz_main: crashing input written to crash-input\n"; // NOLINT
+  const ssize_t printed = ::write(2, message, sizeof(message) - 1);
+  (void)printed;
+#endif
+  std::signal(signal, SIG_DFL);
+  std::raise(signal);
+}
+
+void execute(const std::vector<uint8_t> &input) {
+  current_data = input.data();
+  current_size = input.size();
+  LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+auto read_input(const std::string &path, std::vector<uint8_t> &content) -> bool {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  content.clear();
+  uint8_t chunk[4096]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  std::size_t read = 0;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) != 0) {
+    content.insert(content.end(), chunk, chunk + read); // NOLINT
+  }
+  std::fclose(file);
+  return true;
+}
+
+void collect(const std::string &path, std::vector<std::vector<uint8_t>> &seeds) {
+#if !defined(_WIN32)
+  struct stat status {};
+  if (::stat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode)) {
+    DIR *directory = ::opendir(path.c_str());
+    if (directory == nullptr) {
+      return;
+    }
+    while (const dirent *entry = ::readdir(directory)) {
+      if (entry->d_name[0] != '.') {
+        collect(path + "/" + entry->d_name, seeds);
+      }
+    }
+    ::closedir(directory);
+    return;
+  }
+#endif
+  std::vector<uint8_t> content;
+  if (read_input(path, content)) {
+    seeds.push_back(content);
+  }
+}
+
+class xorshift {
+public:
+  explicit xorshift(uint64_t seed) : state_(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+  auto operator()(uint64_t bound) -> uint64_t {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return bound != 0 ? state_ % bound : 0;
+  }
+
+private:
+  uint64_t state_;
+};
+
+// Overwrites, inserts or erases a few bytes, or copies a run within the input.
+void mutate(std::vector<uint8_t> &input, xorshift &random, std::size_t max_len) {
+  const uint64_t count = 1 + random(4);
+  for (uint64_t i = 0; i < count; ++i) {
+    const std::size_t pos = random(input.size() + 1);
+    switch (random(4)) {
+    case 0:
+      if (pos < input.size()) {
+        input[pos] = static_cast<uint8_t>(random(256));
+      }
+      break;
+    case 1:
+      if (input.size() < max_len) {
+        input.insert(input.begin() + static_cast<std::ptrdiff_t>(pos), static_cast<uint8_t>(random(256)));
+      }
+      break;
+    case 2:
+      if (pos < input.size()) {
+        input.erase(input.begin() + static_cast<std::ptrdiff_t>(pos));
+      }
+      break;
+    default:
+      if (!input.empty()) {
+        const std::size_t from = random(input.size());
+        const std::size_t length = 1 + random(input.size() - from);
+        const std::vector<uint8_t> run(input.begin() + static_cast<std::ptrdiff_t>(from),
+                                       input.begin() + static_cast<std::ptrdiff_t>(from + length));
+        input.insert(input.begin() + static_cast<std::ptrdiff_t>(pos), run.begin(), run.end());
+        if (input.size() > max_len) {
+          input.resize(max_len);
+        }
+      }
+      break;
+    }
+  }
+}
+
+auto flag(const char *arg, const char *name, uint64_t &value) -> bool {
+  const std::size_t length = std::strlen(name);
+  if (std::strncmp(arg, name, length) != 0) {
+    return false;
+  }
+  value = std::strtoull(arg + length, nullptr, 10); // NOLINT
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (LLVMFuzzerInitialize != nullptr) {
+    LLVMFuzzerInitialize(&argc, &argv);
+  }
+  uint64_t runs = 0;
+  uint64_t max_total_time = 0;
+  uint64_t seed = 0;
+  uint64_t max_len = 256;
+  bool limited = false;
+  std::vector<std::vector<uint8_t>> seeds;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (flag(arg, "-runs=", runs) || flag(arg, "-max_total_time=", max_total_time)) {
+      limited = true;
+    } else if (!flag(arg, "-seed=", seed) && !flag(arg, "-max_len=", max_len) && arg[0] != '-') {
+      collect(arg, seeds);
+    }
+  }
+  if (!limited && seeds.empty()) {
+    runs = 100000;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t executed = 0;
+  std::signal(SIGABRT, save_crash);
+  std::signal(SIGSEGV, save_crash);
+  for (const auto &input : seeds) {
+    execute(input);
+    ++executed;
+  }
+
+  xorshift random{seed};
+  std::vector<uint8_t> input;
+  for (uint64_t run = 0; limited || run < runs; ++run) {
+    if (runs != 0 && run >= runs) {
+      break;
+    }
+    // Checking the clock every run would dominate a fast target
+    if (max_total_time != 0 && (run % 1024) == 0 &&
+        std::chrono::steady_clock::now() - start >= std::chrono::seconds(max_total_time)) {
+      break;
+    }
+    if (seeds.empty()) {
+      input.resize(random(max_len + 1));
+      for (auto &byte : input) {
+        byte = static_cast<uint8_t>(random(256));
+      }
+    } else {
+      input = seeds[random(seeds.size())];
+      mutate(input, random, max_len);
+    }
+    execute(input);
+    ++executed;
+  }
+
+  const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::printf("stat::number_of_executed_units: %llu\n", static_cast<unsigned long long>(executed));
+  std::printf("stat::average_exec_per_sec:     %llu\n",
+              static_cast<unsigned long long>(elapsed > 0 ? static_cast<double>(executed) / elapsed : 0));
+  return 0;
+}
@@ -0,0 +1,304 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_CACHE_HPP
+#define MGUTILITY_CHRONO_CACHE_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Checks if a specifier can be part of a cached prefix: a year,
+ * month, day or weekday field, or an hour or minute field.
+ *
+ * @param specifier The specifier character.
+ * @return bool True if the specifier can be cached.
+ */
+constexpr auto is_prefix_specifier(char specifier) noexcept -> bool {
+  return specifier == 'Y' || specifier == 'y' || specifier == 'm' ||
+         specifier == 'b' || specifier == 'B' || specifier == 'd' ||
+         specifier == 'e' || specifier == 'a' || specifier == 'A' ||
+         specifier == 'F' || specifier == 'H' || specifier == 'M';
+}
+
+/**
+ * @brief Checks if an operation, run after a cached prefix, changes the date
+ * or shifts the time, so that the cached day offset cannot be used. Only
+ * time of day fields and weekday names keep it.
+ *
+ * @param specifier The specifier character, '\0' for a literal.
+ * @return bool True if the operation needs the full conversion.
+ */
+constexpr auto needs_conversion(char specifier) noexcept -> bool {
+  return !(specifier == '\0' || specifier == 'H' || specifier == 'M' ||
+           specifier == 'S' || specifier == 'T' || specifier == 'f' ||
+           specifier == 'I' || specifier == 'a' || specifier == 'A' ||
+           specifier == 'u');
+}
+
+/**
+ * @brief Counts the leading operations of a format that make up a cacheable
+ * prefix: a month and a day, optionally with the year, hour and minute,
+ * ending with a field.
+ *
+ * @param ops The operations.
+ * @param size The number of operations.
+ * @return std::size_t The number of prefix operations, 0 if the format does
+ * not start with a month and a day.
+ */
+inline auto prefix_ops(const format_op *ops, std::size_t size) noexcept
+    -> std::size_t {
+  std::size_t count = 0;
+  bool month = false;
+  bool day = false;
+  for (std::size_t i = 0; i < size; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char specifier = ops[i].specifier;
+    if (specifier == '\0') {
+      continue;
+    }
+    if (!is_prefix_specifier(specifier)) {
+      break;
+    }
+    month = month || specifier == 'm' || specifier == 'b' ||
+            specifier == 'B' || specifier == 'F';
+    day = day || specifier == 'd' || specifier == 'e' || specifier == 'F';
+    count = i + 1;
+  }
+  return month && day ? count : 0;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses timestamps that mostly share their date, e.g. the ticks of a
+ * log or a market data feed, reusing the work done for the last date seen.
+ *
+ * The leading date fields of the format, and the hour and minute when they
+ * directly follow them, form a prefix. The parser keeps the bytes of the last
+ * prefix it parsed together with the parsed fields and their day offset.
+ * When the next input starts with the same bytes, only the remaining fields
+ * (seconds, fraction, offset, ...) are parsed; otherwise the whole input is
+ * parsed and the cache is refilled. Results are identical to parse().
+ *
+ * A format that does not start with a month and a day, e.g. %F, %Y-%m-%d or
+ * %b %e, is parsed in full every time and counts as a miss.
+ *
+ * The cache is plain per-object state with no locking: keep one parser per
+ * thread or input stream.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ */
+template <typename Clock = std::chrono::system_clock> class cached_parser {
+public:
+  /**
+   * @brief Constructs a parser for a format string.
+   *
+   * @param format The format string, e.g. "{:%F %T.%f}". An invalid format
+   * is reported by parse().
+   */
+  explicit cached_parser(string_view format) : ops_(format.size()) {
+    uint32_t size = 0;
+    error_ = detail::compile_format(ops_.data(), size, format);
+    ops_.resize(size);
+    init();
+  }
+
+  /**
+   * @brief Constructs a parser for a compiled format.
+   *
+   * @param format The compiled format.
+   */
+  template <std::size_t N>
+  explicit cached_parser(const compiled_format<N> &format)
+      : ops_(static_cast<const detail::format_op *>(format.ops),
+             // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+             static_cast<const detail::format_op *>(format.ops) + format.size),
+        error_(format.error) {
+    init();
+  }
+
+  /**
+   * @brief Parses a date and time string.
+   *
+   * @param time_point The time point to populate.
+   * @param date_str The date and time string to parse.
+   * @return std::errc An error code indicating success or failure.
+   */
+  auto parse(typename Clock::time_point &time_point, string_view date_str)
+      -> std::errc {
+    return parse(time_point, date_str, diagnostics_t{}).error;
+  }
+
+  /**
+   * @brief Parses a date and time string, reporting where and why parsing
+   * stopped on failure.
+   *
+   * @param time_point The time point to populate.
+   * @param date_str The date and time string to parse.
+   * @param diagnostics Selects this overload.
+   * @return parse_result The same diagnostics as parse(time_point, format,
+   * date_str, diagnostics).
+   */
+  auto parse(typename Clock::time_point &time_point, string_view date_str,
+             diagnostics_t /*diagnostics*/) -> parse_result {
+    if (error_ != std::errc{}) {
+      return parse_result{error_, 0, '\0', parse_stage::format};
+    }
+    const detail::format_op *first = ops_.data();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const detail::format_op *const last = first + ops_.size();
+    detail::tm time_struct{};
+    uint32_t next = 0;
+    const bool hit = cached_ &&
+                     (key_at_end_ ? date_str.size() == key_.size()
+                                  : date_str.size() >= key_.size()) &&
+                     std::memcmp(date_str.data(), key_.data(), key_.size()) == 0;
+    if (hit) {
+      ++hits_;
+      time_struct = prefix_;
+      next = prefix_next_;
+    } else {
+      ++misses_;
+      if (prefix_size_ != 0) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto status = detail::run_ops(time_struct, first, first + prefix_size_,
+                                            date_str, next);
+        if (!status.ok()) {
+          return status;
+        }
+        fill(time_struct, date_str, next);
+      }
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    parse_result result = detail::run_ops(time_struct, first + prefix_size_,
+                                          last, date_str, next);
+    if (!result.ok()) {
+      return result;
+    }
+    result = detail::finish_fields(time_struct, date_str, next);
+    if (!result.ok()) {
+      return result;
+    }
+    // A leap second is checked against its date by the full conversion
+    result.error = direct_ && day_valid_ && time_struct.tm_sec != 60
+                       ? from_day(time_point, time_struct)
+                       : detail::to_time_point<Clock>(time_point, time_struct);
+    result.stage = result.ok() ? parse_stage::none : parse_stage::conversion;
+    return result;
+  }
+
+  /**
+   * @brief Returns the number of inputs that reused the cached prefix.
+   */
+  auto hits() const noexcept -> std::size_t { return hits_; }
+
+  /**
+   * @brief Returns the number of inputs that were parsed in full.
+   */
+  auto misses() const noexcept -> std::size_t { return misses_; }
+
+  /**
+   * @brief Forgets the cached prefix and resets the counters.
+   */
+  void clear() noexcept {
+    cached_ = false;
+    hits_ = 0;
+    misses_ = 0;
+  }
+
+private:
+  void init() {
+    if (error_ != std::errc{}) {
+      return;
+    }
+    prefix_size_ = detail::prefix_ops(ops_.data(), ops_.size());
+    direct_ = prefix_size_ != 0;
+    for (std::size_t i = prefix_size_; i < ops_.size(); ++i) {
+      direct_ = direct_ && !detail::needs_conversion(ops_[i].specifier);
+    }
+  }
+
+  // Remembers a prefix that parsed: its bytes and the character after its
+  // last field, so that a variable-width field such as %e cannot match the
+  // start of a longer value. A prefix that ends the input only matches an
+  // input of the same length.
+  void fill(const detail::tm &time_struct, string_view date_str,
+            uint32_t next) {
+    key_at_end_ = next > date_str.size();
+    key_.assign(date_str.data(), key_at_end_ ? date_str.size() : next);
+    prefix_ = time_struct;
+    prefix_next_ = next;
+    cached_ = true;
+    detail::tm midnight = time_struct;
+    midnight.tm_hour = 0;
+    midnight.tm_min = 0;
+    midnight.tm_sec = 0;
+    day_valid_ = detail::epoch_seconds(day_seconds_, midnight) == std::errc{};
+  }
+
+  auto from_day(typename Clock::time_point &time_point,
+                const detail::tm &time_struct) const -> std::errc {
+    const int64_t seconds = day_seconds_ + (time_struct.tm_hour * 3600) +
+                            (time_struct.tm_min * 60) + time_struct.tm_sec;
+    int64_t count = 0;
+    const auto error = detail::epoch_count<typename Clock::period>(
+        seconds, time_struct.tm_ms, count);
+    if (error != std::errc{}) {
+      return error;
+    }
+    return detail::from_epoch_count<Clock>(time_point, count);
+  }
+
+  std::vector<detail::format_op> ops_;
+  std::errc error_{};
+  std::size_t prefix_size_{};
+  bool direct_{};
+  bool cached_{};
+  bool day_valid_{};
+  bool key_at_end_{};
+  std::string key_;
+  detail::tm prefix_;
+  uint32_t prefix_next_{};
+  int64_t day_seconds_{};
+  std::size_t hits_{};
+  std::size_t misses_{};
+};
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_CACHE_HPP
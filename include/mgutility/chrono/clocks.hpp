@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_CLOCKS_HPP
+#define MGUTILITY_CHRONO_CLOCKS_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <chrono>
+#include <cstdint>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief International Atomic Time, counted from 1958-01-01 00:00:00 TAI as
+ * C++20's std::chrono::tai_clock. Parsing into it applies the leap seconds
+ * between UTC and TAI, e.g. parse<tai_clock>("{:%FT%T%z}", str).
+ */
+struct tai_clock {
+  using duration = std::chrono::system_clock::duration;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<tai_clock>;
+  static constexpr bool is_steady = false;
+
+  /**
+   * @brief Returns the current time, from std::chrono::system_clock.
+   */
+  static auto now() noexcept -> time_point;
+};
+
+/**
+ * @brief GPS time, counted from 1980-01-06 00:00:00 UTC as C++20's
+ * std::chrono::gps_clock. It runs 19 seconds behind TAI.
+ */
+struct gps_clock {
+  using duration = std::chrono::system_clock::duration;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<gps_clock>;
+  static constexpr bool is_steady = false;
+
+  /**
+   * @brief Returns the current time, from std::chrono::system_clock.
+   */
+  static auto now() noexcept -> time_point;
+};
+
+namespace detail {
+/**
+ * @brief Returns a duration since 1970-01-01 UTC shifted by TAI - UTC on its
+ * day and by a fixed number of seconds.
+ *
+ * @param since_epoch The duration since 1970-01-01 UTC.
+ * @param shift The fixed shift in seconds.
+ * @return Duration The shifted duration.
+ */
+template <typename Duration>
+MGUTILITY_CNSTXPR auto shift_by_leap_seconds(Duration since_epoch,
+                                             int64_t shift) noexcept
+    -> Duration {
+  const auto day = std::chrono::duration_cast<Duration>(std::chrono::hours{24});
+  const int64_t days =
+      floor_div(static_cast<int64_t>(since_epoch.count()),
+                static_cast<int64_t>(day.count()));
+  return since_epoch +
+         std::chrono::duration_cast<Duration>(std::chrono::seconds{
+             shift + tai_minus_utc(static_cast<int32_t>(days))});
+}
+} // namespace detail
+
+/**
+ * @brief Maps 1970-01-01 UTC based durations to tai_clock, whose epoch
+ * 1958-01-01 TAI is 378691200 seconds before 1970-01-01 UTC, less 10.
+ */
+template <> struct clock_traits<tai_clock> {
+  static MGUTILITY_CNSTXPR auto from_unix(tai_clock::duration since_epoch) noexcept
+      -> tai_clock::time_point {
+    return tai_clock::time_point{
+        detail::shift_by_leap_seconds(since_epoch, 378691200)};
+  }
+};
+
+/**
+ * @brief Maps 1970-01-01 UTC based durations to gps_clock, which is TAI less
+ * 19 seconds counted from 1980-01-06.
+ */
+template <> struct clock_traits<gps_clock> {
+  static MGUTILITY_CNSTXPR auto from_unix(gps_clock::duration since_epoch) noexcept
+      -> gps_clock::time_point {
+    return gps_clock::time_point{
+        detail::shift_by_leap_seconds(since_epoch, -315964800 - 19)};
+  }
+};
+
+inline auto tai_clock::now() noexcept -> time_point {
+  return clock_traits<tai_clock>::from_unix(
+      std::chrono::system_clock::now().time_since_epoch());
+}
+
+inline auto gps_clock::now() noexcept -> time_point {
+  return clock_traits<gps_clock>::from_unix(
+      std::chrono::system_clock::now().time_since_epoch());
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_CLOCKS_HPP
@@ -0,0 +1,364 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_COLUMNS_HPP
+#define MGUTILITY_CHRONO_COLUMNS_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief A bump allocator for column buffers.
+ *
+ * Memory is taken from blocks of at least block_size bytes and is only
+ * released by reset() or the destructor, so a batch of columns costs a few
+ * allocations however many rows it holds. Every buffer starts on a 64 byte
+ * boundary and its size is rounded up to 64 bytes, as the Arrow columnar
+ * format recommends. Movable, not copyable.
+ */
+class column_arena {
+public:
+  static constexpr std::size_t alignment = 64; ///< Buffer alignment in bytes.
+
+  /**
+   * @brief Constructs an empty arena.
+   *
+   * @param block_size The minimum size of the blocks it allocates.
+   */
+  explicit column_arena(std::size_t block_size = 64 * 1024)
+      : block_size_(block_size) {}
+
+  column_arena(const column_arena &) = delete;
+  auto operator=(const column_arena &) -> column_arena & = delete;
+  column_arena(column_arena &&) noexcept = default;
+  auto operator=(column_arena &&) noexcept -> column_arena & = default;
+  ~column_arena() = default;
+
+  /**
+   * @brief Allocates a zero-filled buffer.
+   *
+   * @param size The size in bytes.
+   * @return unsigned char* The buffer, valid until reset() or destruction.
+   */
+  auto allocate(std::size_t size) -> unsigned char * {
+    size = ((size + alignment - 1) / alignment) * alignment;
+    while (current_ < blocks_.size() && remaining(blocks_[current_]) < size) {
+      ++current_;
+    }
+    if (current_ == blocks_.size()) {
+      const std::size_t capacity = size > block_size_ ? size : block_size_;
+      blocks_.push_back(block{
+          std::unique_ptr<unsigned char[]>(new unsigned char[capacity + alignment]),
+          capacity, 0});
+    }
+    block &target = blocks_[current_];
+    unsigned char *buffer = aligned(target) + target.used;
+    target.used += size;
+    allocated_ += size;
+    std::memset(buffer, 0, size);
+    return buffer;
+  }
+
+  /**
+   * @brief Makes all memory available again, invalidating every buffer. The
+   * blocks are kept for reuse.
+   */
+  void reset() noexcept {
+    for (auto &target : blocks_) {
+      target.used = 0;
+    }
+    current_ = 0;
+    allocated_ = 0;
+  }
+
+  /**
+   * @brief Returns the number of bytes handed out since the last reset().
+   */
+  auto allocated() const noexcept -> std::size_t { return allocated_; }
+
+private:
+  struct block {
+    std::unique_ptr<unsigned char[]> data; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::size_t capacity;
+    std::size_t used;
+  };
+
+  static auto aligned(const block &target) noexcept -> unsigned char * {
+    const auto address = reinterpret_cast<std::uintptr_t>(target.data.get()); // NOLINT
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return target.data.get() + ((alignment - (address % alignment)) % alignment);
+  }
+
+  static auto remaining(const block &target) noexcept -> std::size_t {
+    return target.capacity - target.used;
+  }
+
+  std::vector<block> blocks_;
+  std::size_t block_size_;
+  std::size_t current_{};
+  std::size_t allocated_{};
+};
+
+/**
+ * @brief Broken-down fields that time_columns can store next to the epoch
+ * value. Combine with |.
+ */
+constexpr uint8_t column_year = 1;   ///< int16_t year.
+constexpr uint8_t column_month = 2;  ///< uint8_t month [1, 12].
+constexpr uint8_t column_day = 4;    ///< uint8_t day of the month [1, 31].
+constexpr uint8_t column_hour = 8;   ///< uint8_t hour [0, 23].
+constexpr uint8_t column_offset = 16; ///< int32_t %z offset in seconds.
+
+/**
+ * @brief Structure-of-arrays output of a batch parse: one epoch column and
+ * optional year, month, day, hour and offset columns, all sharing one
+ * validity bitmap.
+ *
+ * The buffers follow the Arrow columnar layout and can be handed to an
+ * Arrow array without copying: the epoch column is an Arrow timestamp with
+ * the unit of Period, the validity bitmap has bit i (least significant bit
+ * first) set when row i parsed, and every buffer is 64 byte aligned and
+ * padded. The fields are those of the epoch value, in UTC; the offset
+ * column holds the offset that was parsed, 0 for inputs without one, so the
+ * local fields can be recovered. Values of null rows are 0.
+ *
+ * @tparam Period The period of the epoch column (defaults to seconds).
+ */
+template <typename Period = std::ratio<1>> class time_columns {
+public:
+  /**
+   * @brief Allocates the columns.
+   *
+   * @param arena The arena holding the buffers, which must outlive the
+   * columns.
+   * @param capacity The maximum number of rows.
+   * @param fields The broken-down fields to store, column_* flags.
+   */
+  time_columns(column_arena &arena, std::size_t capacity, uint8_t fields = 0)
+      : capacity_(capacity),
+        validity_(arena.allocate((capacity + 7) / 8)),
+        epoch_(allocate<int64_t>(arena, capacity, true)),
+        year_(allocate<int16_t>(arena, capacity, (fields & column_year) != 0)),
+        month_(allocate<uint8_t>(arena, capacity, (fields & column_month) != 0)),
+        day_(allocate<uint8_t>(arena, capacity, (fields & column_day) != 0)),
+        hour_(allocate<uint8_t>(arena, capacity, (fields & column_hour) != 0)),
+        offset_(allocate<int32_t>(arena, capacity, (fields & column_offset) != 0)) {}
+
+  /**
+   * @brief Appends a parsed row.
+   *
+   * @param time_struct The parsed fields.
+   * @return std::errc An error code indicating whether the row converts to
+   * an epoch value; a row that does not is appended as null. When the
+   * columns are full, nothing is appended and the error is no_buffer_space.
+   */
+  auto append(const detail::tm &time_struct) noexcept -> std::errc {
+    if (size_ >= capacity_) {
+      return std::errc::no_buffer_space;
+    }
+    int64_t count = 0;
+    const auto error = detail::to_epoch_count<Period>(count, time_struct);
+    if (error != std::errc{}) {
+      append_null();
+      return error;
+    }
+    // The fields come from the epoch value, not from the parsed fields,
+    // which are local to the offset and may hold a leap second or day 0
+    int64_t seconds = 0;
+    detail::epoch_seconds(seconds, time_struct);
+    seconds -= time_struct.tm_offset;
+    const int64_t days = detail::floor_div(seconds, 86400);
+    int32_t year = 0;
+    uint32_t month = 0;
+    uint32_t day = 0;
+    detail::civil_from_days(static_cast<int32_t>(days), year, month, day);
+    const auto hour = static_cast<int32_t>((seconds - (days * 86400)) / 3600);
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    validity_[size_ / 8] |= static_cast<uint8_t>(1U << (size_ % 8));
+    epoch_[size_] = count;
+    if (year_ != nullptr) {
+      year_[size_] = static_cast<int16_t>(year);
+    }
+    if (month_ != nullptr) {
+      month_[size_] = static_cast<uint8_t>(month);
+    }
+    if (day_ != nullptr) {
+      day_[size_] = static_cast<uint8_t>(day);
+    }
+    if (hour_ != nullptr) {
+      hour_[size_] = static_cast<uint8_t>(hour);
+    }
+    if (offset_ != nullptr) {
+      offset_[size_] = time_struct.tm_offset;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ++size_;
+    return std::errc{};
+  }
+
+  /**
+   * @brief Appends a null row, whose values stay 0.
+   *
+   * @return std::errc no_buffer_space if the columns are full.
+   */
+  auto append_null() noexcept -> std::errc {
+    if (size_ >= capacity_) {
+      return std::errc::no_buffer_space;
+    }
+    ++size_;
+    ++null_count_;
+    return std::errc{};
+  }
+
+  /**
+   * @brief Returns the number of rows.
+   */
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  /**
+   * @brief Returns the maximum number of rows.
+   */
+  auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  /**
+   * @brief Returns the number of null rows.
+   */
+  auto null_count() const noexcept -> std::size_t { return null_count_; }
+
+  /**
+   * @brief Returns whether row i parsed.
+   */
+  auto valid(std::size_t i) const noexcept -> bool {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return ((validity_[i / 8] >> (i % 8)) & 1U) != 0;
+  }
+
+  /**
+   * @brief Returns the validity bitmap, (capacity() + 7) / 8 bytes.
+   */
+  auto validity() const noexcept -> const uint8_t * { return validity_; }
+
+  /**
+   * @brief Returns the epoch column, counts of Period since 1970-01-01 UTC.
+   */
+  auto epoch() const noexcept -> const int64_t * { return epoch_; }
+
+  /**
+   * @brief Returns the year column, or nullptr if it was not requested.
+   */
+  auto year() const noexcept -> const int16_t * { return year_; }
+
+  /**
+   * @brief Returns the month column, or nullptr if it was not requested.
+   */
+  auto month() const noexcept -> const uint8_t * { return month_; }
+
+  /**
+   * @brief Returns the day column, or nullptr if it was not requested.
+   */
+  auto day() const noexcept -> const uint8_t * { return day_; }
+
+  /**
+   * @brief Returns the hour column, or nullptr if it was not requested.
+   */
+  auto hour() const noexcept -> const uint8_t * { return hour_; }
+
+  /**
+   * @brief Returns the offset column, or nullptr if it was not requested.
+   */
+  auto offset() const noexcept -> const int32_t * { return offset_; }
+
+private:
+  template <typename T>
+  static auto allocate(column_arena &arena, std::size_t capacity, bool wanted)
+      -> T * {
+    // The arena aligns every buffer to 64 bytes
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    return wanted ? reinterpret_cast<T *>(arena.allocate(capacity * sizeof(T)))
+                  : nullptr;
+  }
+
+  std::size_t capacity_;
+  std::size_t size_{};
+  std::size_t null_count_{};
+  uint8_t *validity_;
+  int64_t *epoch_;
+  int16_t *year_;
+  uint8_t *month_;
+  uint8_t *day_;
+  uint8_t *hour_;
+  int32_t *offset_;
+};
+
+/**
+ * @brief Parses a column of date and time strings into time_columns.
+ *
+ * Rows are appended until the input or the capacity of the columns runs
+ * out. A row that fails to parse is appended as null.
+ *
+ * @param format The format, a format string or a compiled_format.
+ * @param input The strings to parse.
+ * @param count The number of strings.
+ * @param columns The columns to append to.
+ * @param errors The per-row error codes, count elements, or nullptr.
+ * @return std::size_t The number of rows appended.
+ */
+template <typename Period, typename Format>
+auto parse_columns(const Format &format, const string_view *input,
+                   std::size_t count, time_columns<Period> &columns,
+                   std::errc *errors = nullptr) -> std::size_t {
+  const std::size_t room = columns.capacity() - columns.size();
+  count = count < room ? count : room;
+  for (std::size_t i = 0; i < count; ++i) {
+    detail::tm time_struct{};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto error = detail::get_time(time_struct, format, input[i]);
+    if (error != std::errc{}) {
+      columns.append_null();
+    } else {
+      error = columns.append(time_struct);
+    }
+    if (errors != nullptr) {
+      errors[i] = error; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+  }
+  return count;
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_COLUMNS_HPP
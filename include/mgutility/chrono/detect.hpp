@@ -0,0 +1,374 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_DETECT_HPP
+#define MGUTILITY_CHRONO_DETECT_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Matches a run of exactly count digits.
+ *
+ * @param str The input.
+ * @param pos The position of the run, advanced past it on success.
+ * @param count The number of digits.
+ * @return bool True if the run matches.
+ */
+inline auto match_digits(string_view str, std::size_t &pos, std::size_t count)
+    -> bool {
+  for (std::size_t end = pos + count; pos < end; ++pos) {
+    if (pos >= str.size() || !mgutility::detail::is_digit(str[pos])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Matches a run of min_count to max_count digits.
+ *
+ * @param str The input.
+ * @param pos The position of the run, advanced past it on success.
+ * @param min_count The minimum number of digits.
+ * @param max_count The maximum number of digits.
+ * @return bool True if the run matches.
+ */
+inline auto match_digit_run(string_view str, std::size_t &pos,
+                            std::size_t min_count, std::size_t max_count)
+    -> bool {
+  const std::size_t start = pos;
+  while (pos < str.size() && pos - start < max_count &&
+         mgutility::detail::is_digit(str[pos])) {
+    ++pos;
+  }
+  return pos - start >= min_count;
+}
+
+/**
+ * @brief Matches a run of at least min_count letters, e.g. a month name.
+ *
+ * @param str The input.
+ * @param pos The position of the run, advanced past it on success.
+ * @param min_count The minimum number of letters.
+ * @param max_count The maximum number of letters.
+ * @return bool True if the run matches.
+ */
+inline auto match_letters(string_view str, std::size_t &pos,
+                          std::size_t min_count, std::size_t max_count)
+    -> bool {
+  const std::size_t start = pos;
+  while (pos < str.size() && pos - start < max_count &&
+         ((str[pos] >= 'A' && str[pos] <= 'Z') ||
+          (str[pos] >= 'a' && str[pos] <= 'z'))) {
+    ++pos;
+  }
+  return pos - start >= min_count;
+}
+
+/**
+ * @brief Matches one character.
+ *
+ * @param str The input.
+ * @param pos The position of the character, advanced past it on success.
+ * @param chr The expected character.
+ * @return bool True if the character matches.
+ */
+inline auto match_char(string_view str, std::size_t &pos, char chr) -> bool {
+  if (pos >= str.size() || str[pos] != chr) {
+    return false;
+  }
+  ++pos;
+  return true;
+}
+
+/**
+ * @brief Matches the shape of the field named by a specifier: its digit
+ * runs, the separators inside composite fields, and its length.
+ *
+ * @param specifier The specifier character following '%'.
+ * @param str The input.
+ * @param pos The position of the field, advanced past it on success.
+ * @return bool True if the field has the shape of the specifier.
+ */
+inline auto match_field_shape(char specifier, string_view str,
+                              std::size_t &pos) -> bool {
+  switch (specifier) {
+  case 'Y':
+  case 'G':
+    return match_digits(str, pos, 4);
+  case 'm':
+  case 'd':
+  case 'H':
+  case 'M':
+  case 'S':
+  case 'y':
+  case 'I':
+  case 'V':
+    return match_digits(str, pos, 2);
+  case 'j':
+    return match_digits(str, pos, 3);
+  case 'u':
+    return match_digits(str, pos, 1);
+  case 'e':
+    match_char(str, pos, ' ');
+    return match_digit_run(str, pos, 1, 2);
+  case 's':
+    match_char(str, pos, '-');
+    return match_digit_run(str, pos, 1, 19);
+  case 'b':
+  case 'a':
+    return match_letters(str, pos, 3, 3);
+  case 'B':
+  case 'A':
+    return match_letters(str, pos, 3, 9);
+  case 'F':
+    return match_digits(str, pos, 4) && match_char(str, pos, '-') &&
+           match_digits(str, pos, 2) && match_char(str, pos, '-') &&
+           match_digits(str, pos, 2);
+  case 'T':
+    return match_digits(str, pos, 2) && match_char(str, pos, ':') &&
+           match_digits(str, pos, 2) && match_char(str, pos, ':') &&
+           match_digits(str, pos, 2);
+  case 'f':
+    return match_digit_run(str, pos, 1, 9);
+  case 'z':
+    if (match_char(str, pos, 'Z')) {
+      return true;
+    }
+    if (!match_char(str, pos, '+') && !match_char(str, pos, '-')) {
+      return false;
+    }
+    if (!match_digits(str, pos, 2)) {
+      return false;
+    }
+    // +hh, +hhmm[ss] or +hh:mm[:ss]
+    if (match_char(str, pos, ':')) {
+      return match_digits(str, pos, 2) &&
+             (!match_char(str, pos, ':') || match_digits(str, pos, 2));
+    }
+    {
+      const std::size_t start = pos;
+      match_digit_run(str, pos, 0, 4);
+      return (pos - start) % 2 == 0;
+    }
+  case 'Z': {
+    const std::size_t start = pos;
+    while (pos < str.size() &&
+           ((str[pos] >= 'A' && str[pos] <= 'Z') ||
+            (str[pos] >= 'a' && str[pos] <= 'z') ||
+            mgutility::detail::is_digit(str[pos]) || str[pos] == '/' ||
+            str[pos] == '_' || str[pos] == '+' || str[pos] == '-')) {
+      ++pos;
+    }
+    return pos != start;
+  }
+  case 'p':
+    return (match_char(str, pos, 'A') || match_char(str, pos, 'P')) &&
+           match_char(str, pos, 'M');
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Checks whether a whole input has the shape of a format: the same
+ * digit runs, the same separators and literals at the same positions, and
+ * the same length.
+ *
+ * This is much cheaper than parsing and rules out most formats without
+ * converting any field.
+ *
+ * @param format The format string.
+ * @param date_str The input.
+ * @return bool True if the input has the shape of the format.
+ */
+inline auto match_shape(string_view format, string_view date_str) -> bool {
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos || begin >= end) {
+    return false;
+  }
+  std::size_t pos = 0;
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] == '%') {
+      if (i + 1 >= end || !match_field_shape(format[i + 1], date_str, pos)) {
+        return false;
+      }
+      ++i;
+    } else if (!match_char(date_str, pos, format[i])) {
+      return false;
+    }
+  }
+  return pos == date_str.size();
+}
+
+} // namespace detail
+
+/**
+ * @brief Detects which of a set of registered formats an input is written in
+ * and parses it, remembering the last format that worked.
+ *
+ * Inputs from one source nearly always share a format, so the last winning
+ * format is tried first and, after the first record, a parse costs a single
+ * attempt. When it fails, the other formats are classified by shape (see
+ * detail::match_shape()) and only those with a matching shape are parsed,
+ * in registration order. Nothing throws on a mismatch.
+ *
+ * Keep one detector per input stream; a detector is not safe to share
+ * between threads.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ */
+template <typename Clock = std::chrono::system_clock> class format_detector {
+public:
+  format_detector() = default;
+
+  /**
+   * @brief Constructs a detector with a set of formats.
+   *
+   * @param formats The formats, in order of preference.
+   */
+  format_detector(std::initializer_list<string_view> formats) {
+    for (const auto format : formats) {
+      add(format);
+    }
+  }
+
+  /**
+   * @brief Registers a format. Formats registered earlier take precedence
+   * when several match an input.
+   *
+   * @param format The format string.
+   */
+  void add(string_view format) {
+    formats_.emplace_back(format.data(), format.size());
+  }
+
+  /**
+   * @brief Returns the index of the first format whose shape matches an
+   * input, without parsing it.
+   *
+   * @param date_str The input.
+   * @return std::size_t The index of the format, or npos if none matches.
+   */
+  auto detect(string_view date_str) const -> std::size_t {
+    if (last_ != npos && detail::match_shape(format(last_), date_str)) {
+      return last_;
+    }
+    for (std::size_t i = 0; i < formats_.size(); ++i) {
+      if (detail::match_shape(format(i), date_str)) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Parses an input in the last format that worked if its shape
+   * matches or, failing that, in the first registered format with a
+   * matching shape that parses. The shape is checked even for the last
+   * format, since parse() accepts input past the end of the format.
+   *
+   * @param time_point The time point to populate.
+   * @param date_str The input.
+   * @return std::errc An error code indicating success or failure; the error
+   * of the last format tried, or invalid_argument if no shape matched.
+   */
+  auto parse(typename Clock::time_point &time_point, string_view date_str)
+      -> std::errc {
+    std::errc error = std::errc::invalid_argument;
+    if (last_ != npos && detail::match_shape(format(last_), date_str)) {
+      error = parse_as(last_, time_point, date_str);
+      if (error == std::errc{}) {
+        return error;
+      }
+    }
+    for (std::size_t i = 0; i < formats_.size(); ++i) {
+      if (i == last_ || !detail::match_shape(format(i), date_str)) {
+        continue;
+      }
+      error = parse_as(i, time_point, date_str);
+      if (error == std::errc{}) {
+        last_ = i;
+        return error;
+      }
+    }
+    return error;
+  }
+
+  /**
+   * @brief Returns a registered format.
+   *
+   * @param index The index of the format.
+   */
+  auto format(std::size_t index) const -> string_view {
+    return string_view{formats_[index].data(), formats_[index].size()};
+  }
+
+  /**
+   * @brief Returns the number of registered formats.
+   */
+  auto size() const noexcept -> std::size_t { return formats_.size(); }
+
+  /**
+   * @brief Returns the index of the last format that parsed, or npos.
+   */
+  auto last() const noexcept -> std::size_t { return last_; }
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+private:
+  auto parse_as(std::size_t index, typename Clock::time_point &time_point,
+                string_view date_str) const -> std::errc {
+    detail::tm time_struct{};
+    const auto error = detail::get_time(time_struct, format(index), date_str);
+    if (error != std::errc{}) {
+      return error;
+    }
+    return detail::to_time_point<Clock>(time_point, time_struct);
+  }
+
+  std::vector<std::string> formats_;
+  std::size_t last_{npos};
+};
+
+template <typename Clock> constexpr std::size_t format_detector<Clock>::npos;
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_DETECT_HPP
@@ -0,0 +1,512 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_DURATION_HPP
+#define MGUTILITY_CHRONO_DURATION_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/profiles.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief The duration layouts with a dedicated parser.
+ *
+ * - iso8601 is an ISO 8601 duration with an optional sign, e.g. PT1H30M15.25S,
+ *   P2DT12H or -PT0.5S. The components come in the order W, D, then after T
+ *   H, M and S, each at most once; only the last may have a '.' or ','
+ *   fraction. Years and months have no fixed length and fail with
+ *   std::errc::not_supported.
+ * - units is a sequence of numbers with unit suffixes as written by Go's
+ *   time.Duration, e.g. 1h30m15.25s, 250ms or -1.5us, with an optional sign.
+ *   The units are h, m, s, ms, us (or µs, μs) and ns; any of them may have a
+ *   fraction. "0" alone is a zero duration.
+ *
+ * Fraction digits past nanoseconds are ignored, and the whole input must
+ * match.
+ */
+enum class duration_layout : uint8_t {
+  iso8601, ///< PT1H30M15.250S
+  units    ///< 1h30m15.25s
+};
+
+namespace detail {
+
+/**
+ * @brief A duration being summed, as whole seconds and nanoseconds.
+ */
+struct duration_sum {
+  int64_t seconds;      ///< Whole seconds.
+  uint32_t nanoseconds; ///< Nanoseconds, less than a second.
+
+  /**
+   * @brief Adds count units and a fraction of a unit.
+   *
+   * @param count The whole units.
+   * @param fraction The fraction of a unit, in billionths.
+   * @param unit The unit in nanoseconds, a multiple or a divisor of a second.
+   * @return bool False if the sum does not fit in int64_t seconds.
+   */
+  MGUTILITY_CNSTXPR auto add(int64_t count, uint32_t fraction,
+                             int64_t unit) noexcept -> bool {
+    constexpr int64_t second = 1000000000;
+    int64_t whole = 0;
+    int64_t part = 0;
+    if (unit >= second) {
+      const int64_t unit_seconds = unit / second;
+      if (count > (std::numeric_limits<int64_t>::max)() / unit_seconds) {
+        return false;
+      }
+      whole = count * unit_seconds;
+      part = static_cast<int64_t>(fraction) * unit_seconds;
+    } else {
+      const int64_t per_second = second / unit;
+      whole = count / per_second;
+      part = ((count % per_second) * unit) +
+             ((static_cast<int64_t>(fraction) * unit) / second);
+    }
+    // The fraction and the nanoseconds so far may carry a second or more
+    int64_t carry = part / second;
+    part = (part % second) + nanoseconds;
+    carry += part / second;
+    if (whole > (std::numeric_limits<int64_t>::max)() - carry) {
+      return false;
+    }
+    whole += carry;
+    if (whole > (std::numeric_limits<int64_t>::max)() - seconds) {
+      return false;
+    }
+    seconds += whole;
+    nanoseconds = static_cast<uint32_t>(part % second);
+    return true;
+  }
+};
+
+/**
+ * @brief Converts a duration sum to a floating-point duration.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto to_duration(std::chrono::duration<Rep, Period> &duration,
+                                   const duration_sum &sum, bool negative,
+                                   std::true_type) noexcept -> std::errc {
+  const Rep count =
+      ((static_cast<Rep>(sum.seconds) * Period::den) / Period::num) +
+      ((static_cast<Rep>(sum.nanoseconds) * Period::den) /
+       (static_cast<Rep>(Period::num) * 1000000000));
+  duration = std::chrono::duration<Rep, Period>{negative ? -count : count};
+  return std::errc{};
+}
+
+/**
+ * @brief Converts a duration sum to an integral duration, truncating toward
+ * zero.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto to_duration(std::chrono::duration<Rep, Period> &duration,
+                                   const duration_sum &sum, bool negative,
+                                   std::false_type) noexcept -> std::errc {
+  int64_t count = 0;
+  const auto error = epoch_count<Period>(sum.seconds, sum.nanoseconds, count);
+  count = negative ? -count : count;
+  if (error != std::errc{} || !fits_rep<Rep>(count)) {
+    return std::errc::result_out_of_range;
+  }
+  duration = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+  return std::errc{};
+}
+
+/**
+ * @brief Converts a duration sum to a duration.
+ *
+ * @param duration The duration.
+ * @param sum The magnitude of the duration.
+ * @param negative True for a negative duration.
+ * @return std::errc result_out_of_range if the duration does not fit.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto to_duration(std::chrono::duration<Rep, Period> &duration,
+                                   const duration_sum &sum,
+                                   bool negative) noexcept -> std::errc {
+  return to_duration(duration, sum, negative,
+                     std::is_floating_point<Rep>{});
+}
+
+/**
+ * @brief Reads an optional fraction after a duration component's number:
+ * '.' (or ',' if comma is true) followed by digits.
+ *
+ * @return bool False, with a field failure, if the separator is not
+ * followed by digits.
+ */
+MGUTILITY_CNSTXPR auto read_component_fraction(profile_reader &reader,
+                                               uint32_t &fraction,
+                                               bool comma) noexcept -> bool {
+  fraction = 0;
+  if (!reader.skip('.') && !(comma && reader.skip(','))) {
+    return true;
+  }
+  return reader.fraction(fraction);
+}
+
+/**
+ * @brief Reads an ISO 8601 duration after its sign.
+ *
+ * @param reader The reader.
+ * @param sum The duration read.
+ */
+MGUTILITY_CNSTXPR auto read_iso8601_duration(profile_reader &reader,
+                                             duration_sum &sum) noexcept
+    -> bool {
+  constexpr int64_t second = 1000000000;
+  if (!reader.expect('P')) {
+    return false;
+  }
+  // The designators in order: W, D, T, H, M, S; Y and M(onth) are refused
+  bool time = false;
+  int32_t last = -1;
+  bool fraction_seen = false;
+  while (!reader.at_end()) {
+    if (fraction_seen) {
+      // Only the last component may have a fraction
+      return reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                         parse_stage::separator);
+    }
+    if (!time && reader.skip('T')) {
+      time = true;
+      last = 2;
+      if (reader.at_end()) {
+        return reader.fail(std::errc::invalid_argument, reader.position(),
+                           'H', parse_stage::field);
+      }
+      continue;
+    }
+    const uint32_t start = reader.position();
+    int64_t count = 0;
+    uint32_t fraction = 0;
+    if (!reader.integer(count, '\0')) {
+      return false;
+    }
+    const uint32_t integer_end = reader.position();
+    if (!read_component_fraction(reader, fraction, true)) {
+      return false;
+    }
+    fraction_seen = reader.position() != integer_end;
+    const char designator = reader.peek();
+    const int32_t index = time ? (designator == 'H'   ? 3
+                                  : designator == 'M' ? 4
+                                  : designator == 'S' ? 5
+                                                      : -1)
+                               : (designator == 'W'   ? 0
+                                  : designator == 'D' ? 1
+                                                      : -1);
+    if (!time && (designator == 'Y' || designator == 'M')) {
+      return reader.fail(std::errc::not_supported, start,
+                         designator == 'Y' ? 'Y' : 'm', parse_stage::field);
+    }
+    if (index <= last) {
+      return reader.fail(std::errc::invalid_argument, reader.position(),
+                         '\0', parse_stage::separator);
+    }
+    reader.skip(designator);
+    last = index;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+    constexpr int64_t units[] = {604800 * second, 86400 * second, 0,
+                                 3600 * second,   60 * second,    second};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    if (!sum.add(count, fraction, units[index])) {
+      return reader.fail(std::errc::result_out_of_range, start, designator,
+                         parse_stage::conversion);
+    }
+  }
+  if (last < 0 || last == 2) {
+    return reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                       parse_stage::field);
+  }
+  return true;
+}
+
+/**
+ * @brief Reads the unit suffix of a duration component.
+ *
+ * @param reader The reader, advanced past the unit.
+ * @param unit The unit in nanoseconds, 0 if there is none.
+ */
+MGUTILITY_CNSTXPR void read_unit(profile_reader &reader, int64_t &unit) noexcept {
+  constexpr int64_t second = 1000000000;
+  unit = 0;
+  if (reader.skip('h')) {
+    unit = 3600 * second;
+  } else if (reader.skip('m')) {
+    unit = reader.skip('s') ? 1000000 : 60 * second;
+  } else if (reader.skip('s')) {
+    unit = second;
+  } else if (reader.skip('u')) {
+    unit = reader.skip('s') ? 1000 : -1;
+  } else if (reader.skip('n')) {
+    unit = reader.skip('s') ? 1 : -1;
+  } else if (reader.skip('\xC2')) {
+    // U+00B5 micro sign
+    unit = reader.skip('\xB5') && reader.skip('s') ? 1000 : -1;
+  } else if (reader.skip('\xCE')) {
+    // U+03BC Greek small letter mu
+    unit = reader.skip('\xBC') && reader.skip('s') ? 1000 : -1;
+  }
+  unit = unit < 0 ? 0 : unit;
+}
+
+/**
+ * @brief Reads a duration with unit suffixes after its sign.
+ *
+ * @param reader The reader.
+ * @param sum The duration read.
+ * @param str The whole input.
+ */
+MGUTILITY_CNSTXPR auto read_unit_duration(profile_reader &reader,
+                                          duration_sum &sum,
+                                          string_view str) noexcept -> bool {
+  // A zero needs no unit
+  if (reader.position() + 1 == str.size() && str[reader.position()] == '0') {
+    return reader.skip('0');
+  }
+  do {
+    const uint32_t start = reader.position();
+    int64_t count = 0;
+    uint32_t fraction = 0;
+    // A number may start at its fraction, e.g. .5s
+    if (reader.peek() != '.' && !reader.integer(count, '\0')) {
+      return false;
+    }
+    if (!read_component_fraction(reader, fraction, false)) {
+      return false;
+    }
+    const uint32_t unit_start = reader.position();
+    int64_t unit = 0;
+    read_unit(reader, unit);
+    if (unit == 0) {
+      return reader.fail(std::errc::invalid_argument, unit_start, '\0',
+                         parse_stage::field);
+    }
+    if (!sum.add(count, fraction, unit)) {
+      return reader.fail(std::errc::result_out_of_range, start, '\0',
+                         parse_stage::conversion);
+    }
+  } while (!reader.at_end());
+  return true;
+}
+
+/**
+ * @brief Checks that a duration format has only the specifiers %H, %M, %S,
+ * %T and %f.
+ *
+ * @param format The format string.
+ * @return bool True if the format can describe a duration.
+ */
+MGUTILITY_CNSTXPR auto is_duration_format(string_view format) noexcept
+    -> bool {
+  for (std::size_t i = 0; i < format.size(); ++i) {
+    if (format[i] == '%') {
+      const char specifier = i + 1 < format.size() ? format[++i] : '\0';
+      if (specifier != 'H' && specifier != 'M' && specifier != 'S' &&
+          specifier != 'T' && specifier != 'f') {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses a duration laid out as an ISO 8601 duration or with unit
+ * suffixes, reporting where and why parsing stopped. Usable in constant
+ * expressions from C++14.
+ *
+ * @param duration The duration to populate, of any std::chrono::duration
+ * whose period is a multiple or a fraction of a second. Integral counts
+ * truncate toward zero.
+ * @param layout The layout, e.g. duration_layout::iso8601.
+ * @param str The duration string to parse, e.g. "PT1H30M".
+ * @return parse_result The diagnostics; result_out_of_range at the
+ * conversion stage if the duration does not fit.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto parse_duration(std::chrono::duration<Rep, Period> &duration,
+                                      duration_layout layout, string_view str,
+                                      diagnostics_t) noexcept -> parse_result {
+  detail::profile_reader reader{str, true};
+  const bool negative = reader.skip('-');
+  if (!negative) {
+    reader.skip('+');
+  }
+  detail::duration_sum sum{0, 0};
+  const bool read = layout == duration_layout::iso8601
+                        ? detail::read_iso8601_duration(reader, sum)
+                        : detail::read_unit_duration(reader, sum, str);
+  if (!read) {
+    return reader.result();
+  }
+  if (!reader.at_end()) {
+    return parse_result{std::errc::invalid_argument, reader.position(), '\0',
+                        parse_stage::separator};
+  }
+  const auto error = detail::to_duration(duration, sum, negative);
+  return parse_result{error, reader.position(), '\0',
+                      error == std::errc{} ? parse_stage::none
+                                           : parse_stage::conversion};
+}
+
+/**
+ * @brief Parses a duration laid out as an ISO 8601 duration or with unit
+ * suffixes.
+ *
+ * @param duration The duration to populate.
+ * @param layout The layout, e.g. duration_layout::units.
+ * @param str The duration string to parse, e.g. "1h30m15.25s".
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Rep, typename Period>
+auto parse_duration(std::chrono::duration<Rep, Period> &duration,
+                    duration_layout layout, string_view str)
+    -> std::error_code {
+  return detail::to_error_code(
+      parse_duration(duration, layout, str, diagnostics_t{}).error);
+}
+
+/**
+ * @brief Parses a clock-style duration under a day according to a format
+ * string, reporting where and why parsing stopped. Usable in constant
+ * expressions from C++14.
+ *
+ * The format may use %H, %M, %S, %T and %f, e.g. "{:%H:%M:%S.%f}" for
+ * "00:01:30.5"; fields follow the rules of parse(), so trailing input is
+ * accepted and a second of 60 is out of range.
+ *
+ * @param duration The duration to populate.
+ * @param format The format string.
+ * @param str The duration string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto parse_duration(std::chrono::duration<Rep, Period> &duration,
+                                      string_view format, string_view str,
+                                      diagnostics_t) -> parse_result {
+  if (!detail::is_duration_format(format)) {
+    return parse_result{std::errc::invalid_argument, 0, '\0',
+                        parse_stage::format};
+  }
+  detail::tm time_struct{};
+  parse_result result =
+      detail::get_time(time_struct, format, str, diagnostics_t{});
+  if (!result.ok()) {
+    return result;
+  }
+  if (time_struct.tm_sec == 60) {
+    return parse_result{std::errc::result_out_of_range, result.position, 'S',
+                        parse_stage::conversion};
+  }
+  const detail::duration_sum sum{
+      (static_cast<int64_t>(time_struct.tm_hour) * 3600) +
+          (static_cast<int64_t>(time_struct.tm_min) * 60) + time_struct.tm_sec,
+      time_struct.tm_ms};
+  result.error = detail::to_duration(duration, sum, false);
+  if (!result.ok()) {
+    result.stage = parse_stage::conversion;
+  }
+  return result;
+}
+
+/**
+ * @brief Parses a clock-style duration under a day according to a format
+ * string.
+ *
+ * @param duration The duration to populate.
+ * @param format The format string, e.g. "{:%T.%f}".
+ * @param str The duration string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Rep, typename Period>
+auto parse_duration(std::chrono::duration<Rep, Period> &duration,
+                    string_view format, string_view str) -> std::error_code {
+  return detail::to_error_code(
+      parse_duration(duration, format, str, diagnostics_t{}).error);
+}
+
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
+/**
+ * @brief Parses a duration laid out as an ISO 8601 duration or with unit
+ * suffixes.
+ *
+ * @tparam Duration The duration type (defaults to std::chrono::nanoseconds).
+ * @param layout The layout.
+ * @param str The duration string to parse.
+ * @throw std::system_error if parsing fails
+ * @return Duration The parsed duration.
+ */
+template <typename Duration = std::chrono::nanoseconds>
+auto parse_duration(duration_layout layout, string_view str) -> Duration {
+  Duration duration{};
+  auto error = parse_duration(duration, layout, str);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return duration;
+}
+
+/**
+ * @brief Parses a clock-style duration under a day according to a format
+ * string.
+ *
+ * @tparam Duration The duration type (defaults to std::chrono::nanoseconds).
+ * @param format The format string.
+ * @param str The duration string to parse.
+ * @throw std::system_error if parsing fails
+ * @return Duration The parsed duration.
+ */
+template <typename Duration = std::chrono::nanoseconds>
+auto parse_duration(string_view format, string_view str) -> Duration {
+  Duration duration{};
+  auto error = parse_duration(duration, format, str);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return duration;
+}
+#endif // CHRONO_PARSE_NO_EXCEPTIONS
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_DURATION_HPP
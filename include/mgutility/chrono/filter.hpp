@@ -0,0 +1,373 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_FILTER_HPP
+#define MGUTILITY_CHRONO_FILTER_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/format.hpp"
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/plan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Returns the most significant unit a field holds, from 0 for the
+ * year to 5 for the second and 6 for the fraction, or -1 if the field does
+ * not hold a calendar or clock unit in order, e.g. %j or %b.
+ *
+ * @param specifier The specifier character.
+ * @return int32_t The unit.
+ */
+constexpr auto first_unit(char specifier) noexcept -> int32_t {
+  return specifier == 'Y' || specifier == 'F' ? 0
+         : specifier == 'm'                   ? 1
+         : specifier == 'd'                   ? 2
+         : specifier == 'H' || specifier == 'T' || specifier == 'I' ||
+                 specifier == 'p'
+             ? 3
+         : specifier == 'M' ? 4
+         : specifier == 'S' ? 5
+         : specifier == 'f' ? 6
+                            : -1;
+}
+
+/**
+ * @brief Returns the least significant unit a field holds, see first_unit().
+ *
+ * @param specifier The specifier character.
+ * @return int32_t The unit.
+ */
+constexpr auto last_unit(char specifier) noexcept -> int32_t {
+  return specifier == 'F' ? 2 : specifier == 'T' ? 5 : first_unit(specifier);
+}
+
+} // namespace detail
+
+/**
+ * @brief Selects date and time strings that fall in a time window [from, to),
+ * rejecting most strings outside it without parsing them, e.g. for scans
+ * over raw text columns.
+ *
+ * A format that starts with calendar fields in order of significance, e.g.
+ * %FT%T, %Y-%m-%d %H:%M or %Y%m%d%H%M%S, sorts as bytes the way its times
+ * sort, since each field has a fixed width. The filter writes both bounds
+ * once in the layout of those leading fields and compares each string
+ * against them with memcmp, which the C library vectorizes. Strings before
+ * or after the window are rejected by that comparison alone; the others are
+ * parsed to check their fields and compare their times exactly.
+ *
+ * The leading fields must reach the day. The fields after them may only be
+ * finer, e.g. .%f, or %I and %p after %F, or be %z or a weekday name. With %z, byte comparison applies
+ * to strings at the filter's UTC offset and the others are parsed. Every
+ * string is parsed for formats without leading calendar fields or with
+ * others such as %j, %b, %Z or %s. The result is always that of parse()
+ * followed by from <= t < to.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock);
+ * byte comparison needs system_clock, whose epoch is 1970-01-01 UTC.
+ */
+template <typename Clock = std::chrono::system_clock> class time_filter {
+public:
+  /**
+   * @brief Constructs a filter.
+   *
+   * @param format The format string, e.g. "{:%FT%T.%f}". An invalid format
+   * is reported by error() and selects nothing.
+   * @param from The start of the window.
+   * @param to The end of the window, excluded.
+   * @param offset The UTC offset of the strings compared as bytes if the
+   * format has %z.
+   */
+  time_filter(string_view format, typename Clock::time_point from,
+              typename Clock::time_point to,
+              std::chrono::minutes offset = std::chrono::minutes{0})
+      : ops_(format.size()), from_(from), to_(to),
+        offset_(static_cast<int32_t>(offset.count() * 60)) {
+    uint32_t size = 0;
+    error_ = detail::compile_format(ops_.data(), size, format);
+    ops_.resize(error_ == std::errc{} ? size : 0);
+    if (error_ == std::errc{} && from_ < to_ &&
+        std::is_same<Clock, std::chrono::system_clock>::value) {
+      init(offset);
+    }
+  }
+
+  /**
+   * @brief Returns the error found in the format, if any.
+   */
+  auto error() const noexcept -> std::errc { return error_; }
+
+  /**
+   * @brief Returns true if strings are compared as bytes against the bounds,
+   * false if every string is parsed.
+   */
+  auto byte_ordered() const noexcept -> bool { return width_ != 0; }
+
+  /**
+   * @brief Checks if a date and time string parses to a time in the window.
+   *
+   * @param date_str The date and time string.
+   * @return bool True if from <= parse(date_str) < to.
+   */
+  auto contains(string_view date_str) const -> bool {
+    if (!(from_ < to_)) {
+      return false;
+    }
+    if (width_ == 0) {
+      return parse_in_window(date_str);
+    }
+    // Every field of the leading ones has a fixed width
+    if (date_str.size() < width_) {
+      return false;
+    }
+    if (has_offset_) {
+      detail::tm time_struct{};
+      uint32_t next = width_ + 1;
+      const detail::format_op *const ops = ops_.data();
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      if (!detail::run_ops(time_struct, ops + rest_, ops + ops_.size(),
+                           date_str, next)
+               .ok()) {
+        return false;
+      }
+      if (time_struct.tm_offset != offset_) {
+        return parse_in_window(date_str);
+      }
+    }
+    if (empty_) {
+      return false;
+    }
+    // %F and %T skip their separators unchecked, and other ones sort apart
+    const std::string &layout = low_open_ ? high_ : low_;
+    for (uint32_t i = 0; i < separator_count_; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      const uint32_t position = separators_[i];
+      if (date_str[position] != layout[position]) {
+        return parse_in_window(date_str);
+      }
+    }
+    if ((!low_open_ && std::memcmp(date_str.data(), low_.data(), width_) < 0) ||
+        (!high_open_ && std::memcmp(date_str.data(), high_.data(), width_) > 0)) {
+      return false;
+    }
+    return parse_in_window(date_str);
+  }
+
+  /**
+   * @brief Selects the strings of a column that parse to a time in the
+   * window.
+   *
+   * @param inputs The date and time strings.
+   * @param count The number of strings.
+   * @param selected The indices of the selected strings, at least count
+   * elements.
+   * @return std::size_t The number of selected strings.
+   */
+  auto select(const string_view *inputs, std::size_t count,
+              std::size_t *selected) const -> std::size_t {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      if (contains(inputs[i])) {
+        selected[size++] = i;
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return size;
+  }
+
+private:
+  // Finds the leading calendar fields and writes the bounds in their layout
+  void init(std::chrono::minutes offset) {
+    bool twelve_hour = false;
+    for (const auto &operation : ops_) {
+      twelve_hour = twelve_hour || operation.specifier == 'p';
+    }
+    std::string layout = "{:";
+    int32_t unit = -1;
+    uint32_t width = 0;
+    std::size_t end = 0;
+    std::size_t layout_end = 0;
+    uint32_t end_width = 0;
+    for (std::size_t i = 0; i < ops_.size(); ++i) {
+      const char specifier = ops_[i].specifier;
+      if (specifier == '\0') {
+        layout += ops_[i].literal;
+        ++width;
+        continue;
+      }
+      const int32_t first = detail::first_unit(specifier);
+      if (first != unit + 1 || first > 5 || specifier == 'I' ||
+          specifier == 'p' || (twelve_hour && first >= 3)) {
+        break;
+      }
+      if ((specifier == 'F' || specifier == 'T') && separator_count_ < 4) {
+        const uint32_t step = specifier == 'F' ? 4 : 2;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+        separators_[separator_count_++] = width + step;
+        separators_[separator_count_++] = width + step + 3;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+      }
+      layout += '%';
+      layout += specifier;
+      width += detail::field_width(specifier);
+      unit = detail::last_unit(specifier);
+      end = i + 1;
+      layout_end = layout.size();
+      end_width = width;
+    }
+    // Without a day, parse() reads day 0, the last day of the month before,
+    // which does not sort with the month as written
+    if (unit < 2) {
+      return;
+    }
+    // The fields after them must be finer, or be checked by parsing alone
+    for (std::size_t i = end; i < ops_.size(); ++i) {
+      const char specifier = ops_[i].specifier;
+      const bool weekday =
+          specifier == 'a' || specifier == 'A' || specifier == 'u';
+      if (specifier == 'z') {
+        has_offset_ = true;
+      } else if (specifier != '\0' && !(weekday && unit >= 2) &&
+                 detail::first_unit(specifier) <= unit) {
+        return;
+      }
+    }
+    layout.resize(layout_end);
+    layout += '}';
+    // Without %z every string is in UTC
+    if (!has_offset_) {
+      offset = std::chrono::minutes{0};
+    }
+    // A string below the bound written one second before from is before it,
+    // even if it ends with a leap second, which counts as the next second
+    const bound_status status_low =
+        write_bound(low_, layout, from_, offset, std::chrono::seconds{1});
+    const bound_status status_high =
+        write_bound(high_, layout, to_, offset, std::chrono::seconds{0});
+    if (status_low == bound_status::error || status_high == bound_status::error ||
+        (status_low == bound_status::before && status_high == bound_status::after)) {
+      has_offset_ = false;
+      return;
+    }
+    low_open_ = status_low == bound_status::before;
+    high_open_ = status_high == bound_status::after;
+    empty_ = status_low == bound_status::after || status_high == bound_status::before;
+    rest_ = end;
+    width_ = end_width;
+  }
+
+  enum class bound_status : uint8_t {
+    written, // In years 0 to 9999
+    before,  // Before year 0
+    after,   // After year 9999
+    error
+  };
+
+  // Writes a bound, less a margin and floored to seconds, in the layout of
+  // the leading fields at the filter's offset
+  static auto write_bound(std::string &text, const std::string &layout,
+                          typename Clock::time_point bound,
+                          std::chrono::minutes offset,
+                          std::chrono::seconds margin) -> bound_status {
+    const auto since_epoch = bound.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    // Truncated toward zero, so converting back cannot overflow
+    if (since_epoch <
+        std::chrono::duration_cast<typename Clock::duration>(seconds)) {
+      seconds -= std::chrono::seconds{1};
+    }
+    seconds -= margin;
+    if (offset <= -std::chrono::hours{24} || offset >= std::chrono::hours{24}) {
+      return bound_status::error;
+    }
+    const int64_t days = detail::floor_div(
+        seconds.count() + (static_cast<int64_t>(offset.count()) * 60), 86400);
+    // days_from_civil(0, 1, 1) and days_from_civil(10000, 1, 1)
+    if (days < -719528) {
+      return bound_status::before;
+    }
+    if (days >= 2932897) {
+      return bound_status::after;
+    }
+    text.resize(layout.size() + 16);
+    const auto result = format_to(
+        &text[0], layout,
+        std::chrono::time_point<Clock, std::chrono::seconds>{seconds}, offset);
+    if (result.error != std::errc{}) {
+      return bound_status::error;
+    }
+    text.resize(static_cast<std::size_t>(result.out - text.data()));
+    return bound_status::written;
+  }
+
+  auto parse_in_window(string_view date_str) const -> bool {
+    detail::tm time_struct{};
+    uint32_t next = 0;
+    typename Clock::time_point time_point{};
+    const detail::format_op *const ops = ops_.data();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return error_ == std::errc{} &&
+           detail::run_ops(time_struct, ops, ops + ops_.size(), date_str, next)
+               .ok() &&
+           detail::finish_fields(time_struct, date_str, next).ok() &&
+           detail::to_time_point<Clock>(time_point, time_struct) ==
+               std::errc{} &&
+           !(time_point < from_) && time_point < to_;
+  }
+
+  std::vector<detail::format_op> ops_;
+  std::errc error_{};
+  typename Clock::time_point from_;
+  typename Clock::time_point to_;
+  int32_t offset_;
+  std::string low_;
+  std::string high_;
+  uint32_t width_{};
+  std::size_t rest_{};
+  uint32_t separators_[4]{}; // NOLINT(modernize-avoid-c-arrays)
+  uint32_t separator_count_{};
+  bool has_offset_{};
+  bool low_open_{};
+  bool high_open_{};
+  bool empty_{};
+};
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_FILTER_HPP
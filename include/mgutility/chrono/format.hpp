@@ -0,0 +1,422 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_FORMAT_HPP
+#define MGUTILITY_CHRONO_FORMAT_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief The result of format_to().
+ */
+struct format_result {
+  char *out;       ///< One past the last character written.
+  std::errc error; ///< An error code indicating success or failure.
+};
+
+namespace detail {
+
+/**
+ * @brief Returns the number of fraction digits %f writes for a duration:
+ * log10 of its period's denominator, at least 1 and at most 9.
+ *
+ * @tparam Duration The duration type of the time point.
+ */
+template <typename Duration>
+constexpr auto fraction_digits(intmax_t den = Duration::period::den,
+                               std::size_t digits = 0) noexcept
+    -> std::size_t {
+  return den <= 1 || digits == 9 ? (digits == 0 ? 1 : digits)
+                                 : fraction_digits<Duration>(den / 10, digits + 1);
+}
+
+/**
+ * @brief Checks if a specifier can be formatted. %Z cannot, since a time
+ * point does not carry its zone, and the name, week date and epoch
+ * specifiers are only parsed.
+ *
+ * @param specifier The specifier character following '%'.
+ * @return bool True if format_to() supports the specifier.
+ */
+constexpr auto is_format_specifier(char specifier) noexcept -> bool {
+  return specifier == 'Y' || specifier == 'm' || specifier == 'd' ||
+         specifier == 'F' || specifier == 'H' || specifier == 'M' ||
+         specifier == 'S' || specifier == 'T' || specifier == 'f' ||
+         specifier == 'z' || specifier == 'p';
+}
+
+/**
+ * @brief Returns the width %-specifier writes.
+ *
+ * @tparam Duration The duration type of the time point.
+ * @param specifier The specifier character following '%'.
+ * @return std::size_t The width, or 0 for an unknown specifier.
+ */
+template <typename Duration>
+constexpr auto specifier_width(char specifier) noexcept -> std::size_t {
+  return specifier == 'Y'   ? 4
+         : specifier == 'F' ? 10
+         : specifier == 'T' ? 8
+         : specifier == 'z' ? 5
+         : specifier == 'f' ? fraction_digits<Duration>()
+         : is_format_specifier(specifier) ? 2
+                                          : 0;
+}
+
+/**
+ * @brief Broken-down local time to format.
+ */
+struct civil_time {
+  int32_t year;        ///< Year.
+  uint32_t month;      ///< Month [1, 12].
+  uint32_t day;        ///< Day of the month [1, 31].
+  uint32_t hour;       ///< Hour [0, 23].
+  uint32_t minute;     ///< Minute [0, 59].
+  uint32_t second;     ///< Second [0, 59].
+  uint32_t fraction;   ///< Fractional second, already scaled to its digits.
+  int32_t offset;      ///< UTC offset in minutes.
+  bool twelve_hour;    ///< Hours are written on a 12-hour clock (%p present).
+};
+
+/**
+ * @brief Writes two digits from a lookup table.
+ *
+ * @param out The output position, advanced by two.
+ * @param value The value [0, 99].
+ */
+inline void write2(char *&out, uint32_t value) noexcept {
+  static constexpr const char digits[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-bounds-constant-array-index)
+  *out++ = digits[value * 2];
+  *out++ = digits[(value * 2) + 1];
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+/**
+ * @brief Writes a zero-padded number of a given width.
+ *
+ * @param out The output position, advanced by width.
+ * @param value The value, less than 10^width.
+ * @param width The number of digits.
+ */
+inline void write_digits(char *&out, uint32_t value, std::size_t width) noexcept {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  char *end = out + width;
+  char *position = end;
+  while (position - out >= 2) {
+    position -= 2;
+    char *pair = position;
+    write2(pair, value % 100);
+    value /= 100;
+  }
+  if (position != out) {
+    *out = static_cast<char>('0' + value);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  out = end;
+}
+
+/**
+ * @brief Writes the field named by a format specifier.
+ *
+ * @param out The output position, advanced past the field.
+ * @param specifier The specifier character following '%'.
+ * @param time The broken-down time.
+ * @param digits The number of fraction digits %f writes.
+ */
+inline void format_specifier(char *&out, char specifier, const civil_time &time,
+                             std::size_t digits) noexcept {
+  const uint32_t hour =
+      !time.twelve_hour ? time.hour : time.hour % 12 == 0 ? 12 : time.hour % 12;
+  switch (specifier) {
+  case 'Y':
+    write2(out, static_cast<uint32_t>(time.year) / 100);
+    write2(out, static_cast<uint32_t>(time.year) % 100);
+    break;
+  case 'm':
+    write2(out, time.month);
+    break;
+  case 'd':
+    write2(out, time.day);
+    break;
+  case 'F':
+    format_specifier(out, 'Y', time, digits);
+    *out++ = '-'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write2(out, time.month);
+    *out++ = '-'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write2(out, time.day);
+    break;
+  case 'H':
+    write2(out, hour);
+    break;
+  case 'M':
+    write2(out, time.minute);
+    break;
+  case 'S':
+    write2(out, time.second);
+    break;
+  case 'T':
+    write2(out, hour);
+    *out++ = ':'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write2(out, time.minute);
+    *out++ = ':'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write2(out, time.second);
+    break;
+  case 'f':
+    write_digits(out, time.fraction, digits);
+    break;
+  case 'z': {
+    const uint32_t offset = static_cast<uint32_t>(abs(time.offset));
+    *out++ = time.offset < 0 ? '-' : '+'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    write2(out, offset / 60);
+    write2(out, offset % 60);
+  } break;
+  case 'p':
+    *out++ = time.hour < 12 ? 'A' : 'P'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    *out++ = 'M'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @brief Breaks a time point down into civil fields at a UTC offset.
+ *
+ * @param time The broken-down time to populate.
+ * @param time_point The time point.
+ * @param offset The UTC offset.
+ * @return std::errc result_out_of_range if the year is outside [0, 9999] or
+ * the offset is not less than a day.
+ */
+template <typename Clock, typename Duration>
+auto to_civil_time(civil_time &time,
+                   const std::chrono::time_point<Clock, Duration> &time_point,
+                   std::chrono::minutes offset) -> std::errc {
+  using std::chrono::duration_cast;
+  if (offset.count() <= -(24 * 60) || offset.count() >= 24 * 60) {
+    return std::errc::result_out_of_range;
+  }
+  const auto local = time_point.time_since_epoch() + offset;
+  auto seconds = duration_cast<std::chrono::seconds>(local);
+  if (seconds > local) {
+    seconds -= std::chrono::seconds{1};
+  }
+  const auto nanoseconds =
+      duration_cast<std::chrono::nanoseconds>(local - seconds).count();
+
+  int64_t days = seconds.count() / 86400;
+  int64_t second_of_day = seconds.count() % 86400;
+  if (second_of_day < 0) {
+    second_of_day += 86400;
+    --days;
+  }
+  // days_from_civil(0, 1, 1) and days_from_civil(10000, 1, 1)
+  if (days < -719528 || days >= 2932897) {
+    return std::errc::result_out_of_range;
+  }
+
+  civil_from_days(static_cast<int32_t>(days), time.year, time.month, time.day);
+  time.hour = static_cast<uint32_t>(second_of_day / 3600);
+  time.minute = static_cast<uint32_t>(second_of_day / 60 % 60);
+  time.second = static_cast<uint32_t>(second_of_day % 60);
+  time.fraction = static_cast<uint32_t>(
+      nanoseconds / pow<int64_t>(10, 9 - static_cast<int64_t>(
+                                             fraction_digits<Duration>())));
+  time.offset = static_cast<int32_t>(offset.count());
+  return std::errc{};
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the exact number of characters format_to() writes for a
+ * compiled format. Every specifier has a fixed width, so in C++14 and later
+ * this is a constant expression suitable for sizing stack buffers.
+ *
+ * @tparam Duration The duration type of the time points to format, which
+ * sets the width of %f.
+ * @param format The compiled format.
+ * @return std::size_t The formatted size, or 0 if the format is invalid.
+ */
+template <typename Duration = std::chrono::system_clock::duration,
+          std::size_t N>
+MGUTILITY_CNSTXPR auto formatted_size(const compiled_format<N> &format) noexcept
+    -> std::size_t {
+  if (format.error != std::errc{}) {
+    return 0;
+  }
+  std::size_t size = 0;
+  for (uint32_t i = 0; i < format.size; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const char specifier = format.ops[i].specifier;
+    if (specifier != '\0' && !detail::is_format_specifier(specifier)) {
+      return 0;
+    }
+    size += specifier == '\0' ? 1 : detail::specifier_width<Duration>(specifier);
+  }
+  return size;
+}
+
+/**
+ * @brief Returns the exact number of characters format_to() writes for a
+ * format string.
+ *
+ * @tparam Duration The duration type of the time points to format, which
+ * sets the width of %f.
+ * @param format The format string.
+ * @return std::size_t The formatted size, or 0 if the format is invalid.
+ */
+template <typename Duration = std::chrono::system_clock::duration>
+MGUTILITY_CNSTXPR auto formatted_size(string_view format) noexcept
+    -> std::size_t {
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos ||
+      end - begin < 3 || format[begin + 1] != ':') {
+    return 0;
+  }
+  std::size_t size = 0;
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] != '%') {
+      ++size;
+      continue;
+    }
+    if (i + 1 >= end || !detail::is_format_specifier(format[i + 1])) {
+      return 0;
+    }
+    size += detail::specifier_width<Duration>(format[++i]);
+  }
+  return size;
+}
+
+/**
+ * @brief Formats a time point into a caller-provided buffer without
+ * allocating. The inverse of parse().
+ *
+ * Writes the replacement field of format, e.g. "{:%FT%T.%f%z}", using the
+ * same specifiers parse() understands. %H and %T use a 12-hour clock when
+ * the format contains %p, and %f writes as many digits as the precision of
+ * Duration.
+ *
+ * @param out The output buffer, at least formatted_size() characters.
+ * @param format The format string.
+ * @param time_point The time point to format.
+ * @param offset The UTC offset to format the local time at, written by %z.
+ * @return format_result One past the last character written and an error
+ * code; nothing is written on error.
+ */
+template <typename Clock, typename Duration>
+auto format_to(char *out, string_view format,
+               const std::chrono::time_point<Clock, Duration> &time_point,
+               std::chrono::minutes offset = std::chrono::minutes{0})
+    -> format_result {
+  if (formatted_size<Duration>(format) == 0) {
+    return format_result{out, std::errc::invalid_argument};
+  }
+  detail::civil_time time{};
+  const auto error = detail::to_civil_time(time, time_point, offset);
+  if (error != std::errc{}) {
+    return format_result{out, error};
+  }
+
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] == '%' && format[i + 1] == 'p') {
+      time.twelve_hour = true;
+    }
+  }
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] == '%') {
+      detail::format_specifier(out, format[++i], time,
+                               detail::fraction_digits<Duration>());
+    } else {
+      *out++ = format[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+  }
+  return format_result{out, std::errc{}};
+}
+
+/**
+ * @brief Formats a time point into a caller-provided buffer without
+ * allocating, using a compiled format.
+ *
+ * @param out The output buffer, at least formatted_size() characters.
+ * @param format The compiled format.
+ * @param time_point The time point to format.
+ * @param offset The UTC offset to format the local time at, written by %z.
+ * @return format_result One past the last character written and an error
+ * code; nothing is written on error.
+ */
+template <typename Clock, typename Duration, std::size_t N>
+auto format_to(char *out, const compiled_format<N> &format,
+               const std::chrono::time_point<Clock, Duration> &time_point,
+               std::chrono::minutes offset = std::chrono::minutes{0})
+    -> format_result {
+  if (formatted_size<Duration>(format) == 0) {
+    return format_result{out, std::errc::invalid_argument};
+  }
+  detail::civil_time time{};
+  const auto error = detail::to_civil_time(time, time_point, offset);
+  if (error != std::errc{}) {
+    return format_result{out, error};
+  }
+
+  for (uint32_t i = 0; i < format.size; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    time.twelve_hour = time.twelve_hour || format.ops[i].specifier == 'p';
+  }
+  for (uint32_t i = 0; i < format.size; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const detail::format_op &operation = format.ops[i];
+    if (operation.specifier == '\0') {
+      *out++ = operation.literal; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    } else {
+      detail::format_specifier(out, operation.specifier, time,
+                               detail::fraction_digits<Duration>());
+    }
+  }
+  return format_result{out, std::errc{}};
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_FORMAT_HPP
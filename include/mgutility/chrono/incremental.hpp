@@ -0,0 +1,580 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_INCREMENTAL_HPP
+#define MGUTILITY_CHRONO_INCREMENTAL_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/plan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief The state of an incremental_parser after a feed() or finish().
+ */
+enum class feed_status : uint8_t {
+  need_more, ///< Every byte was read and the timestamp is not complete yet.
+  done,      ///< The timestamp is complete and converted.
+  error      ///< The input does not match the format, see result().
+};
+
+/**
+ * @brief Parses a timestamp that arrives in pieces, e.g. from a protocol
+ * decoder that sees one byte or one packet at a time.
+ *
+ * Each feed() reads the bytes of a chunk in place and keeps only the parse
+ * state between calls: the operation of the format being read, the digits
+ * of the field so far as an integer and the fields already parsed. No input
+ * byte is ever copied, so a chunk may be released as soon as feed() returns.
+ *
+ * The format means what it means for parse(), with one difference: the
+ * timestamp ends at the end of its last field, and the character that
+ * parse() skips after it is left to the caller. A last field of variable
+ * width (%f, %s, %e or %z) ends at the first character that cannot belong
+ * to it, or at finish(). %Z is not supported, since the zone name would be a
+ * view into a chunk that may be gone.
+ *
+ * @code
+ * mgutility::chrono::incremental_parser<> parser{"{:%FT%T.%f%z}"};
+ * while (parser.feed(packet) == mgutility::chrono::feed_status::need_more) {
+ *   // read the next packet
+ * }
+ * @endcode
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ */
+template <typename Clock = std::chrono::system_clock> class incremental_parser {
+public:
+  /**
+   * @brief The maximum number of fields and literal characters of a format.
+   */
+  static constexpr std::size_t capacity = 48;
+
+  using time_point = typename Clock::time_point;
+
+  /**
+   * @brief Makes a parser for a format string.
+   *
+   * @param format The format string, e.g. "{:%FT%T.%f%z}". An invalid
+   * format, one with more than capacity fields and literals
+   * (value_too_large) or one with %Z (not_supported) is reported by error()
+   * and by every feed().
+   */
+  explicit MGUTILITY_CNSTXPR incremental_parser(string_view format) noexcept {
+    if (format.size() > capacity + 3 && detail::op_count(format) > capacity) {
+      error_ = std::errc::value_too_large;
+    } else {
+      error_ = detail::compile_format(static_cast<detail::format_op *>(ops_),
+                                      size_, format);
+    }
+    for (uint32_t i = 0; error_ == std::errc{} && i < size_; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      if (ops_[i].specifier == 'Z') {
+        error_ = std::errc::not_supported;
+        error_specifier_ = 'Z';
+      }
+    }
+    reset();
+  }
+
+  /**
+   * @brief Returns the error found in the format, if any.
+   */
+  constexpr auto error() const noexcept -> std::errc { return error_; }
+
+  /**
+   * @brief Forgets the timestamp read so far, to read the next one.
+   */
+  MGUTILITY_CNSTXPR void reset() noexcept {
+    tm_ = detail::tm{};
+    time_ = time_point{};
+    index_ = 0;
+    position_ = 0;
+    chunk_start_ = 0;
+    consumed_ = 0;
+    start_ = 0;
+    clear_field();
+    if (error_ != std::errc{}) {
+      status_ = feed_status::error;
+      result_ = parse_result{error_, 0, error_specifier_, parse_stage::format};
+      return;
+    }
+    status_ = feed_status::need_more;
+    result_ = parse_result{};
+  }
+
+  /**
+   * @brief Reads the next piece of the input.
+   *
+   * @param chunk The bytes following those of the previous feed().
+   * @return feed_status need_more once every byte is read, done when the
+   * timestamp is complete, with consumed() bytes of the chunk belonging to
+   * it, or error. After done or error the chunk is ignored until reset().
+   */
+  auto feed(string_view chunk) -> feed_status {
+    if (status_ != feed_status::need_more) {
+      consumed_ = 0;
+      return status_;
+    }
+    chunk_start_ = position_ + (held_ ? 1 : 0);
+    std::size_t index = 0;
+    while (status_ == feed_status::need_more && index < chunk.size()) {
+      if (replay()) {
+        continue;
+      }
+      if (step(chunk[index])) {
+        ++index;
+      }
+    }
+    consumed_ = status_ == feed_status::need_more
+                    ? chunk.size()
+                    : (position_ > chunk_start_ ? position_ - chunk_start_ : 0);
+    return status_;
+  }
+
+  /**
+   * @brief Marks the end of the input, which completes a last field of
+   * variable width.
+   *
+   * @return feed_status done or error; a timestamp cut short is an error.
+   */
+  auto finish() -> feed_status {
+    consumed_ = 0;
+    while (status_ == feed_status::need_more) {
+      const detail::format_op &operation = ops_[index_];
+      if (replay()) {
+        continue;
+      }
+      if (operation.specifier == '\0') {
+        fail(std::errc::invalid_argument, position_, '\0',
+             parse_stage::separator);
+      } else if (!can_end(operation.specifier)) {
+        // As parse() does, a part of %F or %T that is missing starts after
+        // the separator that is missing too
+        fail(std::errc::invalid_argument,
+             part_ % 2 != 0 && (operation.specifier == 'F' ||
+                                operation.specifier == 'T')
+                 ? position_ + 1
+                 : start_,
+             operation.specifier, parse_stage::field);
+      } else {
+        end_field(operation.specifier);
+      }
+    }
+    return status_;
+  }
+
+  /**
+   * @brief Returns the state after the last feed() or finish().
+   */
+  constexpr auto status() const noexcept -> feed_status { return status_; }
+
+  /**
+   * @brief Returns the diagnostics of a finished parse. The position counts
+   * from the first byte fed since reset(): the end of the timestamp when
+   * done, or where and why parsing stopped, as for parse().
+   */
+  constexpr auto result() const noexcept -> parse_result { return result_; }
+
+  /**
+   * @brief Returns the time point parsed, once the status is done.
+   */
+  constexpr auto time() const noexcept -> time_point { return time_; }
+
+  /**
+   * @brief Returns the number of bytes of the last chunk that were read, all
+   * of them while more are needed; when done the rest of the chunk follows
+   * the timestamp.
+   */
+  constexpr auto consumed() const noexcept -> std::size_t { return consumed_; }
+
+private:
+  // Clears the state of the field being read
+  MGUTILITY_CNSTXPR void clear_field() noexcept {
+    value_ = 0;
+    count_ = 0;
+    part_ = 0;
+    offset_ = 0;
+    extended_ = 0;
+    negative_ = false;
+    held_ = false;
+    replay_ = false;
+  }
+
+  void fail(std::errc error, uint32_t position, char specifier,
+            parse_stage stage) {
+    result_ = parse_result{error, position, specifier, stage};
+    status_ = feed_status::error;
+  }
+
+  void fail_field(std::errc error) {
+    fail(error, start_, ops_[index_].specifier, parse_stage::field);
+  }
+
+  // Moves to the next operation, converting the fields after the last one
+  void next_operation() {
+    ++index_;
+    start_ = position_;
+    clear_field();
+    if (index_ != size_) {
+      return;
+    }
+    parse_result status = detail::finish_fields(tm_, string_view{}, 0);
+    status.position = position_;
+    result_ = detail::to_time_point<Clock>(time_, tm_, status);
+    status_ = result_.ok() ? feed_status::done : feed_status::error;
+  }
+
+  // Reads the colon held back by %z when it turned out not to belong to it
+  auto replay() -> bool {
+    if (!replay_) {
+      return false;
+    }
+    replay_ = false;
+    step(':');
+    return true;
+  }
+
+  // True if a field of variable width may end before the next byte
+  auto can_end(char specifier) const noexcept -> bool {
+    switch (specifier) {
+    case 'f':
+    case 'e':
+    case 's':
+      return count_ != 0;
+    case 'z':
+      return held_ || (part_ >= 2 && count_ == 0);
+    default:
+      return false;
+    }
+  }
+
+  // Reads one byte; false if it ends the field without belonging to it and
+  // must be read again by the next operation
+  auto step(char chr) -> bool {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const detail::format_op &operation = ops_[index_];
+    if (operation.specifier == '\0') {
+      if (chr != operation.literal) {
+        fail(std::errc::invalid_argument, position_, '\0',
+             parse_stage::separator);
+        return true;
+      }
+      ++position_;
+      next_operation();
+      return true;
+    }
+    const uint32_t digit =
+        static_cast<uint32_t>(static_cast<unsigned char>(chr)) - '0';
+    switch (operation.specifier) {
+    case 'F':
+    case 'T':
+      if (part_ % 2 != 0) {
+        // The separator between two parts is not checked, as by parse()
+        ++part_;
+        ++position_;
+        start_ = position_;
+        return true;
+      }
+      return take_digit(digit, operation.specifier == 'F'
+                                   ? "Y?m?d"[part_] // NOLINT
+                                   : "H?M?S"[part_]); // NOLINT
+    case 'f':
+    case 's':
+    case 'e':
+      if (count_ == 0 && part_ == 0 &&
+          chr == (operation.specifier == 'e' ? ' ' : '-') &&
+          operation.specifier != 'f') {
+        part_ = 1;
+        negative_ = operation.specifier == 's';
+        ++position_;
+        return true;
+      }
+      if (digit > 9) {
+        return end_field(operation.specifier);
+      }
+      value_ = (value_ * 10) + digit;
+      ++count_;
+      ++position_;
+      if (count_ == (operation.specifier == 'f'   ? 9U
+                     : operation.specifier == 's' ? 19U
+                                                  : 2U)) {
+        end_field(operation.specifier);
+      }
+      return true;
+    case 'z':
+      return step_offset(chr, digit);
+    case 'p':
+      return step_am_pm(chr);
+    case 'b':
+    case 'B':
+    case 'a':
+    case 'A':
+      return step_name(chr, operation.specifier);
+    default:
+      return take_digit(digit, operation.specifier);
+    }
+  }
+
+  // Reads a digit of a fixed-width field, or of a part of %F or %T
+  auto take_digit(uint32_t digit, char specifier) -> bool {
+    if (digit > 9) {
+      fail_field(std::errc::invalid_argument);
+      return true;
+    }
+    value_ = (value_ * 10) + digit;
+    ++position_;
+    if (++count_ != detail::field_width(specifier)) {
+      return true;
+    }
+    const auto error =
+        detail::store_field(tm_, specifier, static_cast<int32_t>(value_));
+    if (error != std::errc{}) {
+      fail_field(error);
+    } else if (ops_[index_].specifier != specifier && part_ != 4) {
+      part_ = static_cast<uint8_t>(part_ + 1);
+      value_ = 0;
+      count_ = 0;
+    } else {
+      next_operation();
+    }
+    return true;
+  }
+
+  // Stores a field of variable width once a byte that does not belong to it,
+  // or the end of the input, is reached
+  auto end_field(char specifier) -> bool {
+    if (count_ == 0 && specifier != 'z') {
+      fail_field(std::errc::invalid_argument);
+      return false;
+    }
+    std::errc error{};
+    switch (specifier) {
+    case 'f':
+      tm_.tm_ms = static_cast<uint32_t>(value_) *
+                  detail::pow<uint32_t>(10, 9 - count_);
+      break;
+    case 'e':
+      error = detail::store_field(tm_, 'e', static_cast<int32_t>(value_));
+      break;
+    case 's':
+      error = value_ > static_cast<uint64_t>(INT64_MAX)
+                  ? std::errc::result_out_of_range
+                  : detail::fields_from_seconds(
+                        tm_, negative_ ? -static_cast<int64_t>(value_)
+                                       : static_cast<int64_t>(value_));
+      break;
+    default: {
+      const bool held = held_;
+      error = detail::check_range(offset_, 0, 14 * 3600);
+      tm_.tm_has_offset = true;
+      tm_.tm_offset = negative_ ? -offset_ : offset_;
+      if (error == std::errc{}) {
+        next_operation();
+        // A colon not followed by a digit is read by the next operation
+        replay_ = held && status_ == feed_status::need_more;
+        return false;
+      }
+      break;
+    }
+    }
+    if (error != std::errc{}) {
+      fail_field(error);
+    } else {
+      next_operation();
+    }
+    return false;
+  }
+
+  // Reads %z: Z, or a sign and pairs of digits as +hh, +hhmm, +hh:mm,
+  // +hhmmss or +hh:mm:ss, the separator of the first pair deciding the rest
+  auto step_offset(char chr, uint32_t digit) -> bool {
+    if (part_ == 0) {
+      if (chr == 'Z') {
+        tm_.tm_has_offset = true;
+        tm_.tm_offset = 0;
+        ++position_;
+        next_operation();
+      } else if (chr == '+' || chr == '-') {
+        negative_ = chr == '-';
+        part_ = 1;
+        ++position_;
+      } else {
+        fail_field(std::errc::invalid_argument);
+      }
+      return true;
+    }
+    if (held_) {
+      if (digit > 9) {
+        return end_field('z');
+      }
+      held_ = false;
+      extended_ = 2;
+      ++position_;
+    } else if (count_ == 0 && part_ >= 2) {
+      // The colon is held back until a digit shows it belongs to the offset
+      if (chr == ':' && extended_ != 1) {
+        held_ = true;
+        return true;
+      }
+      if (digit > 9 || extended_ == 2) {
+        return end_field('z');
+      }
+      extended_ = 1;
+    }
+    if (digit > 9) {
+      fail_field(std::errc::invalid_argument);
+      return true;
+    }
+    value_ = (value_ * 10) + digit;
+    ++position_;
+    if (++count_ < 2) {
+      return true;
+    }
+    const auto pair = static_cast<int32_t>(value_);
+    if (part_ > 1 && pair > 59) {
+      fail_field(std::errc::invalid_argument);
+      return true;
+    }
+    offset_ += pair * (part_ == 1 ? 3600 : part_ == 2 ? 60 : 1);
+    value_ = 0;
+    count_ = 0;
+    if (++part_ == 4) {
+      end_field('z');
+    }
+    return true;
+  }
+
+  // Reads AM or PM and moves the 12-hour clock hour to 24 hours
+  auto step_am_pm(char chr) -> bool {
+    if (count_ == 0) {
+      if (tm_.tm_hour < 1 || tm_.tm_hour > 12 || (chr != 'A' && chr != 'P')) {
+        fail_field(std::errc::invalid_argument);
+        return true;
+      }
+      value_ = chr == 'P' ? 1 : 0;
+      count_ = 1;
+      ++position_;
+      return true;
+    }
+    if (chr != 'M') {
+      fail_field(std::errc::invalid_argument);
+      return true;
+    }
+    ++position_;
+    if (value_ == 0 && tm_.tm_hour == 12) {
+      tm_.tm_hour = 0;
+    } else if (value_ != 0 && tm_.tm_hour != 12) {
+      tm_.tm_hour += 12;
+    }
+    next_operation();
+    return true;
+  }
+
+  // Reads a month or weekday name: the first three letters are packed as by
+  // pack_name() and looked up, the rest of a full name compared one by one
+  auto step_name(char chr, char specifier) -> bool {
+    const bool weekday = specifier == 'a' || specifier == 'A';
+    const auto lower =
+        static_cast<uint32_t>(static_cast<unsigned char>(chr)) | 0x20U;
+    if (count_ < 3) {
+      value_ = (value_ << 8U) | lower;
+      ++position_;
+      if (++count_ < 3) {
+        return true;
+      }
+      const auto key = static_cast<uint32_t>(value_);
+      const int32_t index = weekday ? detail::weekday_from_name(key)
+                                    : detail::month_from_name(key);
+      if (index < 0) {
+        fail_field(std::errc::invalid_argument);
+        return true;
+      }
+      value_ = static_cast<uint64_t>(index);
+    } else {
+      const auto index = static_cast<int32_t>(value_);
+      const string_view name = weekday ? detail::full_weekday_name(index)
+                                       : detail::full_month_name(index);
+      if (lower != static_cast<uint32_t>(name[count_])) {
+        fail_field(std::errc::invalid_argument);
+        return true;
+      }
+      ++position_;
+      ++count_;
+    }
+    const auto index = static_cast<int32_t>(value_);
+    if (specifier == 'B' || specifier == 'A') {
+      const string_view name = weekday ? detail::full_weekday_name(index)
+                                       : detail::full_month_name(index);
+      if (count_ < name.size()) {
+        return true;
+      }
+    }
+    if (weekday) {
+      tm_.tm_wday = index;
+      tm_.tm_derive |= detail::has_weekday;
+    } else {
+      tm_.tm_mon = index;
+    }
+    next_operation();
+    return true;
+  }
+
+  detail::format_op ops_[capacity]{}; // NOLINT
+  uint32_t size_{};
+  std::errc error_{};
+  char error_specifier_{};
+  detail::tm tm_{};
+  time_point time_{};
+  parse_result result_{};
+  feed_status status_{};
+  uint32_t index_{};       // The operation being read
+  uint32_t position_{};    // Bytes of the timestamp read since reset()
+  uint32_t start_{};       // Where the field, or part of %F or %T, began
+  uint32_t chunk_start_{}; // Where the last chunk began
+  std::size_t consumed_{};
+  uint64_t value_{};       // The digits of the field so far
+  uint32_t count_{};       // Digits or letters of the field so far
+  uint8_t part_{};         // Part of %F, %T or %z; a sign or space was read
+  uint8_t extended_{};     // %z: 1 for +hhmm, 2 for +hh:mm
+  bool negative_{};
+  bool held_{};            // %z: a colon was read but not yet counted
+  bool replay_{};          // The held colon is read by the next operation
+  int32_t offset_{};
+};
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_INCREMENTAL_HPP
@@ -0,0 +1,306 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_INSTRUMENT_HPP
+#define MGUTILITY_CHRONO_INSTRUMENT_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define MGUTILITY_CHRONO_HAS_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) &&                             \
+    (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define MGUTILITY_CHRONO_HAS_RDTSC
+#endif
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Reads the time stamp counter, or a steady clock in nanoseconds
+ * where there is none.
+ *
+ * @return uint64_t The current count.
+ */
+inline auto read_cycles() noexcept -> uint64_t {
+#ifdef MGUTILITY_CHRONO_HAS_RDTSC
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Per-specifier call counts, failure counts and cycle histograms of
+ * instrumented parses.
+ *
+ * Counters are kept per specifier character; specifier '\0' counts the
+ * conversions of parsed fields to time points. Failures are split by error:
+ * invalid_argument, result_out_of_range, not_supported, and any other
+ * error. Histogram bucket i counts calls that took [2^i, 2^(i+1)) cycles,
+ * bucket 0 also counting calls of 0 or 1 cycle.
+ */
+class parse_counters {
+public:
+  static constexpr std::size_t buckets = 32; ///< Histogram buckets.
+  static constexpr std::size_t errors = 4;   ///< Failure kinds.
+
+  /**
+   * @brief Counts a call.
+   *
+   * @param specifier The specifier, '\0' for a conversion.
+   * @param error The outcome of the call.
+   */
+  void record(char specifier, std::errc error) noexcept {
+    slot &counters = slots_[index(specifier)];
+    ++counters.calls;
+    if (error != std::errc{}) {
+      ++counters.failures[error_index(error)];
+    }
+  }
+
+  /**
+   * @brief Counts a call and the cycles it took.
+   *
+   * @param specifier The specifier, '\0' for a conversion.
+   * @param error The outcome of the call.
+   * @param cycles The cycles the call took.
+   */
+  void record(char specifier, std::errc error, uint64_t cycles) noexcept {
+    record(specifier, error);
+    std::size_t bucket = 0;
+    while (cycles > 1 && bucket + 1 < buckets) {
+      cycles >>= 1U;
+      ++bucket;
+    }
+    ++slots_[index(specifier)].cycles[bucket];
+  }
+
+  /**
+   * @brief Returns the number of calls for a specifier.
+   */
+  auto calls(char specifier) const noexcept -> uint64_t {
+    return slots_[index(specifier)].calls;
+  }
+
+  /**
+   * @brief Returns the number of failed calls for a specifier.
+   */
+  auto failures(char specifier) const noexcept -> uint64_t {
+    uint64_t total = 0;
+    for (const auto count : slots_[index(specifier)].failures) {
+      total += count;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Returns the number of calls for a specifier that failed with an
+   * error; errors other than invalid_argument, result_out_of_range and
+   * not_supported are counted together.
+   */
+  auto failures(char specifier, std::errc error) const noexcept -> uint64_t {
+    return slots_[index(specifier)].failures[error_index(error)];
+  }
+
+  /**
+   * @brief Returns a bucket of the cycle histogram of a specifier.
+   *
+   * @param specifier The specifier, '\0' for conversions.
+   * @param bucket The bucket, counting calls of [2^bucket, 2^(bucket+1))
+   * cycles.
+   */
+  auto cycles(char specifier, std::size_t bucket) const noexcept
+      -> uint64_t {
+    return bucket < buckets ? slots_[index(specifier)].cycles[bucket] : 0;
+  }
+
+  /**
+   * @brief Adds the counters of another set, e.g. of another thread.
+   *
+   * @param other The counters to add.
+   */
+  void merge(const parse_counters &other) noexcept {
+    for (std::size_t i = 0; i < slots; ++i) {
+      slots_[i].calls += other.slots_[i].calls;
+      for (std::size_t j = 0; j < errors; ++j) {
+        slots_[i].failures[j] += other.slots_[i].failures[j];
+      }
+      for (std::size_t j = 0; j < buckets; ++j) {
+        slots_[i].cycles[j] += other.slots_[i].cycles[j];
+      }
+    }
+  }
+
+  /**
+   * @brief Resets every counter to zero.
+   */
+  void clear() noexcept { *this = parse_counters{}; }
+
+  /**
+   * @brief Writes the counters as text, one line per specifier that was
+   * called, e.g. "%z calls=10 invalid_argument=1 cycles[2^6]=9 ...".
+   *
+   * @return std::string The text.
+   */
+  auto dump() const -> std::string {
+    static const char *const error_names[errors] = {
+        "invalid_argument", "result_out_of_range", "not_supported", "other"};
+    std::string text;
+    char buffer[64]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    for (std::size_t i = 0; i < slots; ++i) {
+      const slot &counters = slots_[i];
+      if (counters.calls == 0) {
+        continue;
+      }
+      if (i == 0) {
+        text += "conversion";
+      } else {
+        text += '%';
+        text += static_cast<char>('A' + i - 1);
+      }
+      std::snprintf(buffer, sizeof(buffer), " calls=%llu",
+                    static_cast<unsigned long long>(counters.calls));
+      text += buffer;
+      for (std::size_t j = 0; j < errors; ++j) {
+        if (counters.failures[j] != 0) {
+          std::snprintf(buffer, sizeof(buffer), " %s=%llu", error_names[j],
+                        static_cast<unsigned long long>(counters.failures[j]));
+          text += buffer;
+        }
+      }
+      for (std::size_t j = 0; j < buckets; ++j) {
+        if (counters.cycles[j] != 0) {
+          std::snprintf(buffer, sizeof(buffer), " cycles[2^%u]=%llu",
+                        static_cast<unsigned>(j),
+                        static_cast<unsigned long long>(counters.cycles[j]));
+          text += buffer;
+        }
+      }
+      text += '\n';
+    }
+    return text;
+  }
+
+private:
+  // Slot 0 holds conversions and unknown specifiers, 1 + c - 'A' the
+  // specifier c in 'A'..'z'
+  static constexpr std::size_t slots = 1 + 'z' - 'A' + 1;
+
+  struct slot {
+    uint64_t calls;
+    uint64_t failures[errors]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    uint64_t cycles[buckets];  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  };
+
+  static constexpr auto index(char specifier) noexcept -> std::size_t {
+    return specifier >= 'A' && specifier <= 'z'
+               ? static_cast<std::size_t>(specifier - 'A') + 1
+               : 0;
+  }
+
+  static constexpr auto error_index(std::errc error) noexcept
+      -> std::size_t {
+    return error == std::errc::invalid_argument      ? 0
+           : error == std::errc::result_out_of_range ? 1
+           : error == std::errc::not_supported       ? 2
+                                                     : 3;
+  }
+
+  slot slots_[slots]{}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+/**
+ * @brief Returns the counters of the calling thread. Instrumented parses
+ * write here without synchronization; merge() the counters of each thread
+ * to get totals.
+ *
+ * @return parse_counters& The counters of the calling thread.
+ */
+inline auto thread_counters() noexcept -> parse_counters & {
+  static thread_local parse_counters counters;
+  return counters;
+}
+
+/**
+ * @brief Instrumentation policy counting the calls and failures of each
+ * specifier and of conversions in thread_counters().
+ *
+ * @code
+ * mgutility::chrono::parse<std::chrono::system_clock,
+ *                          mgutility::chrono::count_instrumentation>(
+ *     time_point, "{:%FT%T%z}", "2023-04-30T16:22:18+0300");
+ * @endcode
+ */
+struct count_instrumentation {
+  static auto start() noexcept -> uint64_t { return 0; }
+
+  static void field(char specifier, std::errc error,
+                    uint64_t /*start*/) noexcept {
+    thread_counters().record(specifier, error);
+  }
+
+  static void conversion(std::errc error, uint64_t /*start*/) noexcept {
+    thread_counters().record('\0', error);
+  }
+};
+
+/**
+ * @brief Instrumentation policy that also records a histogram of the cycles
+ * each specifier and conversion takes, read with rdtsc on x86 and from
+ * std::chrono::steady_clock in nanoseconds elsewhere.
+ */
+struct cycle_instrumentation {
+  static auto start() noexcept -> uint64_t { return detail::read_cycles(); }
+
+  static void field(char specifier, std::errc error, uint64_t start) noexcept {
+    thread_counters().record(specifier, error, detail::read_cycles() - start);
+  }
+
+  static void conversion(std::errc error, uint64_t start) noexcept {
+    thread_counters().record('\0', error, detail::read_cycles() - start);
+  }
+};
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_INSTRUMENT_HPP
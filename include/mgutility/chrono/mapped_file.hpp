@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_MAPPED_FILE_HPP
+#define MGUTILITY_CHRONO_MAPPED_FILE_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/std/string_view.hpp"
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Reads a whole file.
+ *
+ * @param path The file path.
+ * @param content The file content.
+ * @return bool False if the file cannot be read.
+ */
+inline auto read_file(const std::string &path, std::vector<char> &content)
+    -> bool {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  content.clear();
+  char chunk[4096]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  std::size_t read = 0;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) != 0) {
+    content.insert(content.end(), chunk, chunk + read); // NOLINT
+  }
+  const bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  return !failed;
+}
+
+} // namespace detail
+
+/**
+ * @brief A read-only view of a whole file, memory-mapped where the platform
+ * supports it and read into memory otherwise. Movable, not copyable.
+ */
+class mapped_file {
+public:
+  mapped_file() noexcept = default;
+  mapped_file(const mapped_file &) = delete;
+  auto operator=(const mapped_file &) -> mapped_file & = delete;
+
+  mapped_file(mapped_file &&other) noexcept { swap(other); }
+
+  auto operator=(mapped_file &&other) noexcept -> mapped_file & {
+    mapped_file moved{std::move(other)};
+    swap(moved);
+    return *this;
+  }
+
+  ~mapped_file() {
+#if !defined(_WIN32)
+    if (mapping_ != nullptr) {
+      ::munmap(mapping_, size_);
+    }
+#endif
+  }
+
+  /**
+   * @brief Maps a file.
+   *
+   * @param path The file path.
+   * @param file The mapped file.
+   * @param sequential Hint that the file is read front to back once.
+   * @return std::errc An error code indicating success or failure.
+   */
+  static auto open(string_view path, mapped_file &file,
+                   bool sequential = false) -> std::errc {
+    const std::string name(path.data(), path.size());
+    mapped_file opened{};
+#if !defined(_WIN32)
+    const int descriptor = ::open(name.c_str(), O_RDONLY); // NOLINT
+    if (descriptor < 0) {
+      return std::errc::no_such_file_or_directory;
+    }
+    struct stat status {};
+    if (::fstat(descriptor, &status) != 0) {
+      ::close(descriptor);
+      return std::errc::io_error;
+    }
+    opened.size_ = static_cast<std::size_t>(status.st_size);
+    if (opened.size_ != 0) {
+      void *mapping = ::mmap(nullptr, opened.size_, PROT_READ, MAP_PRIVATE,
+                             descriptor, 0);
+      if (mapping == MAP_FAILED) { // NOLINT
+        ::close(descriptor);
+        return std::errc::io_error;
+      }
+      if (sequential) {
+        ::madvise(mapping, opened.size_, MADV_SEQUENTIAL);
+      }
+      opened.mapping_ = mapping;
+      opened.data_ = static_cast<const char *>(mapping);
+    }
+    ::close(descriptor);
+#else
+    (void)sequential;
+    if (!detail::read_file(name, opened.buffer_)) {
+      return std::errc::no_such_file_or_directory;
+    }
+    opened.data_ = opened.buffer_.data();
+    opened.size_ = opened.buffer_.size();
+#endif
+    file = std::move(opened);
+    return std::errc{};
+  }
+
+  /**
+   * @brief Returns the file content, empty if nothing is mapped.
+   */
+  auto data() const noexcept -> const char * { return data_; }
+
+  /**
+   * @brief Returns the file size in bytes.
+   */
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  /**
+   * @brief Returns the file content as a string view.
+   */
+  auto view() const noexcept -> string_view {
+    return data_ == nullptr ? string_view{} : string_view{data_, size_};
+  }
+
+private:
+  void swap(mapped_file &other) noexcept {
+    buffer_.swap(other.buffer_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(mapping_, other.mapping_);
+  }
+
+  std::vector<char> buffer_;
+  const char *data_{};
+  std::size_t size_{};
+  void *mapping_{};
+};
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_MAPPED_FILE_HPP
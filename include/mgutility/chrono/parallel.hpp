@@ -0,0 +1,276 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_PARALLEL_HPP
+#define MGUTILITY_CHRONO_PARALLEL_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse_many.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Options for parallel_parse().
+ */
+struct parallel_options {
+  unsigned threads;       ///< Worker threads including the caller, 0 for one per hardware thread.
+  std::size_t chunk_size; ///< Elements per unit of work, 0 for the default.
+};
+
+namespace detail {
+
+constexpr std::size_t default_chunk_size = 512;
+
+/**
+ * @brief A worker's remaining chunks [begin, end), packed into one atomic
+ * word so the owner can take from the front and thieves from the back.
+ * Padded so that neighbouring workers never share a cache line.
+ */
+struct work_range {
+  std::atomic<uint64_t> chunks{0};
+  std::size_t failures{0};
+  char padding[128 - sizeof(std::atomic<uint64_t>) - sizeof(std::size_t)]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+};
+
+constexpr auto pack_range(uint64_t begin, uint64_t end) noexcept -> uint64_t {
+  return (begin << 32U) | end;
+}
+
+/**
+ * @brief Takes the first chunk of a worker's own range.
+ *
+ * @param range The worker's range.
+ * @param chunk The chunk taken.
+ * @return bool False if the range is empty.
+ */
+inline auto pop_chunk(work_range &range, uint64_t &chunk) noexcept -> bool {
+  uint64_t packed = range.chunks.load(std::memory_order_relaxed);
+  for (;;) {
+    const uint64_t begin = packed >> 32U;
+    const uint64_t end = packed & 0xFFFFFFFFU;
+    if (begin >= end) {
+      return false;
+    }
+    if (range.chunks.compare_exchange_weak(packed, pack_range(begin + 1, end),
+                                           std::memory_order_relaxed)) {
+      chunk = begin;
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Steals the back half of another worker's range into an empty one.
+ *
+ * @param victim The range to steal from.
+ * @param thief The empty range of the stealing worker.
+ * @return bool False if the victim's range is empty.
+ */
+inline auto steal_chunks(work_range &victim, work_range &thief) noexcept
+    -> bool {
+  uint64_t packed = victim.chunks.load(std::memory_order_relaxed);
+  for (;;) {
+    const uint64_t begin = packed >> 32U;
+    const uint64_t end = packed & 0xFFFFFFFFU;
+    if (begin >= end) {
+      return false;
+    }
+    const uint64_t split = end - ((end - begin + 1) / 2);
+    if (victim.chunks.compare_exchange_weak(packed, pack_range(begin, split),
+                                            std::memory_order_relaxed)) {
+      thief.chunks.store(pack_range(split, end), std::memory_order_relaxed);
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Runs body(begin, end) over chunks of [0, count) on a set of
+ * workers with work stealing and returns the sum of the results.
+ *
+ * Each worker starts with an equal share of the chunks, takes chunks from the
+ * front of its own share and, once it runs dry, steals half of the remaining
+ * share of another worker. The caller is worker 0. If a thread cannot be
+ * started, the other workers steal its share.
+ *
+ * @param count The number of elements.
+ * @param options The thread count and chunk size.
+ * @param body Called as body(begin, end), returning the failures in the
+ * chunk.
+ * @return std::size_t The total number of failures.
+ */
+template <typename Body>
+auto parallel_chunks(std::size_t count, parallel_options options,
+                     const Body &body) -> std::size_t {
+  const std::size_t chunk_size =
+      options.chunk_size != 0 ? options.chunk_size : default_chunk_size;
+  const uint64_t chunks = (static_cast<uint64_t>(count) + chunk_size - 1) / chunk_size;
+  unsigned threads = options.threads != 0 ? options.threads
+                                          : std::thread::hardware_concurrency();
+  threads = threads == 0 ? 1 : threads;
+  if (static_cast<uint64_t>(threads) > chunks) {
+    threads = static_cast<unsigned>(chunks);
+  }
+  if (threads <= 1 || chunks > 0xFFFFFFFFU) {
+    std::size_t failures = 0;
+    for (std::size_t begin = 0; begin < count; begin += chunk_size) {
+      failures += body(begin, begin + chunk_size < count ? begin + chunk_size : count);
+    }
+    return failures;
+  }
+
+  std::vector<work_range> ranges(threads);
+  for (unsigned i = 0; i < threads; ++i) {
+    ranges[i].chunks.store(pack_range(chunks * i / threads, chunks * (i + 1) / threads),
+                           std::memory_order_relaxed);
+  }
+  const auto work = [&](unsigned self) {
+    work_range &own = ranges[self];
+    std::size_t failures = 0;
+    for (;;) {
+      uint64_t chunk = 0;
+      while (pop_chunk(own, chunk)) {
+        const std::size_t begin = static_cast<std::size_t>(chunk) * chunk_size;
+        failures += body(begin, begin + chunk_size < count ? begin + chunk_size : count);
+      }
+      bool stolen = false;
+      for (unsigned i = 1; i < threads && !stolen; ++i) {
+        stolen = steal_chunks(ranges[(self + i) % threads], own);
+      }
+      if (!stolen) {
+        break;
+      }
+    }
+    own.failures = failures;
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned i = 1; i < threads; ++i) {
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
+    try {
+      workers.emplace_back(work, i);
+    } catch (const std::system_error &) {
+      break;
+    }
+#else
+    workers.emplace_back(work, i);
+#endif
+  }
+  work(0);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  std::size_t failures = 0;
+  for (const auto &range : ranges) {
+    failures += range.failures;
+  }
+  return failures;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses a column of date and time strings on several threads.
+ *
+ * Gives the same results as parse_many(). The column is split into chunks
+ * of options.chunk_size elements which a set of workers, the calling thread
+ * among them, parse with work stealing; the call returns when every element
+ * is parsed.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The format string.
+ * @param input The strings to parse.
+ * @param count The number of strings.
+ * @param output The parsed time points, count elements. Elements whose
+ * parsing failed are left unchanged.
+ * @param errors The per-element error codes, count elements, or nullptr.
+ * @param options The thread count and chunk size.
+ * @return std::size_t The number of elements that failed to parse.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parallel_parse(string_view format, const string_view *input,
+                    std::size_t count, typename Clock::time_point *output,
+                    std::errc *errors = nullptr,
+                    parallel_options options = parallel_options{})
+    -> std::size_t {
+  return detail::parallel_chunks(
+      count, options, [&](std::size_t begin, std::size_t end) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return parse_many<Clock>(format, input + begin, end - begin,
+                                 output + begin,
+                                 errors != nullptr ? errors + begin : nullptr);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      });
+}
+
+/**
+ * @brief Parses a packed buffer of fixed-width date and time records on
+ * several threads.
+ *
+ * Gives the same results as the packed parse_many().
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The format string.
+ * @param records The packed records.
+ * @param stride The size of one record in bytes.
+ * @param count The number of records.
+ * @param output The parsed time points, count elements. Elements whose
+ * parsing failed are left unchanged.
+ * @param errors The per-record error codes, count elements, or nullptr.
+ * @param options The thread count and chunk size.
+ * @return std::size_t The number of records that failed to parse.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parallel_parse(string_view format, const char *records,
+                    std::size_t stride, std::size_t count,
+                    typename Clock::time_point *output,
+                    std::errc *errors = nullptr,
+                    parallel_options options = parallel_options{})
+    -> std::size_t {
+  return detail::parallel_chunks(
+      count, options, [&](std::size_t begin, std::size_t end) {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return parse_many<Clock>(format, records + (begin * stride), stride,
+                                 end - begin, output + begin,
+                                 errors != nullptr ? errors + begin : nullptr);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      });
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_PARALLEL_HPP
@@ -34,23 +34,148 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <ctime>
+#include <limits>
 #include <ratio>
-#include <stdexcept>
+#include <system_error>
 #include <type_traits>
 
+// Without exception support, e.g. -fno-exceptions, the overloads that throw
+// std::system_error are left out; every other overload reports errors
+// through its return value.
+#if !defined(CHRONO_PARSE_NO_EXCEPTIONS) &&                                   \
+    !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) ||                   \
+      defined(_CPPUNWIND))
+#define CHRONO_PARSE_NO_EXCEPTIONS
+#endif
+
 // NOLINTBEGIN(modernize-concat-nested-namespaces)
 namespace mgutility {
 namespace chrono {
-namespace detail {
 // NOLINTEND(modernize-concat-nested-namespaces)
 
+/**
+ * @brief The stage of parsing that failed.
+ */
+enum class parse_stage : uint8_t {
+  none,      ///< Parsing succeeded.
+  format,    ///< The format string is invalid.
+  field,     ///< A field did not match its specifier.
+  separator, ///< A separator did not match the format.
+  conversion ///< The fields do not form a representable time point.
+};
+
+/**
+ * @brief The outcome of parsing with diagnostics: where parsing stopped and
+ * why. Trivially copyable and small enough to be returned in registers.
+ */
+struct parse_result {
+  std::errc error;    ///< An error code indicating success or failure.
+  uint32_t position;  ///< Offset in the input where parsing stopped.
+  char specifier;     ///< The specifier that failed, e.g. 'd', or '\0'.
+  parse_stage stage;  ///< The stage that failed.
+
+  /**
+   * @brief Returns true if parsing succeeded.
+   */
+  constexpr auto ok() const noexcept -> bool { return error == std::errc{}; }
+};
+
+/**
+ * @brief Tag selecting the parse() overloads that return a parse_result.
+ */
+struct diagnostics_t {
+  explicit diagnostics_t() = default;
+};
+
+/**
+ * @brief Tag value selecting the parse() overloads that return a
+ * parse_result, e.g. parse(time_point, format, date_str, diagnostics).
+ */
+constexpr diagnostics_t diagnostics{};
+
+/**
+ * @brief The default instrumentation policy of parse() and get_time(). Its
+ * hooks are empty and compile away.
+ *
+ * A policy is a class with three static hooks:
+ * - start() returns a timestamp that is passed back to the other hooks;
+ * - field(specifier, error, start) runs after each specifier is parsed;
+ * - conversion(error, start) runs after the fields become a time point.
+ *
+ * mgutility/chrono/instrument.hpp has policies that count calls and
+ * failures and record cycle histograms.
+ */
+struct no_instrumentation {
+  static MGUTILITY_CNSTXPR auto start() noexcept -> uint64_t { return 0; }
+  static MGUTILITY_CNSTXPR void field(char /*specifier*/, std::errc /*error*/,
+                                      uint64_t /*start*/) noexcept {}
+  static MGUTILITY_CNSTXPR void conversion(std::errc /*error*/,
+                                           uint64_t /*start*/) noexcept {}
+};
+
+/**
+ * @brief Customization point mapping durations since 1970-01-01 00:00:00 UTC
+ * to the time points of a clock.
+ *
+ * The primary template takes the epoch of Clock to be 1970-01-01 UTC, as it
+ * is for std::chrono::system_clock. Clocks that are not tied to the calendar,
+ * such as std::chrono::steady_clock, get time points whose time_since_epoch()
+ * is the time since 1970-01-01 UTC. A clock with another epoch specializes
+ * it, e.g. for a clock counting from 2000-01-01:
+ *
+ * @code
+ * template <> struct mgutility::chrono::clock_traits<y2k_clock> {
+ *   static auto from_unix(y2k_clock::duration since_epoch)
+ *       -> y2k_clock::time_point {
+ *     return y2k_clock::time_point{since_epoch - std::chrono::seconds{946684800}};
+ *   }
+ * };
+ * @endcode
+ *
+ * @tparam Clock The clock type.
+ */
+template <typename Clock> struct clock_traits {
+  /**
+   * @brief Converts a duration since 1970-01-01 UTC to a time point.
+   *
+   * @param since_epoch The duration since 1970-01-01 UTC.
+   * @return typename Clock::time_point The time point.
+   */
+  static MGUTILITY_CNSTXPR auto from_unix(
+      typename Clock::duration since_epoch) noexcept
+      -> typename Clock::time_point {
+    return typename Clock::time_point{since_epoch};
+  }
+};
+
+namespace detail {
+
 /**
  * @brief Extended tm structure with milliseconds.
  */
 struct tm : std::tm {
-  uint32_t tm_ms; ///< Milliseconds.
+  // Zero-initializes std::tm, whose own default constructor is not
+  // constexpr, so parsing works in C++14 constant expressions
+  constexpr tm() noexcept
+      : std::tm{}, tm_ms{}, tm_zone_name{}, tm_has_offset{}, tm_offset{},
+        tm_iso_year{}, tm_iso_week{}, tm_derive{} {}
+
+  uint32_t tm_ms;                     ///< Milliseconds.
+  mgutility::string_view tm_zone_name; ///< Time zone name parsed by %Z.
+  bool tm_has_offset;                 ///< A numeric offset was parsed by %z.
+  int32_t tm_offset;                  ///< The %z offset in seconds east of UTC.
+  int32_t tm_iso_year;                ///< ISO 8601 week-based year (%G).
+  int32_t tm_iso_week;                ///< ISO 8601 week of the year (%V).
+  uint8_t tm_derive;                  ///< derive_* flags, see derive_date().
 };
 
+constexpr uint8_t derive_yday = 1;     ///< Derive the date from %j.
+constexpr uint8_t derive_iso_week = 2; ///< Derive the date from %V.
+constexpr uint8_t has_iso_year = 4;    ///< %G gave the week-based year.
+constexpr uint8_t has_weekday = 8;     ///< %u, %a or %A gave the weekday.
+constexpr uint8_t has_year = 16;       ///< %Y or %y gave the year.
+
 /**
  * @brief Parses an integer from a string view.
  *
@@ -58,18 +183,29 @@ struct tm : std::tm {
  * @param len The length of the string view.
  * @param next The position of the next character to parse.
  * @param begin_offset The offset to begin parsing from.
- * @return int32_t The parsed integer.
- * @throws std::invalid_argument if the value is not convertible.
+ * @return std::errc invalid_argument if the value is not convertible.
  */
 template <typename T>
 MGUTILITY_CNSTXPR auto parse_integer(T &result, mgutility::string_view str,
                                      uint32_t len, uint32_t &next,
                                      uint32_t begin_offset = 0) -> std::errc {
-  auto error = mgutility::from_chars(str.data() + next + begin_offset,
-                                     str.data() + len + next, result);
+  // Never read past the end of the view, e.g. into the next line of a log
+  if (static_cast<std::size_t>(next) + len > str.size()) {
+    next += ++len;
+    return std::errc::invalid_argument;
+  }
+  const char *const first = str.data() + next + begin_offset;
+  const char *const last = str.data() + len + next;
+  auto error = mgutility::from_chars(first, last, result);
 
   next += ++len;
 
+  // Every character of the field must be a digit, e.g. "2023" but not
+  // "-023" or "20 3"
+  if (error.ec == std::errc{} &&
+      (error.ptr != last || !mgutility::detail::is_digit(*first))) {
+    return std::errc::invalid_argument;
+  }
   return error.ec;
 }
 
@@ -95,7 +231,7 @@ template <typename T> constexpr auto pow(T base, T exp) noexcept -> T {
  * @param value The value to check.
  * @param min The minimum acceptable value.
  * @param max The maximum acceptable value.
- * @throws std::out_of_range if the value is out of range.
+ * @return std::errc result_out_of_range if the value is out of range.
  */
 template <typename T>
 MGUTILITY_CNSTXPR auto check_range(const T &value, const T &min, const T &max)
@@ -139,14 +275,67 @@ auto MGUTILITY_CNSTXPR days_in_month(int32_t year, int32_t month) -> int32_t {
 }
 
 /**
- * @brief Converts a tm structure to a time_t value.
+ * @brief Returns floor(value / divisor) for a positive divisor.
+ */
+constexpr auto floor_div(int64_t value, int64_t divisor) noexcept -> int64_t {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+/**
+ * @brief Returns the number of days since 1970-01-01 of a civil date in the
+ * proleptic Gregorian calendar.
+ *
+ * Runs in constant time for any year, including years before 1970.
  *
- * @param tm The tm structure to convert.
- * @return std::time_t The corresponding time_t value.
- * @throws std::out_of_range if any tm value is out of valid range.
+ * @param year The year, e.g. 2023.
+ * @param month The month [1, 12].
+ * @param day The day of the month [1, 31].
+ * @return int32_t The number of days since the epoch, negative before it.
  */
-MGUTILITY_CNSTXPR auto mktime(std::time_t &result, std::tm &time_struct)
-    -> std::errc {
+MGUTILITY_CNSTXPR auto days_from_civil(int32_t year, uint32_t month,
+                                       uint32_t day) noexcept -> int32_t {
+  year -= static_cast<int32_t>(month <= 2);
+  const int32_t era = (year >= 0 ? year : year - 399) / 400;
+  const auto yoe = static_cast<uint32_t>(year - (era * 400)); // [0, 399]
+  const uint32_t doy =
+      ((153 * (month > 2 ? month - 3 : month + 9) + 2) / 5) + day - 1; // [0, 365]
+  const uint32_t doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+  return (era * 146097) + static_cast<int32_t>(doe) - 719468;
+}
+
+/**
+ * @brief Returns the civil date of a number of days since 1970-01-01 in the
+ * proleptic Gregorian calendar. The inverse of days_from_civil().
+ *
+ * @param days The number of days since the epoch, negative before it.
+ * @param year The year.
+ * @param month The month [1, 12].
+ * @param day The day of the month [1, 31].
+ */
+MGUTILITY_CNSTXPR void civil_from_days(int32_t days, int32_t &year,
+                                       uint32_t &month,
+                                       uint32_t &day) noexcept {
+  days += 719468;
+  const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto doe = static_cast<uint32_t>(days - (era * 146097)); // [0, 146096]
+  const uint32_t yoe =
+      (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365; // [0, 399]
+  const uint32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100)); // [0, 365]
+  const uint32_t month_from_march = ((5 * doy) + 2) / 153; // [0, 11]
+  day = doy - (((153 * month_from_march) + 2) / 5) + 1;
+  month = month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+  year = static_cast<int32_t>(yoe) + (era * 400) + static_cast<int32_t>(month <= 2);
+}
+
+/**
+ * @brief Converts a tm structure to seconds since 1970-01-01 00:00:00 UTC.
+ *
+ * @param result The seconds since the epoch.
+ * @param time_struct The tm structure to convert.
+ * @return std::errc result_out_of_range if any tm value is out of range.
+ */
+MGUTILITY_CNSTXPR auto epoch_seconds(int64_t &result,
+                                     const std::tm &time_struct) -> std::errc {
   result = 0;
 
   // Check for out of range values in tm structure
@@ -156,173 +345,437 @@ MGUTILITY_CNSTXPR auto mktime(std::time_t &result, std::tm &time_struct)
     return std::errc::result_out_of_range;
   }
 
-  time_struct.tm_year += 1900;
+  const int32_t year = time_struct.tm_year + 1900;
 
-  if (days_in_month(time_struct.tm_year, time_struct.tm_mon) <
-      time_struct.tm_mday) {
+  if (days_in_month(year, time_struct.tm_mon) < time_struct.tm_mday) {
     return std::errc::result_out_of_range;
   }
 
-  // Calculate the number of days since 1970
-  for (auto i{1970}; i < time_struct.tm_year; ++i) {
-    result += is_leap_year(i) ? 366 : 365;
+  const int64_t days =
+      days_from_civil(year, static_cast<uint32_t>(time_struct.tm_mon) + 1,
+                      static_cast<uint32_t>(time_struct.tm_mday));
+
+  result = (days * 86400) + (time_struct.tm_hour * 3600) +
+           (time_struct.tm_min * 60) + time_struct.tm_sec;
+
+  return std::errc{};
+}
+
+/**
+ * @brief Converts a tm structure to a time_t value.
+ *
+ * @param result The corresponding time_t value.
+ * @param time_struct The tm structure to convert.
+ * @return std::errc result_out_of_range if any tm value is out of range or
+ * the time does not fit in time_t.
+ */
+MGUTILITY_CNSTXPR auto mktime(std::time_t &result, const std::tm &time_struct)
+    -> std::errc {
+  int64_t seconds = 0;
+  result = 0;
+  const auto error = epoch_seconds(seconds, time_struct);
+  if (error != std::errc{}) {
+    return error;
+  }
+  if (static_cast<int64_t>(static_cast<std::time_t>(seconds)) != seconds) {
+    return std::errc::result_out_of_range;
   }
+  result = static_cast<std::time_t>(seconds);
+  return std::errc{};
+}
 
-  // Add the days for the current year
-  for (auto i{0}; i < time_struct.tm_mon; ++i) {
-    // NOLINTNEXTLINE
-    result += days_in_month(time_struct.tm_year, i);
+/**
+ * @brief Converts a time since the epoch to a count of Period, rounding
+ * toward negative infinity.
+ *
+ * @tparam Period A period that is a whole multiple or a whole fraction of a
+ * second, e.g. std::micro or std::ratio<60>.
+ * @param seconds Whole seconds since the epoch.
+ * @param nanoseconds The fractional second in nanoseconds.
+ * @param count The count of Period since the epoch.
+ * @return std::errc result_out_of_range if the count does not fit in int64_t.
+ */
+template <typename Period>
+MGUTILITY_CNSTXPR auto epoch_count(int64_t seconds, uint32_t nanoseconds,
+                                   int64_t &count) noexcept -> std::errc {
+  static_assert(Period::num == 1 || Period::den == 1,
+                "the period must be a multiple or a fraction of a second");
+  if (Period::den == 1) {
+    count = floor_div(seconds, Period::num);
+    return std::errc{};
+  }
+  constexpr int64_t ticks = Period::den;
+  const int64_t fraction =
+      std::chrono::duration_cast<std::chrono::duration<int64_t, Period>>(
+          std::chrono::nanoseconds{nanoseconds})
+          .count();
+  if (seconds > (std::numeric_limits<int64_t>::max)() / ticks ||
+      seconds < (std::numeric_limits<int64_t>::min)() / ticks ||
+      seconds * ticks > (std::numeric_limits<int64_t>::max)() - fraction) {
+    return std::errc::result_out_of_range;
   }
+  count = (seconds * ticks) + fraction;
+  return std::errc{};
+}
 
-  result += time_struct.tm_mday - 1; // nth day since 1970
-  result *= 24;
-  result += time_struct.tm_hour;
-  result *= 60;
-  result += time_struct.tm_min;
-  result *= 60;
-  result += time_struct.tm_sec;
+/**
+ * @brief Checks whether a count fits in the representation of a duration.
+ *
+ * @tparam Rep The representation, integral or floating-point.
+ * @param count The count.
+ * @return bool True if the count is representable.
+ */
+template <typename Rep>
+constexpr auto fits_rep(int64_t count) noexcept -> bool {
+  return std::is_floating_point<Rep>::value ||
+         (static_cast<int64_t>(static_cast<Rep>(count)) == count &&
+          (count >= 0 || std::is_signed<Rep>::value));
+}
 
+/**
+ * @brief Builds a time point of a clock from a count of its ticks since
+ * 1970-01-01 UTC, through clock_traits.
+ *
+ * @tparam Clock The clock type.
+ * @param time_point The time point to populate.
+ * @param count The count of Clock::period since the epoch.
+ * @return std::errc result_out_of_range if the count does not fit in
+ * Clock::rep.
+ */
+template <typename Clock>
+MGUTILITY_CNSTXPR auto from_epoch_count(typename Clock::time_point &time_point,
+                                        int64_t count) noexcept -> std::errc {
+  using rep = typename Clock::rep;
+  if (!fits_rep<rep>(count)) {
+    return std::errc::result_out_of_range;
+  }
+  time_point = clock_traits<Clock>::from_unix(
+      typename Clock::duration{static_cast<rep>(count)});
   return std::errc{};
 }
 
 /**
- * @brief Adjusts the tm structure for a given timezone offset.
+ * @brief Returns TAI - UTC in seconds on a day, in constant time: the day
+ * indexes a table with one entry per half-year, as leap seconds have only
+ * ended June and December. Before 1972 it is 10, and after the last leap
+ * second in the table, at the end of 2016, it stays 37.
+ *
+ * @param days The number of days since the epoch, negative before it.
+ * @return int32_t TAI - UTC in seconds.
+ */
+MGUTILITY_CNSTXPR auto tai_minus_utc(int32_t days) noexcept -> int32_t {
+  // NOLINTNEXTLINE
+  constexpr uint8_t table[] = {
+      10, 11, 12, 12, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19,
+      19, 20, 20, 21, 21, 22, 22, 22, 22, 23, 23, 23, 23, 23, 24, 24, 24, 24,
+      25, 25, 26, 26, 26, 27, 27, 28, 28, 29, 29, 29, 30, 30, 30, 31, 31, 31,
+      32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 32, 33, 33, 33, 33,
+      33, 33, 34, 34, 34, 34, 34, 34, 34, 35, 35, 35, 35, 35, 35, 36, 36, 36,
+      37};
+  constexpr int32_t size = sizeof(table);
+  int32_t year = 0;
+  uint32_t month = 0;
+  uint32_t day = 0;
+  civil_from_days(days, year, month, day);
+  const int32_t index = ((year - 1972) * 2) + (month > 6 ? 1 : 0);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+  return index < 0 ? 10 : table[index < size ? index : size - 1];
+}
+
+/**
+ * @brief Checks that a second parsed as 60 is a leap second, i.e. the last
+ * second of a UTC day that ended with one.
  *
- * @param tm The tm structure to adjust.
- * @param offset The timezone offset in hours and minutes.
+ * @param time_struct The parsed tm structure.
+ * @param utc_seconds Its seconds since the epoch in UTC, in which 23:59:60
+ * counts as the following midnight.
+ * @return std::errc result_out_of_range for any other second 60.
  */
-MGUTILITY_CNSTXPR auto handle_timezone(tm &time_struct, int32_t offset)
+MGUTILITY_CNSTXPR auto check_leap_second(const std::tm &time_struct,
+                                         int64_t utc_seconds) noexcept
     -> std::errc {
-  // Validate offset: HHMM format, minutes 0-59, hours 0-23
-  const int32_t abs_offset = abs(offset);
-  const int32_t minutes = abs_offset % 100;
-  const int32_t hours = abs_offset / 100;
-  if (minutes > 59 || hours > 23) {
-    return std::errc::invalid_argument;
+  if (time_struct.tm_sec != 60) {
+    return std::errc{};
+  }
+  const int64_t days = floor_div(utc_seconds, 86400);
+  if (utc_seconds != days * 86400 ||
+      tai_minus_utc(static_cast<int32_t>(days)) ==
+          tai_minus_utc(static_cast<int32_t>(days - 1))) {
+    return std::errc::result_out_of_range;
   }
+  return std::errc{};
+}
 
-  // Validate input tm structure (basic checks)
-  if (time_struct.tm_mon < 0 || time_struct.tm_mon > 11 ||
-      time_struct.tm_mday < 1 || time_struct.tm_year < 0) {
-    return std::errc::invalid_argument;
+/**
+ * @brief Builds a time point of a clock from a count of its ticks since
+ * 1970-01-01 UTC in which a leap second counts as the following second.
+ *
+ * The leap second is placed one second after 23:59:59 on the clock's own
+ * timeline, so for std::chrono::system_clock it is the following midnight,
+ * as with POSIX mktime(), while a clock that counts leap seconds, such as
+ * tai_clock, keeps it apart.
+ *
+ * @tparam Clock The clock type.
+ * @param time_point The time point to populate.
+ * @param count The count of Clock::period since the epoch.
+ * @param leap_second True if the count is that of a leap second.
+ * @return std::errc result_out_of_range if the count does not fit in
+ * Clock::rep.
+ */
+template <typename Clock>
+auto from_utc_count(typename Clock::time_point &time_point, int64_t count,
+                    bool leap_second) -> std::errc {
+  if (!leap_second) {
+    return from_epoch_count<Clock>(time_point, count);
   }
+  const auto second = std::chrono::duration_cast<typename Clock::duration>(
+      std::chrono::seconds{1});
+  const auto error = from_epoch_count<Clock>(
+      time_point, count - static_cast<int64_t>(second.count()));
+  if (error == std::errc{}) {
+    time_point += second;
+  }
+  return error;
+}
 
-  // Apply offset (positive or negative)
-  const int32_t total_minutes =
-      time_struct.tm_min + (offset >= 0 ? minutes : -minutes);
-  const int32_t total_hours =
-      time_struct.tm_hour + (offset >= 0 ? hours : -hours);
-
-  // Normalize minutes (-59 to 119 -> 0-59 with hour carry)
-  time_struct.tm_min = total_minutes % 60;
-  int minute_carry = total_minutes / 60;
-  if (total_minutes < 0 && total_minutes % 60 != 0) {
-    minute_carry -= 1;
-    time_struct.tm_min += 60;
-  }
-
-  // Normalize hours (-23 to 47 -> 0-23 with day carry)
-  time_struct.tm_hour = (total_hours + minute_carry) % 24;
-  int day_carry = (total_hours + minute_carry) / 24;
-  if (total_hours + minute_carry < 0 &&
-      (total_hours + minute_carry) % 24 != 0) {
-    day_carry -= 1;
-    time_struct.tm_hour += 24;
-  }
-
-  // Normalize days, months, and years
-  int days = time_struct.tm_mday + day_carry;
-  int months = time_struct.tm_mon;
-  int years = time_struct.tm_year;
-
-  // Handle negative days
-  while (days <= 0) {
-    months -= 1;
-    if (months < 0) {
-      months += 12;
-      years -= 1;
-      if (years < 0) {
-        return std::errc::result_out_of_range; // Year underflow
-      }
+/**
+ * @brief Returns the weekday of a number of days since 1970-01-01.
+ *
+ * @param days The number of days since the epoch, negative before it.
+ * @return int32_t The weekday [0, 6], 0 meaning Sunday.
+ */
+constexpr auto weekday_from_days(int32_t days) noexcept -> int32_t {
+  return ((days % 7) + 11) % 7;
+}
+
+/**
+ * @brief Returns the days since 1970-01-01 of the Monday starting week 1 of
+ * an ISO 8601 week-based year, the week that holds January 4th.
+ *
+ * @param year The week-based year.
+ * @return int32_t The number of days since the epoch.
+ */
+MGUTILITY_CNSTXPR auto iso_week_start(int32_t year) noexcept -> int32_t {
+  const int32_t january4 = days_from_civil(year, 1, 4);
+  return january4 - ((weekday_from_days(january4) + 6) % 7);
+}
+
+/**
+ * @brief Derives the month and day from a day of the year (%j) or from an
+ * ISO 8601 week date (%G, %V and %u), once the year and weekday are known.
+ * A week date takes precedence over a day of the year.
+ *
+ * @param result The tm structure to complete.
+ * @return std::errc result_out_of_range if the day or the week does not
+ * exist in its year.
+ */
+MGUTILITY_CNSTXPR auto derive_date(tm &result) noexcept -> std::errc {
+  int32_t days = 0;
+  if ((result.tm_derive & derive_iso_week) != 0) {
+    const int32_t year = (result.tm_derive & has_iso_year) != 0
+                             ? result.tm_iso_year
+                             : result.tm_year + 1900;
+    const int32_t start = iso_week_start(year);
+    if (result.tm_iso_week > (iso_week_start(year + 1) - start) / 7) {
+      return std::errc::result_out_of_range;
     }
-    days += days_in_month(years, months);
-  }
-
-  // Handle day overflow
-  while (days > days_in_month(years, months)) {
-    days -= days_in_month(years, months);
-    months += 1;
-    if (months > 11) {
-      months -= 12;
-      years += 1;
-      if (years > 9999 - 1900) { // Avoid overflow (arbitrary limit)
-        return std::errc::result_out_of_range;
-      }
+    // Monday unless %u, %a or %A named the day
+    const int32_t weekday = (result.tm_derive & has_weekday) != 0
+                                ? (result.tm_wday + 6) % 7
+                                : 0;
+    days = start + ((result.tm_iso_week - 1) * 7) + weekday;
+  } else if ((result.tm_derive & derive_yday) != 0) {
+    const int32_t year = result.tm_year + 1900;
+    if (result.tm_yday >= (is_leap_year(year) ? 366 : 365)) {
+      return std::errc::result_out_of_range;
     }
+    days = days_from_civil(year, 1, 1) + result.tm_yday;
+  } else {
+    return std::errc{};
+  }
+  int32_t year = 0;
+  uint32_t month = 0;
+  uint32_t day = 0;
+  civil_from_days(days, year, month, day);
+  result.tm_year = year - 1900;
+  result.tm_mon = static_cast<int32_t>(month) - 1;
+  result.tm_mday = static_cast<int32_t>(day);
+  result.tm_derive =
+      static_cast<uint8_t>(result.tm_derive & ~(derive_yday | derive_iso_week));
+  return std::errc{};
+}
+
+/**
+ * @brief Returns the last valid day of the parsed month. Before the year is
+ * known, e.g. in "%m/%d/%Y", February has 29 days; the conversion rejects
+ * February 29 of a common year.
+ *
+ * @param result The parsed fields.
+ * @return int32_t The last day of the month.
+ */
+MGUTILITY_CNSTXPR auto last_day(const detail::tm &result) noexcept -> int32_t {
+  return days_in_month(
+      (result.tm_derive & has_year) != 0 ? result.tm_year + 1900 : 2000,
+      result.tm_mon);
+}
+
+/**
+ * @brief Stores the value of a numeric field, checks its range and records
+ * what it implies for finish_fields(). Every parser of digits, whether it
+ * walks the format, reads at fixed offsets or is fed byte by byte, ends
+ * here.
+ *
+ * @tparam Specifier The specifier of the field, e.g. 'Y' or 'e'.
+ * @param result The tm structure to populate.
+ * @param value The digits of the field.
+ * @return std::errc result_out_of_range if the value is out of range, or
+ * invalid_argument if the specifier is not a numeric field.
+ */
+template <char Specifier>
+MGUTILITY_CNSTXPR auto store_field(detail::tm &result, int32_t value) noexcept
+    -> std::errc {
+  switch (Specifier) {
+  case 'Y':
+    result.tm_year = value - 1900;
+    result.tm_derive |= has_year;
+    return std::errc{};
+  case 'm':
+    // Checked with the date once the year is known
+    result.tm_mon = value - 1;
+    return std::errc{};
+  case 'd':
+  case 'e':
+    result.tm_mday = value;
+    return check_range(value, 1, last_day(result));
+  case 'H':
+    result.tm_hour = value;
+    return check_range(value, 0, 23);
+  case 'M':
+    result.tm_min = value;
+    return check_range(value, 0, 59);
+  case 'S':
+    // 60 is a leap second, checked once the date and offset are known
+    result.tm_sec = value;
+    return check_range(value, 0, 60);
+  case 'y':
+    // As in POSIX, 69-99 are 1969-1999 and 00-68 are 2000-2068
+    result.tm_year = value < 69 ? value + 100 : value;
+    result.tm_derive |= has_year;
+    return std::errc{};
+  case 'j':
+    result.tm_yday = value - 1;
+    result.tm_derive |= derive_yday;
+    return check_range(value, 1, 366);
+  case 'I':
+    result.tm_hour = value;
+    return check_range(value, 1, 12);
+  case 'G':
+    result.tm_iso_year = value;
+    result.tm_derive |= has_iso_year;
+    return std::errc{};
+  case 'V':
+    result.tm_iso_week = value;
+    result.tm_derive |= derive_iso_week;
+    return check_range(value, 1, 53);
+  case 'u':
+    result.tm_wday = value % 7;
+    result.tm_derive |= has_weekday;
+    return check_range(value, 1, 7);
+  default:
+    return std::errc::invalid_argument;
   }
+}
 
-  // Update tm structure
-  time_struct.tm_mday = days;
-  time_struct.tm_mon = months;
-  time_struct.tm_year = years;
+/**
+ * @brief Stores the value of a numeric field whose specifier is only known
+ * at run time, see store_field<Specifier>().
+ */
+MGUTILITY_CNSTXPR auto store_field(detail::tm &result, char specifier,
+                                   int32_t value) noexcept -> std::errc {
+  switch (specifier) {
+  case 'Y':
+    return store_field<'Y'>(result, value);
+  case 'm':
+    return store_field<'m'>(result, value);
+  case 'd':
+    return store_field<'d'>(result, value);
+  case 'e':
+    return store_field<'e'>(result, value);
+  case 'H':
+    return store_field<'H'>(result, value);
+  case 'M':
+    return store_field<'M'>(result, value);
+  case 'S':
+    return store_field<'S'>(result, value);
+  case 'y':
+    return store_field<'y'>(result, value);
+  case 'j':
+    return store_field<'j'>(result, value);
+  case 'I':
+    return store_field<'I'>(result, value);
+  case 'G':
+    return store_field<'G'>(result, value);
+  case 'V':
+    return store_field<'V'>(result, value);
+  case 'u':
+    return store_field<'u'>(result, value);
+  default:
+    return std::errc::invalid_argument;
+  }
+}
 
-  return std::errc{};
+/**
+ * @brief Parses a numeric field of exactly width digits.
+ *
+ * @tparam Specifier The specifier of the field, see store_field().
+ * @param result The tm structure to populate.
+ * @param date_str The date string.
+ * @param width The number of digits.
+ * @param next The position of the field, advanced past it and the
+ * character after it.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <char Specifier>
+MGUTILITY_CNSTXPR auto parse_number(detail::tm &result, string_view date_str,
+                                    uint32_t width, uint32_t &next)
+    -> std::errc {
+  int32_t value = 0;
+  const auto error = parse_integer(value, date_str, width, next);
+  if (error != std::errc{}) {
+    return error;
+  }
+  return store_field<Specifier>(result, value);
 }
 
 // Free parsing functions
 MGUTILITY_CNSTXPR auto parse_year(detail::tm &result, string_view date_str,
                                   uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_year, date_str, 4, next);
-  result.tm_year %= 1900;
-  return error;
+  return parse_number<'Y'>(result, date_str, 4, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_month(detail::tm &result, string_view date_str,
                                    uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_mon, date_str, 2, next);
-  result.tm_mon -= 1;
-  return error;
+  return parse_number<'m'>(result, date_str, 2, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_day(detail::tm &result, string_view date_str,
                                  uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_mday, date_str, 2, next);
-  if (error != std::errc{}) {
-    return error;
-  }
-  error = check_range(result.tm_mday, 1,
-                      days_in_month(result.tm_year, result.tm_mon));
-  return error;
+  return parse_number<'d'>(result, date_str, 2, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_hour(detail::tm &result, string_view date_str,
                                   uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_hour, date_str, 2, next);
-  if (error != std::errc{}) {
-    return error;
-  }
-  error = check_range(result.tm_hour, 0, 23);
-  return error;
+  return parse_number<'H'>(result, date_str, 2, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_minute(detail::tm &result, string_view date_str,
                                     uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_min, date_str, 2, next);
-  if (error != std::errc{}) {
-    return error;
-  }
-  error = check_range(result.tm_min, 0, 59);
-  return error;
+  return parse_number<'M'>(result, date_str, 2, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_second(detail::tm &result, string_view date_str,
                                     uint32_t &next) -> std::errc {
-  auto error = parse_integer(result.tm_sec, date_str, 2, next);
-  if (error != std::errc{}) {
-    return error;
-  }
-  error = check_range(result.tm_sec, 0, 59);
-  return error;
+  return parse_number<'S'>(result, date_str, 2, next);
 }
 
 MGUTILITY_CNSTXPR auto parse_fraction(detail::tm &result, string_view date_str,
@@ -341,14 +794,29 @@ MGUTILITY_CNSTXPR auto parse_fraction(detail::tm &result, string_view date_str,
   return error;
 }
 
+/**
+ * @brief Parses a UTC offset: Z, +hh, +hhmm, +hh:mm, +hhmmss or +hh:mm:ss,
+ * up to 14 hours either way.
+ *
+ * The offset is only recorded; it is subtracted from the local time as a
+ * number of seconds once the date is converted, so it never has to carry
+ * through the civil fields.
+ *
+ * @param result The tm structure to populate.
+ * @param date_str The date string containing the offset.
+ * @param next The position of the next character to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
 MGUTILITY_CNSTXPR auto parse_timezone_offset(detail::tm &result,
                                              string_view date_str,
                                              uint32_t &next) -> std::errc {
-  std::errc error{};
+  result.tm_has_offset = true;
+  result.tm_offset = 0;
   // NOLINTNEXTLINE [bugprone-inc-dec-in-conditions]
   if (next < date_str.size() && date_str[next] == 'Z') {
-    error = handle_timezone(result, 0);
-    return error;
+    // Skips the character after it like any other field
+    next += 2;
+    return std::errc{};
   }
 
   if (next >= date_str.size() ||
@@ -357,33 +825,84 @@ MGUTILITY_CNSTXPR auto parse_timezone_offset(detail::tm &result,
   }
 
   const char sign = date_str[next++];
-  int32_t hour = 0;
-  int32_t minute = 0;
-
-  error = parse_integer(hour, date_str, 2, next);
-  if (error != std::errc{}) {
-    return error;
+  int32_t parts[3] = {}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  bool extended = false;
+  uint32_t count = 0;
+  while (count < 3) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    const auto error = parse_integer(parts[count], date_str, 2, next);
+    if (error != std::errc{}) {
+      return error;
+    }
+    --next;
+    ++count;
+    // The separator of the first pair decides between +hhmm and +hh:mm
+    const bool colon = next + 1 < date_str.size() && date_str[next] == ':' &&
+                       mgutility::detail::is_digit(date_str[next + 1]);
+    extended = count == 1 ? colon : extended;
+    // A colon after the seconds belongs to the rest of the format
+    if (count == 3 || (extended ? !colon
+                                : next >= date_str.size() ||
+                                      !mgutility::detail::is_digit(
+                                          date_str[next]))) {
+      break;
+    }
+    next += extended ? 1 : 0;
   }
+  ++next;
 
-  --next;
-
-  if (next < date_str.size() && date_str[next] == ':') {
-    ++next;
+  if (parts[1] > 59 || parts[2] > 59) {
+    return std::errc::invalid_argument;
   }
-
-  error = parse_integer(minute, date_str, 2, next);
+  const int32_t offset = (parts[0] * 3600) + (parts[1] * 60) + parts[2];
+  const auto error = check_range(offset, 0, 14 * 3600);
   if (error != std::errc{}) {
     return error;
   }
+  result.tm_offset = sign == '+' ? offset : -offset;
+  return std::errc{};
+}
 
-  const int32_t offset = (hour * 100) + minute;
-  error = check_range(offset, 0, 1200);
-  if (error != std::errc{}) {
-    return error;
+/**
+ * @brief Parses a time zone name or abbreviation, e.g. Europe/Istanbul or CET.
+ *
+ * The name is only recorded here; it is resolved to an offset once the whole
+ * local time is known.
+ *
+ * @param result The tm structure to populate.
+ * @param date_str The date string containing the zone name.
+ * @param next The position of the next character to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+MGUTILITY_CNSTXPR auto parse_zone_name(detail::tm &result, string_view date_str,
+                                       uint32_t &next) -> std::errc {
+  uint32_t size = 0;
+  while (next + size < date_str.size()) {
+    const char chr = date_str[next + size];
+    if (!((chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z') ||
+          mgutility::detail::is_digit(chr) || chr == '/' || chr == '_' ||
+          chr == '+' || chr == '-')) {
+      break;
+    }
+    ++size;
+  }
+  if (size == 0) {
+    return std::errc::invalid_argument;
   }
+  result.tm_zone_name = date_str.substr(next, size);
+  next += size + 1;
+  return std::errc{};
+}
 
-  error = handle_timezone(result, sign == '+' ? -offset : offset);
-  return error;
+/**
+ * @brief Checks if a zone name denotes UTC, which needs no zone database.
+ *
+ * @param name The zone name parsed by %Z.
+ * @return bool True for UTC, GMT, Z, Etc/UTC and Etc/GMT.
+ */
+MGUTILITY_CNSTXPR auto is_utc_zone_name(string_view name) noexcept -> bool {
+  return name == "UTC" || name == "GMT" || name == "Z" || name == "Etc/UTC" ||
+         name == "Etc/GMT";
 }
 
 /**
@@ -417,112 +936,854 @@ MGUTILITY_CNSTXPR auto parse_am_pm(detail::tm &result, string_view date_str,
 }
 
 /**
- * @brief Parses a date and time string according to a specified format.
+ * @brief Parses a number of at most max_digits digits that may be padded
+ * with one leading space, e.g. " 3", "3" or "03" for %e.
  *
- * @param format The format string.
- * @param date_str The date and time string to parse.
- * @return detail::tm The parsed time structure.
- * @throws std::invalid_argument if the format string is invalid or parsing
- * fails.
+ * @param result The parsed number.
+ * @param date_str The date string to parse.
+ * @param max_digits The maximum number of digits.
+ * @param next The position of the next character to parse.
+ * @return std::errc invalid_argument if there is no digit.
  */
-MGUTILITY_CNSTXPR auto get_time(detail::tm &result, string_view format,
-                                string_view date_str) -> std::errc {
-  const std::size_t begin = format.find('{');
-  const std::size_t end = format.find('}');
-  if (begin == string_view::npos || end == string_view::npos || begin >= end) {
-    return std::errc::invalid_argument;
+MGUTILITY_CNSTXPR auto parse_padded(int32_t &result, string_view date_str,
+                                    uint32_t max_digits, uint32_t &next)
+    -> std::errc {
+  if (next < date_str.size() && date_str[next] == ' ') {
+    ++next;
   }
-
-  if (format[begin + 1] != ':' || (end - begin < 3)) {
+  uint32_t digits = 0;
+  while (digits < max_digits && next + digits < date_str.size() &&
+         mgutility::detail::is_digit(date_str[next + digits])) {
+    ++digits;
+  }
+  if (digits == 0) {
     return std::errc::invalid_argument;
   }
+  return parse_integer(result, date_str, digits, next);
+}
 
-  uint32_t next = 0;
-  bool is_specifier = false;
-  std::errc error{};
-
-  for (std::size_t i = begin; i < end; ++i) {
-    switch (format[i]) {
-    case '%': {
-      if (i + 1 >= format.size()) {
-        return std::errc::invalid_argument;
-      }
-
-      if (is_specifier) {
-        --next;
-      }
-
-      switch (format[i + 1]) {
-      case 'Y':
-        error = parse_year(result, date_str, next);
-        break;
-      case 'm':
-        error = parse_month(result, date_str, next);
-        break;
-      case 'd':
-        error = parse_day(result, date_str, next);
-        break;
-      case 'F': {
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_year(result, date_str, next);
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_month(result, date_str, next);
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_day(result, date_str, next);
-      } break;
-      case 'H':
-        error = parse_hour(result, date_str, next);
-        break;
-      case 'M':
-        error = parse_minute(result, date_str, next);
-        break;
-      case 'S':
-        error = parse_second(result, date_str, next);
-        break;
-      case 'T': {
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_hour(result, date_str, next);
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_minute(result, date_str, next);
-        // NOLINTNEXTLINE(clang-analyzer-deadcode.DeadStores)
-        error = parse_second(result, date_str, next);
-      } break;
-      case 'f':
-        error = parse_fraction(result, date_str, next);
-        break;
-      case 'z':
-        error = parse_timezone_offset(result, date_str, next);
-        break;
-      case 'p':
-        error = parse_am_pm(result, date_str, next);
-        break;
-      default:
-        return std::errc::invalid_argument;
-      }
-      if (error != std::errc{}) {
-        return error;
-      }
-      ++i;
-      is_specifier = true;
-    }
-      continue;
-    case ' ': // Space separator
-    case '-': // Dash separator
-    case '/': // Slash separator
-    case '.': // Dot separator
-    case ':': // Colon separator
-    case 'T': // 'T' separator
-      if (i > 1 && format[i] != date_str[next - 1]) {
-        return std::errc::invalid_argument;
-      }
-      break;
-    }
-    is_specifier = false;
+MGUTILITY_CNSTXPR auto parse_padded_day(detail::tm &result,
+                                        string_view date_str, uint32_t &next)
+    -> std::errc {
+  int32_t day = 0;
+  const auto error = parse_padded(day, date_str, 2, next);
+  if (error != std::errc{}) {
+    return error;
   }
+  return store_field<'e'>(result, day);
+}
 
-  return std::errc{};
+MGUTILITY_CNSTXPR auto parse_short_year(detail::tm &result,
+                                        string_view date_str, uint32_t &next)
+    -> std::errc {
+  return parse_number<'y'>(result, date_str, 2, next);
 }
 
+MGUTILITY_CNSTXPR auto parse_day_of_year(detail::tm &result,
+                                         string_view date_str, uint32_t &next)
+    -> std::errc {
+  return parse_number<'j'>(result, date_str, 3, next);
+}
+
+MGUTILITY_CNSTXPR auto parse_hour12(detail::tm &result, string_view date_str,
+                                    uint32_t &next) -> std::errc {
+  return parse_number<'I'>(result, date_str, 2, next);
+}
+
+MGUTILITY_CNSTXPR auto parse_iso_year(detail::tm &result, string_view date_str,
+                                      uint32_t &next) -> std::errc {
+  return parse_number<'G'>(result, date_str, 4, next);
+}
+
+MGUTILITY_CNSTXPR auto parse_iso_week(detail::tm &result, string_view date_str,
+                                      uint32_t &next) -> std::errc {
+  return parse_number<'V'>(result, date_str, 2, next);
+}
+
+MGUTILITY_CNSTXPR auto parse_iso_weekday(detail::tm &result,
+                                         string_view date_str, uint32_t &next)
+    -> std::errc {
+  return parse_number<'u'>(result, date_str, 1, next);
+}
+
+/**
+ * @brief Sets the date and time fields from seconds since 1970-01-01
+ * 00:00:00 UTC.
+ *
+ * @param result The tm structure to populate.
+ * @param seconds The seconds since the epoch.
+ * @return std::errc result_out_of_range if the year is outside [0, 9999].
+ */
+MGUTILITY_CNSTXPR auto fields_from_seconds(detail::tm &result,
+                                           int64_t seconds) noexcept
+    -> std::errc {
+  const int64_t days = floor_div(seconds, 86400);
+  // days_from_civil(0, 1, 1) and days_from_civil(10000, 1, 1), the years %Y
+  // reads
+  if (days < -719528 || days >= 2932897) {
+    return std::errc::result_out_of_range;
+  }
+  const int64_t second_of_day = seconds - (days * 86400);
+  int32_t year = 0;
+  uint32_t month = 0;
+  uint32_t day = 0;
+  civil_from_days(static_cast<int32_t>(days), year, month, day);
+  result.tm_year = year - 1900;
+  result.tm_mon = static_cast<int32_t>(month) - 1;
+  result.tm_mday = static_cast<int32_t>(day);
+  result.tm_hour = static_cast<int32_t>(second_of_day / 3600);
+  result.tm_min = static_cast<int32_t>(second_of_day / 60 % 60);
+  result.tm_sec = static_cast<int32_t>(second_of_day % 60);
+  return std::errc{};
+}
+
+/**
+ * @brief Parses seconds since 1970-01-01 00:00:00 UTC (%s), optionally
+ * negative, into the date and time fields.
+ *
+ * @param result The tm structure to populate.
+ * @param date_str The date string to parse.
+ * @param next The position of the next character to parse.
+ * @return std::errc result_out_of_range if the year is outside [0, 9999].
+ */
+MGUTILITY_CNSTXPR auto parse_epoch_seconds(detail::tm &result,
+                                           string_view date_str,
+                                           uint32_t &next) -> std::errc {
+  const uint32_t sign =
+      next < date_str.size() && date_str[next] == '-' ? 1 : 0;
+  uint32_t size = sign;
+  while (size < sign + 19 && next + size < date_str.size() &&
+         mgutility::detail::is_digit(date_str[next + size])) {
+    ++size;
+  }
+  if (size == sign) {
+    return std::errc::invalid_argument;
+  }
+  int64_t seconds = 0;
+  next += sign;
+  const auto error = parse_integer(seconds, date_str, size - sign, next);
+  if (error != std::errc{}) {
+    return error;
+  }
+  return fields_from_seconds(result, sign != 0 ? -seconds : seconds);
+}
+
+/**
+ * @brief Packs three characters, lowercased if they are letters, into a key
+ * for matching month and weekday names with one comparison.
+ */
+constexpr auto pack_name(char first, char second, char third) noexcept
+    -> uint32_t {
+  return ((static_cast<uint32_t>(static_cast<unsigned char>(first)) | 0x20U)
+          << 16U) |
+         ((static_cast<uint32_t>(static_cast<unsigned char>(second)) | 0x20U)
+          << 8U) |
+         (static_cast<uint32_t>(static_cast<unsigned char>(third)) | 0x20U);
+}
+
+/**
+ * @brief Returns the month [0, 11] abbreviated by a key from pack_name(), or
+ * -1.
+ */
+MGUTILITY_CNSTXPR auto month_from_name(uint32_t key) noexcept -> int32_t {
+  switch (key) {
+  case pack_name('j', 'a', 'n'): return 0;
+  case pack_name('f', 'e', 'b'): return 1;
+  case pack_name('m', 'a', 'r'): return 2;
+  case pack_name('a', 'p', 'r'): return 3;
+  case pack_name('m', 'a', 'y'): return 4;
+  case pack_name('j', 'u', 'n'): return 5;
+  case pack_name('j', 'u', 'l'): return 6;
+  case pack_name('a', 'u', 'g'): return 7;
+  case pack_name('s', 'e', 'p'): return 8;
+  case pack_name('o', 'c', 't'): return 9;
+  case pack_name('n', 'o', 'v'): return 10;
+  case pack_name('d', 'e', 'c'): return 11;
+  default: return -1;
+  }
+}
+
+/**
+ * @brief Returns the weekday [0, 6], 0 meaning Sunday, abbreviated by a key
+ * from pack_name(), or -1.
+ */
+MGUTILITY_CNSTXPR auto weekday_from_name(uint32_t key) noexcept -> int32_t {
+  switch (key) {
+  case pack_name('s', 'u', 'n'): return 0;
+  case pack_name('m', 'o', 'n'): return 1;
+  case pack_name('t', 'u', 'e'): return 2;
+  case pack_name('w', 'e', 'd'): return 3;
+  case pack_name('t', 'h', 'u'): return 4;
+  case pack_name('f', 'r', 'i'): return 5;
+  case pack_name('s', 'a', 't'): return 6;
+  default: return -1;
+  }
+}
+
+/**
+ * @brief Returns the lowercase full name of a month [0, 11].
+ */
+MGUTILITY_CNSTXPR auto full_month_name(int32_t month) noexcept
+    -> string_view {
+  switch (month) {
+  case 0: return "january";
+  case 1: return "february";
+  case 2: return "march";
+  case 3: return "april";
+  case 4: return "may";
+  case 5: return "june";
+  case 6: return "july";
+  case 7: return "august";
+  case 8: return "september";
+  case 9: return "october";
+  case 10: return "november";
+  default: return "december";
+  }
+}
+
+/**
+ * @brief Returns the lowercase full name of a weekday [0, 6].
+ */
+MGUTILITY_CNSTXPR auto full_weekday_name(int32_t weekday) noexcept
+    -> string_view {
+  switch (weekday) {
+  case 0: return "sunday";
+  case 1: return "monday";
+  case 2: return "tuesday";
+  case 3: return "wednesday";
+  case 4: return "thursday";
+  case 5: return "friday";
+  default: return "saturday";
+  }
+}
+
+/**
+ * @brief Parses a month or weekday name: its three-letter abbreviation is
+ * looked up with one packed comparison, and for a full name the remaining
+ * letters are compared. Case is ignored.
+ *
+ * @param result The index of the name.
+ * @param date_str The date string to parse.
+ * @param next The position of the next character to parse.
+ * @param weekday True for weekday names, false for month names.
+ * @param full True to require the full name.
+ * @return std::errc invalid_argument if no name matches.
+ */
+MGUTILITY_CNSTXPR auto parse_name(int32_t &result, string_view date_str,
+                                  uint32_t &next, bool weekday, bool full)
+    -> std::errc {
+  if (static_cast<std::size_t>(next) + 3 > date_str.size()) {
+    return std::errc::invalid_argument;
+  }
+  const uint32_t key =
+      pack_name(date_str[next], date_str[next + 1], date_str[next + 2]);
+  const int32_t index =
+      weekday ? weekday_from_name(key) : month_from_name(key);
+  if (index < 0) {
+    return std::errc::invalid_argument;
+  }
+  uint32_t size = 3;
+  if (full) {
+    const string_view name =
+        weekday ? full_weekday_name(index) : full_month_name(index);
+    if (next + name.size() > date_str.size()) {
+      return std::errc::invalid_argument;
+    }
+    for (; size < name.size(); ++size) {
+      if (static_cast<char>(date_str[next + size] | 0x20) != name[size]) {
+        return std::errc::invalid_argument;
+      }
+    }
+  }
+  result = index;
+  next += size + 1;
+  return std::errc{};
+}
+
+MGUTILITY_CNSTXPR auto parse_month_name(detail::tm &result,
+                                        string_view date_str, uint32_t &next,
+                                        bool full) -> std::errc {
+  return parse_name(result.tm_mon, date_str, next, false, full);
+}
+
+MGUTILITY_CNSTXPR auto parse_weekday_name(detail::tm &result,
+                                          string_view date_str, uint32_t &next,
+                                          bool full) -> std::errc {
+  const auto error = parse_name(result.tm_wday, date_str, next, true, full);
+  if (error == std::errc{}) {
+    result.tm_derive |= has_weekday;
+  }
+  return error;
+}
+
+/**
+ * @brief Checks if a character names a supported format specifier.
+ *
+ * @param chr The character following '%'.
+ * @return bool True if the specifier is supported, false otherwise.
+ */
+constexpr auto is_specifier(char chr) noexcept -> bool {
+  return chr == 'Y' || chr == 'm' || chr == 'd' || chr == 'F' || chr == 'H' ||
+         chr == 'M' || chr == 'S' || chr == 'T' || chr == 'f' || chr == 'z' ||
+         chr == 'Z' || chr == 'p' || chr == 'j' || chr == 'y' || chr == 'b' ||
+         chr == 'B' || chr == 'a' || chr == 'A' || chr == 'e' || chr == 'I' ||
+         chr == 's' || chr == 'G' || chr == 'V' || chr == 'u';
+}
+
+/**
+ * @brief Parses the field or fields named by a format specifier. On failure
+ * next is left at the start of the field that failed, so diagnostics point
+ * at the offending characters.
+ *
+ * @param result The tm structure to populate.
+ * @param specifier The specifier character following '%'.
+ * @param date_str The date string to parse.
+ * @param next The position of the next character to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+MGUTILITY_CNSTXPR auto parse_specifier(detail::tm &result, char specifier,
+                                       string_view date_str, uint32_t &next)
+    -> std::errc {
+  uint32_t start = next;
+  std::errc error{};
+  switch (specifier) {
+  case 'Y':
+    error = parse_year(result, date_str, next);
+    break;
+  case 'm':
+    error = parse_month(result, date_str, next);
+    break;
+  case 'd':
+    error = parse_day(result, date_str, next);
+    break;
+  case 'F':
+    error = parse_year(result, date_str, next);
+    if (error != std::errc{}) {
+      break;
+    }
+    start = next;
+    error = parse_month(result, date_str, next);
+    if (error != std::errc{}) {
+      break;
+    }
+    start = next;
+    error = parse_day(result, date_str, next);
+    break;
+  case 'H':
+    error = parse_hour(result, date_str, next);
+    break;
+  case 'M':
+    error = parse_minute(result, date_str, next);
+    break;
+  case 'S':
+    error = parse_second(result, date_str, next);
+    break;
+  case 'T':
+    error = parse_hour(result, date_str, next);
+    if (error != std::errc{}) {
+      break;
+    }
+    start = next;
+    error = parse_minute(result, date_str, next);
+    if (error != std::errc{}) {
+      break;
+    }
+    start = next;
+    error = parse_second(result, date_str, next);
+    break;
+  case 'f':
+    error = parse_fraction(result, date_str, next);
+    break;
+  case 'z':
+    error = parse_timezone_offset(result, date_str, next);
+    break;
+  case 'Z':
+    error = parse_zone_name(result, date_str, next);
+    break;
+  case 'p':
+    error = parse_am_pm(result, date_str, next);
+    break;
+  case 'j':
+    error = parse_day_of_year(result, date_str, next);
+    break;
+  case 'y':
+    error = parse_short_year(result, date_str, next);
+    break;
+  case 'b':
+  case 'B':
+    error = parse_month_name(result, date_str, next, specifier == 'B');
+    break;
+  case 'a':
+  case 'A':
+    error = parse_weekday_name(result, date_str, next, specifier == 'A');
+    break;
+  case 'e':
+    error = parse_padded_day(result, date_str, next);
+    break;
+  case 'I':
+    error = parse_hour12(result, date_str, next);
+    break;
+  case 's':
+    error = parse_epoch_seconds(result, date_str, next);
+    break;
+  case 'G':
+    error = parse_iso_year(result, date_str, next);
+    break;
+  case 'V':
+    error = parse_iso_week(result, date_str, next);
+    break;
+  case 'u':
+    error = parse_iso_weekday(result, date_str, next);
+    break;
+  default:
+    error = std::errc::invalid_argument;
+    break;
+  }
+  if (error != std::errc{}) {
+    next = start;
+  }
+  return error;
+}
+
+/**
+ * @brief Builds the parse_result of a failed specifier.
+ *
+ * @param error The error returned by parse_specifier().
+ * @param specifier The specifier that failed.
+ * @param next The start of the field that failed.
+ * @return parse_result The diagnostics.
+ */
+constexpr auto field_error(std::errc error, char specifier,
+                           uint32_t next) noexcept -> parse_result {
+  return parse_result{error, next, specifier,
+                      is_specifier(specifier) ? parse_stage::field
+                                              : parse_stage::format};
+}
+
+/**
+ * @brief Matches a literal character of a format. Each field skips the
+ * character that follows it, so the first literal after a field must be
+ * that character; any other literal consumes the next character.
+ *
+ * @param literal The literal character.
+ * @param after_field True if the literal directly follows a field.
+ * @param date_str The date and time string to parse.
+ * @param next The position of the next character to parse, advanced past a
+ * consumed literal.
+ * @return bool True if the literal matches.
+ */
+MGUTILITY_CNSTXPR auto match_literal(char literal, bool after_field,
+                                     string_view date_str, uint32_t &next)
+    -> bool {
+  if (after_field) {
+    return next != 0 && next <= date_str.size() &&
+           date_str[next - 1] == literal;
+  }
+  if (next >= date_str.size() || date_str[next] != literal) {
+    return false;
+  }
+  ++next;
+  return true;
+}
+
+/**
+ * @brief Builds the parse_result of a literal that did not match.
+ *
+ * @param after_field True if the literal directly follows a field.
+ * @param next The position of the next character to parse.
+ * @return parse_result The diagnostics.
+ */
+constexpr auto literal_error(bool after_field, uint32_t next) noexcept
+    -> parse_result {
+  return parse_result{std::errc::invalid_argument,
+                      after_field && next != 0 ? next - 1 : next, '\0',
+                      parse_stage::separator};
+}
+
+/**
+ * @brief Completes a successful parse once every field is read: derives the
+ * date from %j or an ISO week date, checks a weekday against a date that
+ * has a year and clamps the end position to the input.
+ *
+ * @param result The parsed tm structure.
+ * @param date_str The date and time string parsed.
+ * @param next The position after the last field.
+ * @return parse_result The diagnostics.
+ */
+MGUTILITY_CNSTXPR auto finish_fields(detail::tm &result, string_view date_str,
+                                     uint32_t next) noexcept -> parse_result {
+  const uint32_t position = next > date_str.size()
+                                ? static_cast<uint32_t>(date_str.size())
+                                : next;
+  // A week date is built from its weekday, so there is nothing to check
+  const bool week_date = (result.tm_derive & derive_iso_week) != 0;
+  if ((result.tm_derive & (derive_yday | derive_iso_week)) != 0) {
+    const char specifier = week_date ? 'V' : 'j';
+    const auto error = derive_date(result);
+    if (error != std::errc{}) {
+      return parse_result{error, position, specifier, parse_stage::conversion};
+    }
+  }
+  const int32_t year = result.tm_year + 1900;
+  // A day past the end of its month is rejected by the conversion instead
+  if (!week_date &&
+      (result.tm_derive & (has_weekday | has_year)) ==
+          (has_weekday | has_year) &&
+      result.tm_mday <= days_in_month(year, result.tm_mon) &&
+      weekday_from_days(days_from_civil(
+          year, static_cast<uint32_t>(result.tm_mon) + 1,
+          static_cast<uint32_t>(result.tm_mday))) != result.tm_wday) {
+    return parse_result{std::errc::invalid_argument, position, 'a',
+                        parse_stage::conversion};
+  }
+  return parse_result{std::errc{}, position, '\0', parse_stage::none};
+}
+
+/**
+ * @brief Parses a date and time string according to a specified format,
+ * reporting where and why parsing stopped.
+ *
+ * @tparam Policy The instrumentation policy.
+ * @param result The tm structure to populate.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The error code, the position and specifier of the
+ * failure, and the stage that failed.
+ */
+template <typename Policy = no_instrumentation>
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result, string_view format,
+                                string_view date_str, diagnostics_t)
+    -> parse_result {
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos || begin >= end ||
+      format[begin + 1] != ':' || (end - begin < 3)) {
+    return parse_result{std::errc::invalid_argument, 0, '\0',
+                        parse_stage::format};
+  }
+
+  uint32_t next = 0;
+  bool is_specifier = false;
+  std::errc error{};
+
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] != '%') {
+      if (!match_literal(format[i], is_specifier, date_str, next)) {
+        return literal_error(is_specifier, next);
+      }
+      is_specifier = false;
+      continue;
+    }
+    if (i + 1 >= end) {
+      return parse_result{std::errc::invalid_argument, next, '\0',
+                          parse_stage::format};
+    }
+
+    if (is_specifier) {
+      --next;
+    }
+
+    const uint64_t start = Policy::start();
+    error = parse_specifier(result, format[i + 1], date_str, next);
+    Policy::field(format[i + 1], error, start);
+    if (error != std::errc{}) {
+      return field_error(error, format[i + 1], next);
+    }
+    ++i;
+    is_specifier = true;
+  }
+
+  return finish_fields(result, date_str, next);
+}
+
+/**
+ * @brief Parses a date and time string according to a specified format.
+ *
+ * @param result The tm structure to populate.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result, string_view format,
+                                string_view date_str) -> std::errc {
+  return get_time(result, format, date_str, diagnostics_t{}).error;
+}
+
+/**
+ * @brief A single step of a compiled format: either a field or a literal
+ * character.
+ */
+struct format_op {
+  char specifier; ///< Field specifier (e.g. 'Y'), or '\0' for a literal.
+  char literal;   ///< Literal character, see match_literal().
+  bool rewind;    ///< Step back over the character skipped by the last field.
+  bool after_field; ///< The literal directly follows a field.
+};
+
+/**
+ * @brief Flattens a format string into a sequence of fields and literals.
+ *
+ * @param ops The output array, at least format.size() elements long.
+ * @param size The number of operations written.
+ * @param format The format string.
+ * @return std::errc An error code indicating success or failure.
+ */
+MGUTILITY_CNSTXPR auto compile_format(format_op *ops, uint32_t &size,
+                                      string_view format) -> std::errc {
+  size = 0;
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos || begin >= end) {
+    return std::errc::invalid_argument;
+  }
+
+  if (format[begin + 1] != ':' || (end - begin < 3)) {
+    return std::errc::invalid_argument;
+  }
+
+  bool rewind = false;
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    if (format[i] == '%') {
+      if (i + 1 >= end || !is_specifier(format[i + 1])) {
+        return std::errc::invalid_argument;
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      ops[size++] = format_op{format[++i], '\0', rewind, false};
+      rewind = true;
+      continue;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ops[size++] = format_op{'\0', format[i], false, rewind};
+    rewind = false;
+  }
+
+  return std::errc{};
+}
+
+/**
+ * @brief Called when a format string fails to compile. It is deliberately not
+ * constexpr, so reaching it during constant evaluation is a compile error.
+ */
+inline void invalid_format_string() noexcept {}
+
+} // namespace detail
+
+/**
+ * @brief A format string flattened into fields and literal characters.
+ *
+ * Created by mgutility::chrono::compile(). In C++14 and later a compiled
+ * format declared constexpr is validated at compile time.
+ *
+ * @tparam N The capacity in operations.
+ */
+template <std::size_t N> struct compiled_format {
+  detail::format_op ops[N]; ///< The operations to run, in order. NOLINT
+  uint32_t size;            ///< The number of operations in use.
+  std::errc error;          ///< The error found while compiling, if any.
+};
+
+/**
+ * @brief Compiles a format string into a compiled_format.
+ *
+ * @param format The format string, e.g. "{:%FT%T.%f%z}".
+ * @return compiled_format<N> The compiled format. An invalid format string
+ * is a compile error in constant expressions and is reported by parse()
+ * otherwise.
+ */
+template <std::size_t N>
+MGUTILITY_CNSTXPR auto compile(const char (&format)[N]) -> compiled_format<N> {
+  compiled_format<N> result{};
+  result.error = detail::compile_format(
+      static_cast<detail::format_op *>(result.ops), result.size,
+      string_view{static_cast<const char *>(format), N - 1});
+  if (result.error != std::errc{}) {
+    detail::invalid_format_string();
+  }
+  return result;
+}
+
+#if MGUTILITY_CPLUSPLUS > 201703L &&                                           \
+    ((defined(__cpp_nontype_template_args) &&                                  \
+      __cpp_nontype_template_args >= 201911L) ||                               \
+     (defined(__clang_major__) && __clang_major__ >= 12))
+#define MGUTILITY_CHRONO_HAS_FIXED_STRING
+namespace detail {
+/**
+ * @brief A string literal usable as a template argument.
+ *
+ * @tparam N The size of the literal including the terminating null.
+ */
+template <std::size_t N> struct fixed_string {
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  constexpr fixed_string(const char (&str)[N]) noexcept {
+    for (std::size_t i = 0; i < N; ++i) {
+      data[i] = str[i];
+    }
+  }
+  char data[N]{}; // NOLINT
+};
+} // namespace detail
+
+/**
+ * @brief Compiles a format string given as a template argument, e.g.
+ * compile<"{:%FT%T.%f%z}">(). An invalid format string is always a compile
+ * error.
+ *
+ * @tparam Format The format string.
+ * @return compiled_format<N> The compiled format.
+ */
+template <detail::fixed_string Format>
+constexpr auto compile() -> compiled_format<sizeof(Format.data)> {
+  constexpr auto result = compile(Format.data);
+  return result;
+}
+#endif
+
+namespace detail {
+/**
+ * @brief Runs a range of compiled operations, continuing from a position
+ * left by the operations before them.
+ *
+ * @tparam Policy The instrumentation policy.
+ * @param result The tm structure to populate.
+ * @param first The first operation to run.
+ * @param last One past the last operation to run.
+ * @param date_str The date and time string to parse.
+ * @param next The position of the next character to parse, advanced past
+ * the fields parsed.
+ * @return parse_result The error code, the position and specifier of the
+ * failure, and the stage that failed.
+ */
+template <typename Policy = no_instrumentation>
+MGUTILITY_CNSTXPR auto run_ops(detail::tm &result, const format_op *first,
+                               const format_op *last, string_view date_str,
+                               uint32_t &next) -> parse_result {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  for (; first != last; ++first) {
+    const format_op &operation = *first;
+    if (operation.specifier == '\0') {
+      if (!match_literal(operation.literal, operation.after_field, date_str,
+                         next)) {
+        return literal_error(operation.after_field, next);
+      }
+      continue;
+    }
+    if (operation.rewind) {
+      --next;
+    }
+    const uint64_t start = Policy::start();
+    const auto error =
+        parse_specifier(result, operation.specifier, date_str, next);
+    Policy::field(operation.specifier, error, start);
+    if (error != std::errc{}) {
+      return field_error(error, operation.specifier, next);
+    }
+  }
+  return parse_result{std::errc{}, next, '\0', parse_stage::none};
+}
+
+/**
+ * @brief Parses a date and time string according to a compiled format,
+ * reporting where and why parsing stopped.
+ *
+ * @tparam Policy The instrumentation policy.
+ * @param result The tm structure to populate.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The error code, the position and specifier of the
+ * failure, and the stage that failed.
+ */
+template <typename Policy = no_instrumentation, std::size_t N>
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result,
+                                const compiled_format<N> &format,
+                                string_view date_str, diagnostics_t)
+    -> parse_result {
+  if (format.error != std::errc{}) {
+    return parse_result{format.error, 0, '\0', parse_stage::format};
+  }
+
+  uint32_t next = 0;
+  const format_op *ops = static_cast<const format_op *>(format.ops);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto status =
+      run_ops<Policy>(result, ops, ops + format.size, date_str, next);
+  if (!status.ok()) {
+    return status;
+  }
+
+  return finish_fields(result, date_str, next);
+}
+
+/**
+ * @brief Parses a date and time string according to a compiled format.
+ *
+ * @param result The tm structure to populate.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <std::size_t N>
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result,
+                                const compiled_format<N> &format,
+                                string_view date_str) -> std::errc {
+  return get_time(result, format, date_str, diagnostics_t{}).error;
+}
+
+/**
+ * @brief Converts a parsed tm structure into a count of Period since
+ * 1970-01-01 UTC.
+ *
+ * Zone names parsed by %Z other than UTC need a zone database and are
+ * resolved by the overloads in mgutility/chrono/tz.hpp; here they fail with
+ * std::errc::not_supported unless %z also supplied a numeric offset.
+ *
+ * @tparam Period The period of the count.
+ * @param count The count of Period since the epoch.
+ * @param time_struct The parsed tm structure.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <typename Period>
+MGUTILITY_CNSTXPR auto to_epoch_count(int64_t &count,
+                                      const detail::tm &time_struct) noexcept
+    -> std::errc {
+  if (!time_struct.tm_has_offset && !time_struct.tm_zone_name.empty() &&
+      !is_utc_zone_name(time_struct.tm_zone_name)) {
+    return std::errc::not_supported;
+  }
+  int64_t seconds = 0;
+  const auto error = detail::epoch_seconds(seconds, time_struct);
+  if (error != std::errc{}) {
+    return error;
+  }
+  seconds -= time_struct.tm_offset;
+  const auto leap_error = check_leap_second(time_struct, seconds);
+  if (leap_error != std::errc{}) {
+    return leap_error;
+  }
+  return epoch_count<Period>(seconds, time_struct.tm_ms, count);
+}
+
+/**
+ * @brief Converts a parsed tm structure into a time point.
+ *
+ * @tparam Clock The clock type.
+ * @tparam Policy The instrumentation policy.
+ * @param time_point The time point to populate.
+ * @param time_struct The parsed tm structure.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <typename Clock, typename Policy = no_instrumentation>
+auto to_time_point(typename Clock::time_point &time_point,
+                   detail::tm &time_struct) -> std::errc {
+  const uint64_t start = Policy::start();
+  int64_t count = 0;
+  auto error = to_epoch_count<typename Clock::period>(count, time_struct);
+  if (error == std::errc{}) {
+    error = from_utc_count<Clock>(time_point, count, time_struct.tm_sec == 60);
+  }
+  Policy::conversion(error, start);
+  return error;
+}
 } // namespace detail
 
 /**
@@ -530,49 +1791,443 @@ MGUTILITY_CNSTXPR auto get_time(detail::tm &result, string_view format,
  * specified clock type.
  *
  * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
  * @param time_point The time point to populate.
  * @param format The format string.
  * @param date_str The date and time string to parse.
  * @return std::error_code An error code indicating success or failure.
  */
-template <typename Clock = std::chrono::system_clock>
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation>
 auto parse(typename Clock::time_point &time_point, string_view format,
            string_view date_str) -> std::error_code {
   detail::tm time_struct{};
-  auto error = detail::get_time(time_struct, format, date_str);
+  auto error = detail::get_time<Policy>(time_struct, format, date_str,
+                                        diagnostics_t{})
+                   .error;
   if (error != std::errc{}) {
     return std::make_error_code(error);
   }
-  std::time_t time_t{};
-  error = detail::mktime(time_t, time_struct);
+  error = detail::to_time_point<Clock, Policy>(time_point, time_struct);
+  return error != std::errc{} ? std::make_error_code(error)
+                              : std::error_code{};
+}
+
+/**
+ * @brief Parses a date and time string into a std::chrono::time_point of the
+ * specified clock type using a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
+ * @param time_point The time point to populate.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation, std::size_t N>
+auto parse(typename Clock::time_point &time_point,
+           const compiled_format<N> &format, string_view date_str)
+    -> std::error_code {
+  detail::tm time_struct{};
+  auto error = detail::get_time<Policy>(time_struct, format, date_str,
+                                        diagnostics_t{})
+                   .error;
   if (error != std::errc{}) {
     return std::make_error_code(error);
   }
-  time_point = std::chrono::time_point_cast<typename Clock::duration>(
-      Clock::from_time_t(time_t) + std::chrono::nanoseconds{time_struct.tm_ms});
-  return std::error_code{};
+  error = detail::to_time_point<Clock, Policy>(time_point, time_struct);
+  return error != std::errc{} ? std::make_error_code(error)
+                              : std::error_code{};
 }
 
+namespace detail {
+/**
+ * @brief Completes the diagnostics of a successful get_time() with the
+ * conversion to a time point.
+ *
+ * @tparam Clock The clock type.
+ * @tparam Policy The instrumentation policy.
+ * @param time_point The time point to populate.
+ * @param time_struct The parsed tm structure.
+ * @param result The diagnostics returned by get_time().
+ * @return parse_result The diagnostics of the whole parse.
+ */
+template <typename Clock, typename Policy = no_instrumentation>
+auto to_time_point(typename Clock::time_point &time_point,
+                   detail::tm &time_struct, parse_result result)
+    -> parse_result {
+  if (!result.ok()) {
+    return result;
+  }
+  result.error = to_time_point<Clock, Policy>(time_point, time_struct);
+  result.stage = result.ok() ? parse_stage::none : parse_stage::conversion;
+  return result;
+}
+} // namespace detail
+
+/**
+ * @brief Parses a date and time string into a std::chrono::time_point,
+ * reporting where and why parsing stopped on failure.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
+ * @param time_point The time point to populate.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The error code, the offset in date_str where parsing
+ * stopped, the specifier that failed and the stage that failed.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation>
+auto parse(typename Clock::time_point &time_point, string_view format,
+           string_view date_str, diagnostics_t) -> parse_result {
+  detail::tm time_struct{};
+  return detail::to_time_point<Clock, Policy>(
+      time_point, time_struct,
+      detail::get_time<Policy>(time_struct, format, date_str,
+                               diagnostics_t{}));
+}
+
+/**
+ * @brief Parses a date and time string into a std::chrono::time_point using
+ * a compiled format, reporting where and why parsing stopped on failure.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
+ * @param time_point The time point to populate.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The error code, the offset in date_str where parsing
+ * stopped, the specifier that failed and the stage that failed.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation, std::size_t N>
+auto parse(typename Clock::time_point &time_point,
+           const compiled_format<N> &format, string_view date_str,
+           diagnostics_t) -> parse_result {
+  detail::tm time_struct{};
+  return detail::to_time_point<Clock, Policy>(
+      time_point, time_struct,
+      detail::get_time<Policy>(time_struct, format, date_str,
+                               diagnostics_t{}));
+}
+
+namespace detail {
+/**
+ * @brief Parses a date and time string into a count of Period since
+ * 1970-01-01 UTC. Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count.
+ * @tparam Format The format type, string_view or a compiled_format.
+ * @param count The count of Period since the epoch.
+ * @param format The format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period, typename Format>
+MGUTILITY_CNSTXPR auto parse_epoch(int64_t &count, const Format &format,
+                                   string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  detail::tm time_struct{};
+  parse_result result =
+      detail::get_time(time_struct, format, date_str, diagnostics_t{});
+  if (!result.ok()) {
+    return result;
+  }
+  result.error = detail::to_epoch_count<Period>(count, time_struct);
+  result.stage = result.ok() ? parse_stage::none : parse_stage::conversion;
+  return result;
+}
+
+/**
+ * @brief Parses a date and time string into a duration since 1970-01-01 UTC.
+ * Usable in constant expressions from C++14.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period, typename Format>
+MGUTILITY_CNSTXPR auto parse_epoch(
+    std::chrono::duration<Rep, Period> &since_epoch, const Format &format,
+    string_view date_str, diagnostics_t) noexcept -> parse_result {
+  int64_t count = 0;
+  parse_result result =
+      parse_epoch<Period>(count, format, date_str, diagnostics_t{});
+  if (result.ok() && !fits_rep<Rep>(count)) {
+    result.error = std::errc::result_out_of_range;
+    result.stage = parse_stage::conversion;
+  }
+  if (result.ok()) {
+    since_epoch = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+  }
+  return result;
+}
+
+/**
+ * @brief Converts the result of a parse to a std::error_code.
+ */
+inline auto to_error_code(std::errc error) -> std::error_code {
+  return error != std::errc{} ? std::make_error_code(error)
+                              : std::error_code{};
+}
+
+/**
+ * @brief Reached when parse_constant() fails. It is not constexpr, so in a
+ * constant expression the failure is a compile error naming this function.
+ *
+ * @return Duration Duration::min().
+ */
+template <typename Duration>
+inline auto unparsable_timestamp() noexcept -> Duration {
+  return (Duration::min)();
+}
+} // namespace detail
+
+/**
+ * @brief Parses a date and time string straight into a count of Period since
+ * 1970-01-01 UTC, e.g. microseconds with Period = std::micro, without going
+ * through a time point.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure;
+ * std::errc::result_out_of_range if the count does not fit in int64_t.
+ */
+template <typename Period = std::ratio<1>>
+auto parse_epoch(int64_t &count, string_view format, string_view date_str)
+    -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_epoch<Period>(count, format, date_str, diagnostics_t{})
+          .error);
+}
+
+/**
+ * @brief Parses a date and time string straight into a count of Period since
+ * 1970-01-01 UTC using a compiled format.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Period = std::ratio<1>, std::size_t N>
+auto parse_epoch(int64_t &count, const compiled_format<N> &format,
+                 string_view date_str) -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_epoch<Period>(count, format, date_str, diagnostics_t{})
+          .error);
+}
+
+/**
+ * @brief Parses a date and time string into a duration since 1970-01-01 UTC,
+ * e.g. std::chrono::microseconds.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure;
+ * std::errc::result_out_of_range if the duration does not fit in Rep.
+ */
+template <typename Rep, typename Period>
+auto parse_epoch(std::chrono::duration<Rep, Period> &since_epoch,
+                 string_view format, string_view date_str) -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{})
+          .error);
+}
+
+/**
+ * @brief Parses a date and time string into a duration since 1970-01-01 UTC
+ * using a compiled format.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Rep, typename Period, std::size_t N>
+auto parse_epoch(std::chrono::duration<Rep, Period> &since_epoch,
+                 const compiled_format<N> &format, string_view date_str)
+    -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{})
+          .error);
+}
+
+/**
+ * @brief Parses a date and time string into a count of Period since
+ * 1970-01-01 UTC without exceptions or allocation, reporting where and why
+ * parsing stopped. Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period = std::ratio<1>>
+MGUTILITY_CNSTXPR auto parse_epoch(int64_t &count, string_view format,
+                                   string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  return detail::parse_epoch<Period>(count, format, date_str, diagnostics_t{});
+}
+
+/**
+ * @brief Parses a date and time string into a count of Period since
+ * 1970-01-01 UTC using a compiled format, reporting where and why parsing
+ * stopped. Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period = std::ratio<1>, std::size_t N>
+MGUTILITY_CNSTXPR auto parse_epoch(int64_t &count,
+                                   const compiled_format<N> &format,
+                                   string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  return detail::parse_epoch<Period>(count, format, date_str, diagnostics_t{});
+}
+
+/**
+ * @brief Parses a date and time string into a duration since 1970-01-01 UTC,
+ * reporting where and why parsing stopped. Usable in constant expressions
+ * from C++14.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto parse_epoch(
+    std::chrono::duration<Rep, Period> &since_epoch, string_view format,
+    string_view date_str, diagnostics_t) noexcept -> parse_result {
+  return detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{});
+}
+
+/**
+ * @brief Parses a date and time string into a duration since 1970-01-01 UTC
+ * using a compiled format, reporting where and why parsing stopped. Usable in
+ * constant expressions from C++14.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period, std::size_t N>
+MGUTILITY_CNSTXPR auto parse_epoch(
+    std::chrono::duration<Rep, Period> &since_epoch,
+    const compiled_format<N> &format, string_view date_str,
+    diagnostics_t) noexcept -> parse_result {
+  return detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{});
+}
+
+/**
+ * @brief Parses a timestamp known when compiling, e.g. a default in a
+ * configuration or a test fixture, into a duration since 1970-01-01 UTC.
+ *
+ * In a constant expression (C++14 and later) a timestamp that does not parse
+ * is a compile error naming detail::unparsable_timestamp; at run time it
+ * yields Duration::min().
+ *
+ * @code
+ * constexpr auto start = mgutility::chrono::parse_constant<std::chrono::seconds>(
+ *     mgutility::chrono::compile("{:%FT%T}"), "2023-04-30T16:22:18");
+ * @endcode
+ *
+ * @tparam Duration The duration type (defaults to std::chrono::seconds).
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @return Duration The duration since the epoch.
+ */
+template <typename Duration = std::chrono::seconds, std::size_t N>
+MGUTILITY_CNSTXPR auto parse_constant(const compiled_format<N> &format,
+                                      string_view date_str) noexcept
+    -> Duration {
+  Duration since_epoch{};
+  return detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{})
+                 .ok()
+             ? since_epoch
+             : detail::unparsable_timestamp<Duration>();
+}
+
+/**
+ * @brief Parses a timestamp known when compiling into a duration since
+ * 1970-01-01 UTC; see the compiled format overload.
+ *
+ * @tparam Duration The duration type (defaults to std::chrono::seconds).
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return Duration The duration since the epoch.
+ */
+template <typename Duration = std::chrono::seconds>
+MGUTILITY_CNSTXPR auto parse_constant(string_view format,
+                                      string_view date_str) noexcept
+    -> Duration {
+  Duration since_epoch{};
+  return detail::parse_epoch(since_epoch, format, date_str, diagnostics_t{})
+                 .ok()
+             ? since_epoch
+             : detail::unparsable_timestamp<Duration>();
+}
+
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
 /**
  * @brief Parses a date and time string into a std::chrono::time_point of the
  * specified clock type.
  *
  * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
  * @param format The format string.
  * @param date_str The date and time string to parse.
  * @throw std::system_error if parsing fails
  * @return Clock::time_point The parsed time point.
  */
-template <typename Clock = std::chrono::system_clock>
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation>
 auto parse(string_view format, string_view date_str) ->
     typename Clock::time_point {
   typename Clock::time_point time_point{};
-  auto error = parse<Clock>(time_point, format, date_str);
+  auto error = parse<Clock, Policy>(time_point, format, date_str);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return time_point;
+}
+
+/**
+ * @brief Parses a date and time string into a std::chrono::time_point of the
+ * specified clock type using a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Policy The instrumentation policy (defaults to none).
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @throw std::system_error if parsing fails
+ * @return Clock::time_point The parsed time point.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Policy = no_instrumentation, std::size_t N>
+auto parse(const compiled_format<N> &format, string_view date_str) ->
+    typename Clock::time_point {
+  typename Clock::time_point time_point{};
+  auto error = parse<Clock, Policy>(time_point, format, date_str);
   if (error) {
     throw std::system_error(error);
   }
   return time_point;
 }
+#endif // CHRONO_PARSE_NO_EXCEPTIONS
 
 } // namespace chrono
 } // namespace mgutility
@@ -0,0 +1,404 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_PARSE_MANY_HPP
+#define MGUTILITY_CHRONO_PARSE_MANY_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Fixed-width ISO 8601 layouts that have a dedicated batch kernel.
+ */
+enum class iso_layout : uint8_t {
+  none,           ///< Any other format, parsed by get_time.
+  date_time,      ///< {:%FT%T}
+  fraction,       ///< {:%FT%T.%f}
+  offset,         ///< {:%FT%T%z}
+  fraction_offset ///< {:%FT%T.%f%z}
+};
+
+/**
+ * @brief Detects whether a format string is one of the fixed-width ISO 8601
+ * layouts.
+ *
+ * @param format The format string.
+ * @return iso_layout The detected layout, or iso_layout::none.
+ */
+MGUTILITY_CNSTXPR auto detect_iso_layout(string_view format) noexcept
+    -> iso_layout {
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos || begin >= end) {
+    return iso_layout::none;
+  }
+  const string_view body = format.substr(begin, end - begin + 1);
+  if (body == "{:%FT%T}") {
+    return iso_layout::date_time;
+  }
+  if (body == "{:%FT%T.%f}") {
+    return iso_layout::fraction;
+  }
+  if (body == "{:%FT%T%z}") {
+    return iso_layout::offset;
+  }
+  if (body == "{:%FT%T.%f%z}") {
+    return iso_layout::fraction_offset;
+  }
+  return iso_layout::none;
+}
+
+/**
+ * @brief Broken-down fields of a YYYY-MM-DDTHH:MM:SS prefix.
+ */
+struct iso_fields {
+  uint32_t year;   ///< Year.
+  uint32_t month;  ///< Month [1, 12].
+  uint32_t day;    ///< Day of the month.
+  uint32_t hour;   ///< Hour.
+  uint32_t minute; ///< Minute.
+  uint32_t second; ///< Second.
+};
+
+/**
+ * @brief Converts two ASCII digits to their value.
+ *
+ * @param str Pointer to the first digit.
+ * @param value The parsed value.
+ * @return bool False if either character is not a digit.
+ */
+inline auto parse_two_digits(const char *str, uint32_t &value) noexcept
+    -> bool {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto tens = static_cast<uint32_t>(static_cast<unsigned char>(str[0]) - '0');
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto ones = static_cast<uint32_t>(static_cast<unsigned char>(str[1]) - '0');
+  value = (tens * 10) + ones;
+  return tens <= 9 && ones <= 9;
+}
+
+#if defined(__SSSE3__)
+/**
+ * @brief Parses a 19 character YYYY-MM-DDTHH:MM:SS prefix with SSSE3.
+ *
+ * Validates all digits and the '-', 'T' and ':' separators with two 16 byte
+ * loads, and converts digit pairs with a single multiply-add.
+ *
+ * @param str Pointer to at least 19 readable characters.
+ * @param fields The parsed fields.
+ * @return bool False if the prefix does not match the layout.
+ */
+inline auto parse_iso_prefix(const char *str, iso_fields &fields) noexcept
+    -> bool {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-type-reinterpret-cast)
+  const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str));
+  const __m128i high =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + 3));
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,cppcoreguidelines-pro-type-reinterpret-cast)
+
+  // Separators at 4, 7, 10, 13 of the low half and at 16 (13 of the high half)
+  const __m128i separators = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0,
+                                           'T', 0, 0, ':', 0, 0);
+  const int low_mask =
+      _mm_movemask_epi8(_mm_cmpeq_epi8(low, separators)) & 0x2490;
+  const int high_mask =
+      _mm_movemask_epi8(_mm_cmpeq_epi8(high, separators)) & 0x2000;
+  if (low_mask != 0x2490 || high_mask != 0x2000) {
+    return false;
+  }
+
+  // Gather the 14 digits into [YY YY MM DD hh mm ss] pairs
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i low_digits = _mm_shuffle_epi8(
+      _mm_sub_epi8(low, zero),
+      _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1));
+  const __m128i high_digits = _mm_shuffle_epi8(
+      _mm_sub_epi8(high, zero),
+      _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 14, 15,
+                    -1, -1));
+  const __m128i digits = _mm_or_si128(low_digits, high_digits);
+
+  // Every lane must be in [0, 9] when read as unsigned
+  const __m128i nine = _mm_set1_epi8(9);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) !=
+      0xFFFF) {
+    return false;
+  }
+
+  alignas(16) uint16_t pairs[8]; // NOLINT
+  _mm_store_si128(
+      reinterpret_cast<__m128i *>(pairs), // NOLINT
+      _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10,
+                                              1, 10, 1, 10, 1, 10, 1)));
+
+  fields.year = (pairs[0] * 100U) + pairs[1];
+  fields.month = pairs[2];
+  fields.day = pairs[3];
+  fields.hour = pairs[4];
+  fields.minute = pairs[5];
+  fields.second = pairs[6];
+  return true;
+}
+#else
+/**
+ * @brief Parses a 19 character YYYY-MM-DDTHH:MM:SS prefix.
+ *
+ * @param str Pointer to at least 19 readable characters.
+ * @param fields The parsed fields.
+ * @return bool False if the prefix does not match the layout.
+ */
+inline auto parse_iso_prefix(const char *str, iso_fields &fields) noexcept
+    -> bool {
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  uint32_t century = 0;
+  uint32_t year = 0;
+  const bool valid =
+      parse_two_digits(str, century) & parse_two_digits(str + 2, year) &
+      parse_two_digits(str + 5, fields.month) &
+      parse_two_digits(str + 8, fields.day) &
+      parse_two_digits(str + 11, fields.hour) &
+      parse_two_digits(str + 14, fields.minute) &
+      parse_two_digits(str + 17, fields.second) & (str[4] == '-') &
+      (str[7] == '-') & (str[10] == 'T') & (str[13] == ':') & (str[16] == ':');
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  fields.year = (century * 100) + year;
+  return valid;
+}
+#endif
+
+/**
+ * @brief Parses a fixed-width ISO 8601 string with a dedicated kernel.
+ *
+ * Accepts only inputs that get_time() would parse to the same instant, so a
+ * false return means the input must go through the generic parser, which
+ * also reports the precise error.
+ *
+ * @param date_str The date and time string to parse.
+ * @param layout The layout of date_str, not iso_layout::none.
+ * @param seconds Seconds since the epoch.
+ * @param nanoseconds The fractional second in nanoseconds.
+ * @return bool True if the kernel parsed the input.
+ */
+inline auto parse_iso_fixed(string_view date_str, iso_layout layout,
+                            int64_t &seconds, uint32_t &nanoseconds) noexcept
+    -> bool {
+  constexpr std::size_t prefix_size = 19;
+  iso_fields fields{};
+  if (date_str.size() < prefix_size ||
+      !parse_iso_prefix(date_str.data(), fields)) {
+    return false;
+  }
+  if (fields.month - 1 > 11 || fields.day < 1 ||
+      fields.day > static_cast<uint32_t>(days_in_month(
+                       static_cast<int32_t>(fields.year),
+                       static_cast<int32_t>(fields.month) - 1)) ||
+      fields.hour > 23 || fields.minute > 59 || fields.second > 59) {
+    return false;
+  }
+
+  std::size_t next = prefix_size;
+  nanoseconds = 0;
+  if (layout == iso_layout::fraction || layout == iso_layout::fraction_offset) {
+    if (next >= date_str.size() || date_str[next] != '.') {
+      return false;
+    }
+    ++next;
+    uint32_t digits = 0;
+    while (next < date_str.size() && digits < 9 &&
+           mgutility::detail::is_digit(date_str[next])) {
+      nanoseconds = (nanoseconds * 10) + static_cast<uint32_t>(date_str[next] - '0');
+      ++digits;
+      ++next;
+    }
+    if (digits == 0) {
+      return false;
+    }
+    // NOLINTNEXTLINE
+    constexpr uint32_t scale[] = {1000000000, 100000000, 10000000, 1000000,
+                                  100000,     10000,     1000,     100,
+                                  10,         1};
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    nanoseconds *= scale[digits];
+  }
+
+  int32_t offset = 0;
+  if (layout == iso_layout::offset || layout == iso_layout::fraction_offset) {
+    if (next >= date_str.size()) {
+      return false;
+    }
+    const char sign = date_str[next];
+    if (sign != 'Z') {
+      uint32_t hours = 0;
+      uint32_t minutes = 0;
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const char *tail = date_str.data() + next + 1;
+      const std::size_t remaining = date_str.size() - next - 1;
+      if ((sign != '+' && sign != '-') || remaining < 4 ||
+          !parse_two_digits(tail, hours)) {
+        return false;
+      }
+      // +hh and offsets with seconds are left to get_time()
+      const std::size_t colon = tail[2] == ':' ? 1 : 0;
+      if (remaining < 4 + colon || !parse_two_digits(tail + 2 + colon, minutes) ||
+          minutes > 59 || (hours * 100) + minutes > 1400 ||
+          (remaining > 4 + colon && (tail[4 + colon] == ':' ||
+                                     mgutility::detail::is_digit(tail[4 + colon])))) {
+        return false;
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      offset = static_cast<int32_t>((hours * 3600) + (minutes * 60));
+      offset = sign == '+' ? offset : -offset;
+    }
+  }
+
+  seconds = (static_cast<int64_t>(days_from_civil(
+                 static_cast<int32_t>(fields.year), fields.month, fields.day)) *
+             86400) +
+            (fields.hour * 3600) + (fields.minute * 60) + fields.second - offset;
+  return true;
+}
+
+/**
+ * @brief Parses one element of a batch, using the kernel for fixed-width
+ * layouts and get_time() otherwise.
+ *
+ * @tparam Clock The clock type.
+ * @param time_point The time point to populate.
+ * @param layout The detected layout of format.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <typename Clock>
+auto parse_one(typename Clock::time_point &time_point, iso_layout layout,
+               string_view format, string_view date_str) -> std::errc {
+  int64_t seconds = 0;
+  uint32_t nanoseconds = 0;
+  if (layout != iso_layout::none &&
+      parse_iso_fixed(date_str, layout, seconds, nanoseconds)) {
+    int64_t count = 0;
+    const auto error = epoch_count<typename Clock::period>(seconds, nanoseconds,
+                                                           count);
+    return error != std::errc{} ? error
+                                : from_epoch_count<Clock>(time_point, count);
+  }
+  detail::tm time_struct{};
+  const auto error = get_time(time_struct, format, date_str);
+  if (error != std::errc{}) {
+    return error;
+  }
+  return to_time_point<Clock>(time_point, time_struct);
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses a column of date and time strings.
+ *
+ * The fixed-width layouts {:%FT%T}, {:%FT%T.%f}, {:%FT%T%z} and
+ * {:%FT%T.%f%z} use a dedicated kernel (SSSE3 when enabled at compile time);
+ * every other format, and every row the kernel rejects, falls back to the
+ * generic parser with identical results.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The format string.
+ * @param input The strings to parse.
+ * @param count The number of strings.
+ * @param output The parsed time points, count elements. Elements whose
+ * parsing failed are left unchanged.
+ * @param errors The per-element error codes, count elements, or nullptr.
+ * @return std::size_t The number of elements that failed to parse.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse_many(string_view format, const string_view *input,
+                std::size_t count, typename Clock::time_point *output,
+                std::errc *errors = nullptr) -> std::size_t {
+  const auto layout = detail::detect_iso_layout(format);
+  std::size_t failures = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto error =
+        detail::parse_one<Clock>(output[i], layout, format, input[i]);
+    failures += error != std::errc{} ? 1 : 0;
+    if (errors != nullptr) {
+      errors[i] = error;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+  return failures;
+}
+
+/**
+ * @brief Parses a packed buffer of fixed-width date and time records.
+ *
+ * Record i occupies the bytes [i * stride, (i + 1) * stride) of records and
+ * its date and time string starts at the first byte.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The format string.
+ * @param records The packed records.
+ * @param stride The size of one record in bytes.
+ * @param count The number of records.
+ * @param output The parsed time points, count elements. Elements whose
+ * parsing failed are left unchanged.
+ * @param errors The per-record error codes, count elements, or nullptr.
+ * @return std::size_t The number of records that failed to parse.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse_many(string_view format, const char *records, std::size_t stride,
+                std::size_t count, typename Clock::time_point *output,
+                std::errc *errors = nullptr) -> std::size_t {
+  const auto layout = detail::detect_iso_layout(format);
+  std::size_t failures = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto error = detail::parse_one<Clock>(
+        output[i], layout, format, string_view{records + (i * stride), stride});
+    failures += error != std::errc{} ? 1 : 0;
+    if (errors != nullptr) {
+      errors[i] = error;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+  return failures;
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_PARSE_MANY_HPP
@@ -0,0 +1,476 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_PLAN_HPP
+#define MGUTILITY_CHRONO_PLAN_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Returns the number of characters a field always takes, or 0 if its
+ * length depends on the input, e.g. %f, %z or %B.
+ *
+ * @param specifier The specifier character.
+ * @return uint32_t The width of the field.
+ */
+constexpr auto field_width(char specifier) noexcept -> uint32_t {
+  return specifier == 'F'                                          ? 10
+         : specifier == 'T'                                        ? 8
+         : specifier == 'Y' || specifier == 'G'                    ? 4
+         : specifier == 'j' || specifier == 'b' || specifier == 'a' ? 3
+         : specifier == 'm' || specifier == 'd' || specifier == 'H' ||
+                 specifier == 'M' || specifier == 'S' || specifier == 'y' ||
+                 specifier == 'I' || specifier == 'V' || specifier == 'p'
+             ? 2
+         : specifier == 'u' ? 1
+                            : 0;
+}
+
+/**
+ * @brief Counts the operations compile_format() would write, for a format
+ * too long to compile in place.
+ *
+ * @param format The format string.
+ * @return std::size_t The number of fields and literal characters.
+ */
+MGUTILITY_CNSTXPR auto op_count(string_view format) noexcept -> std::size_t {
+  const std::size_t begin = format.find('{');
+  const std::size_t end = format.find('}');
+  if (begin == string_view::npos || end == string_view::npos || begin >= end) {
+    return 0;
+  }
+  std::size_t count = 0;
+  for (std::size_t i = begin + 2; i < end; ++i) {
+    i += format[i] == '%' ? 1 : 0;
+    ++count;
+  }
+  return count;
+}
+
+/**
+ * @brief Reads exactly width digits at a known position.
+ *
+ * @param str The input, at least pos + width characters long.
+ * @param pos The position of the first digit.
+ * @param width The number of digits.
+ * @param value The number read.
+ * @return bool True if every character is a digit.
+ */
+MGUTILITY_CNSTXPR auto read_digits(string_view str, uint32_t pos,
+                                   uint32_t width, int32_t &value) noexcept
+    -> bool {
+  int32_t number = 0;
+  for (uint32_t i = 0; i < width; ++i) {
+    const uint32_t digit =
+        static_cast<uint32_t>(static_cast<unsigned char>(str[pos + i])) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    number = (number * 10) + static_cast<int32_t>(digit);
+  }
+  value = number;
+  return true;
+}
+
+/**
+ * @brief Reads a numeric field at a known position and stores it with
+ * store_field().
+ *
+ * @tparam Specifier The specifier of the field, e.g. 'Y'.
+ * @return bool True if the field parsed.
+ */
+template <char Specifier>
+MGUTILITY_CNSTXPR auto read_field(detail::tm &result, string_view str,
+                                  uint32_t pos) noexcept -> bool {
+  int32_t value = 0;
+  return read_digits(str, pos, field_width(Specifier), value) &&
+         store_field<Specifier>(result, value) == std::errc{};
+}
+
+/**
+ * @brief Parses a fixed-width field at a known position, with the same
+ * checks as parse_specifier(). Names and AM/PM go through parse_specifier().
+ *
+ * @param result The tm structure to populate.
+ * @param specifier The specifier character.
+ * @param str The input, long enough for the field.
+ * @param pos The position of the field.
+ * @return bool True if the field parsed.
+ */
+MGUTILITY_CNSTXPR auto parse_fixed_field(detail::tm &result, char specifier,
+                                         string_view str, uint32_t pos)
+    -> bool {
+  switch (specifier) {
+  case 'F':
+    return read_field<'Y'>(result, str, pos) &&
+           read_field<'m'>(result, str, pos + 5) &&
+           read_field<'d'>(result, str, pos + 8);
+  case 'T':
+    return read_field<'H'>(result, str, pos) &&
+           read_field<'M'>(result, str, pos + 3) &&
+           read_field<'S'>(result, str, pos + 6);
+  case 'Y':
+    return read_field<'Y'>(result, str, pos);
+  case 'm':
+    return read_field<'m'>(result, str, pos);
+  case 'd':
+    return read_field<'d'>(result, str, pos);
+  case 'H':
+    return read_field<'H'>(result, str, pos);
+  case 'M':
+    return read_field<'M'>(result, str, pos);
+  case 'S':
+    return read_field<'S'>(result, str, pos);
+  case 'y':
+    return read_field<'y'>(result, str, pos);
+  case 'j':
+    return read_field<'j'>(result, str, pos);
+  case 'I':
+    return read_field<'I'>(result, str, pos);
+  case 'G':
+    return read_field<'G'>(result, str, pos);
+  case 'V':
+    return read_field<'V'>(result, str, pos);
+  case 'u':
+    return read_field<'u'>(result, str, pos);
+  default: {
+    uint32_t next = pos;
+    return parse_specifier(result, specifier, str, next) == std::errc{};
+  }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief A format string supplied at run time, validated once and flattened
+ * into fields and literal characters, e.g. from per-tenant configuration.
+ *
+ * Created by mgutility::chrono::make_parser(). When every field of the format
+ * has a fixed width (%Y, %m, %d, %F, %T, %H, %M, %S, %j, %y, %I, %G, %V, %u,
+ * %b, %a, %p), each field and literal gets its offset in the input when the
+ * plan is made, and inputs long enough for the layout are parsed at those
+ * offsets without walking the format. Inputs the fixed path rejects, and
+ * other formats, run the compiled operations, so results and diagnostics are
+ * those of parse() with a compiled format.
+ *
+ * A plan holds no pointers and is never modified by parsing: copy it freely
+ * and share it between threads.
+ */
+class parse_plan {
+public:
+  /**
+   * @brief The maximum number of fields and literal characters of a format.
+   */
+  static constexpr std::size_t capacity = 48;
+
+  /**
+   * @brief Makes a plan for a format string.
+   *
+   * @param format The format string, e.g. "{:%F %T.%f}". An invalid format,
+   * or one with more than capacity fields and literals (value_too_large), is
+   * reported by error() and by every parse.
+   */
+  explicit MGUTILITY_CNSTXPR parse_plan(string_view format) noexcept {
+    // A format of n characters has at most n operations
+    if (format.size() > capacity + 3 && detail::op_count(format) > capacity) {
+      error_ = std::errc::value_too_large;
+      return;
+    }
+    error_ = detail::compile_format(static_cast<detail::format_op *>(ops_),
+                                    size_, format);
+    if (error_ != std::errc{}) {
+      size_ = 0;
+      return;
+    }
+    fixed_ = true;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < size_; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      const char specifier = ops_[i].specifier;
+      const uint32_t width =
+          specifier == '\0' ? 1 : detail::field_width(specifier);
+      fixed_ = fixed_ && width != 0;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      offsets_[i] = static_cast<uint16_t>(offset);
+      offset += width;
+    }
+    width_ = fixed_ ? offset : 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+    end_ = ops_[size_ - 1].specifier != '\0' ? width_ + 1 : width_;
+  }
+
+  /**
+   * @brief Returns the error found in the format, if any.
+   */
+  constexpr auto error() const noexcept -> std::errc { return error_; }
+
+  /**
+   * @brief Returns true if every field of the format has a fixed width.
+   */
+  constexpr auto fixed_width() const noexcept -> bool { return fixed_; }
+
+  /**
+   * @brief Returns the length of the inputs of a fixed-width format, 0 for
+   * other formats. Longer inputs are accepted, as by parse().
+   */
+  constexpr auto width() const noexcept -> uint32_t { return width_; }
+
+  /**
+   * @brief Parses the fields of a date and time string, used by the parse()
+   * and parse_epoch() overloads taking a plan.
+   *
+   * @param result The tm structure to populate.
+   * @param date_str The date and time string to parse.
+   * @return parse_result The same diagnostics as get_time() with the format
+   * string.
+   */
+  MGUTILITY_CNSTXPR auto get_time(detail::tm &result,
+                                  string_view date_str) const -> parse_result {
+    if (error_ != std::errc{}) {
+      return parse_result{error_, 0, '\0', parse_stage::format};
+    }
+    if (fixed_ && date_str.size() >= width_) {
+      if (run_fixed(result, date_str)) {
+        return detail::finish_fields(result, date_str, end_);
+      }
+      // Parse again for the diagnostics of the operation that failed
+      result = detail::tm{};
+    }
+    uint32_t next = 0;
+    const auto *ops = static_cast<const detail::format_op *>(ops_);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto status = detail::run_ops(result, ops, ops + size_, date_str, next);
+    if (!status.ok()) {
+      return status;
+    }
+    return detail::finish_fields(result, date_str, next);
+  }
+
+private:
+  MGUTILITY_CNSTXPR auto run_fixed(detail::tm &result,
+                                   string_view date_str) const -> bool {
+    for (uint32_t i = 0; i < size_; ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      const detail::format_op &operation = ops_[i];
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+      const uint32_t offset = offsets_[i];
+      if (operation.specifier == '\0'
+              ? date_str[offset] != operation.literal
+              : !detail::parse_fixed_field(result, operation.specifier,
+                                           date_str, offset)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  detail::format_op ops_[capacity]{}; // NOLINT
+  uint16_t offsets_[capacity]{};      // NOLINT
+  uint32_t size_{};
+  uint32_t width_{};
+  uint32_t end_{};
+  bool fixed_{};
+  std::errc error_{};
+};
+
+/**
+ * @brief Makes a reusable plan for a format string known only at run time,
+ * e.g. auto plan = make_parser(config.timestamp_format).
+ *
+ * @param format The format string, e.g. "{:%d.%m.%Y %H:%M:%S}".
+ * @return parse_plan The plan. An invalid format is reported by its error()
+ * and by every parse.
+ */
+MGUTILITY_CNSTXPR auto make_parser(string_view format) noexcept -> parse_plan {
+  return parse_plan{format};
+}
+
+namespace detail {
+/**
+ * @brief Parses a date and time string with a plan into a count of Period
+ * since 1970-01-01 UTC. Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count.
+ * @param count The count of Period since the epoch.
+ * @param plan The plan.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period>
+MGUTILITY_CNSTXPR auto parse_plan_epoch(int64_t &count, const parse_plan &plan,
+                                        string_view date_str) noexcept
+    -> parse_result {
+  detail::tm time_struct{};
+  parse_result result = plan.get_time(time_struct, date_str);
+  if (!result.ok()) {
+    return result;
+  }
+  result.error = to_epoch_count<Period>(count, time_struct);
+  result.stage = result.ok() ? parse_stage::none : parse_stage::conversion;
+  return result;
+}
+} // namespace detail
+
+/**
+ * @brief Parses a date and time string with a plan into a
+ * std::chrono::time_point.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(typename Clock::time_point &time_point, const parse_plan &plan,
+           string_view date_str) -> std::error_code {
+  detail::tm time_struct{};
+  auto error = plan.get_time(time_struct, date_str).error;
+  if (error == std::errc{}) {
+    error = detail::to_time_point<Clock>(time_point, time_struct);
+  }
+  return detail::to_error_code(error);
+}
+
+/**
+ * @brief Parses a date and time string with a plan into a
+ * std::chrono::time_point, reporting where and why parsing stopped.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(typename Clock::time_point &time_point, const parse_plan &plan,
+           string_view date_str, diagnostics_t) -> parse_result {
+  detail::tm time_struct{};
+  return detail::to_time_point<Clock>(time_point, time_struct,
+                                      plan.get_time(time_struct, date_str));
+}
+
+/**
+ * @brief Parses a date and time string with a plan into a count of Period
+ * since 1970-01-01 UTC.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Period = std::ratio<1>>
+auto parse_epoch(int64_t &count, const parse_plan &plan, string_view date_str)
+    -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_plan_epoch<Period>(count, plan, date_str).error);
+}
+
+/**
+ * @brief Parses a date and time string with a plan into a count of Period
+ * since 1970-01-01 UTC, reporting where and why parsing stopped. Usable in
+ * constant expressions from C++14.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period = std::ratio<1>>
+MGUTILITY_CNSTXPR auto parse_epoch(int64_t &count, const parse_plan &plan,
+                                   string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  return detail::parse_plan_epoch<Period>(count, plan, date_str);
+}
+
+/**
+ * @brief Parses a date and time string with a plan into a duration since
+ * 1970-01-01 UTC, reporting where and why parsing stopped. Usable in constant
+ * expressions from C++14.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto parse_epoch(
+    std::chrono::duration<Rep, Period> &since_epoch, const parse_plan &plan,
+    string_view date_str, diagnostics_t) noexcept -> parse_result {
+  int64_t count = 0;
+  parse_result result =
+      detail::parse_plan_epoch<Period>(count, plan, date_str);
+  if (result.ok() && !detail::fits_rep<Rep>(count)) {
+    result.error = std::errc::result_out_of_range;
+    result.stage = parse_stage::conversion;
+  }
+  if (result.ok()) {
+    since_epoch = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+  }
+  return result;
+}
+
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
+/**
+ * @brief Parses a date and time string with a plan into a
+ * std::chrono::time_point.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param plan The plan made by make_parser().
+ * @param date_str The date and time string to parse.
+ * @throw std::system_error if parsing fails
+ * @return Clock::time_point The parsed time point.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(const parse_plan &plan, string_view date_str) ->
+    typename Clock::time_point {
+  typename Clock::time_point time_point{};
+  auto error = parse<Clock>(time_point, plan, date_str);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return time_point;
+}
+#endif // CHRONO_PARSE_NO_EXCEPTIONS
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_PLAN_HPP
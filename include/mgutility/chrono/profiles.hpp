@@ -0,0 +1,641 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_PROFILES_HPP
+#define MGUTILITY_CHRONO_PROFILES_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <system_error>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief How closely an input must follow its profile.
+ */
+enum class parse_mode : uint8_t {
+  strict, ///< Only the layout its specification defines.
+  lenient ///< Also the common deviations listed for each profile.
+};
+
+/**
+ * @brief The layouts with a dedicated parser.
+ */
+enum class profile_layout : uint8_t {
+  rfc3339,          ///< 2023-04-30T16:22:18.250+02:00
+  iso8601_extended, ///< 2023-04-30T16:22:18,250+02:00
+  iso8601_basic,    ///< 20230430T162218,250+0200
+  iso_week_date     ///< 2023-W17-7, optionally followed by a time
+};
+
+/**
+ * @brief A predefined timestamp layout, parsed by a fixed-layout scanner
+ * instead of a format string. Use the constants in
+ * mgutility::chrono::formats.
+ *
+ * In strict mode:
+ * - rfc3339 is YYYY-MM-DDTHH:MM:SS[.f] followed by Z or +hh:mm;
+ * - iso8601 is YYYY-MM-DDTHH:MM:SS[.f|,f] with an optional Z, +hh or
+ *   +hh:mm;
+ * - iso8601_basic is YYYYMMDDTHHMMSS[.f|,f] with an optional Z, +hh or
+ *   +hhmm;
+ * - iso_week_date is YYYY-Www-D, optionally followed by an iso8601 time.
+ *
+ * Fractions have one digit or more, as both specifications allow; digits
+ * past nanoseconds are truncated. Without an offset the time is UTC, as
+ * with format strings. Lenient mode also accepts a 't' or a space before
+ * the time, a lowercase z, offsets with or without a colon, no offset for
+ * rfc3339, ',' fractions for rfc3339, and a date without a time
+ * (midnight). For iso_week_date it accepts YYYYWwwD, a lowercase w and a
+ * missing weekday (Monday).
+ */
+struct profile {
+  profile_layout layout; ///< The layout.
+  parse_mode mode;       ///< Strict or lenient.
+
+  /**
+   * @brief Returns the lenient variant of this profile, e.g.
+   * formats::rfc3339.lenient().
+   */
+  constexpr auto lenient() const noexcept -> profile {
+    return profile{layout, parse_mode::lenient};
+  }
+};
+
+namespace formats {
+/// RFC 3339 timestamps, e.g. 2023-04-30T16:22:18.250Z.
+constexpr profile rfc3339{profile_layout::rfc3339, parse_mode::strict};
+/// ISO 8601 extended timestamps, e.g. 2023-04-30T18:22:18+02.
+constexpr profile iso8601{profile_layout::iso8601_extended,
+                          parse_mode::strict};
+/// ISO 8601 basic timestamps, e.g. 20230430T162218Z.
+constexpr profile iso8601_basic{profile_layout::iso8601_basic,
+                                parse_mode::strict};
+/// ISO 8601 week dates, e.g. 2023-W17-7 or 2023-W17-7T16:22:18Z.
+constexpr profile iso_week_date{profile_layout::iso_week_date,
+                                parse_mode::strict};
+} // namespace formats
+
+namespace detail {
+
+/**
+ * @brief Reads the fields of a profile in order, recording the first
+ * failure as a parse_result.
+ */
+class profile_reader {
+public:
+  constexpr profile_reader(string_view str, bool lenient) noexcept
+      : str_(str), lenient_(lenient), next_(0),
+        result_{std::errc{}, 0, '\0', parse_stage::none} {}
+
+  /**
+   * @brief Returns true in lenient mode.
+   */
+  constexpr auto lenient() const noexcept -> bool { return lenient_; }
+
+  /**
+   * @brief Returns the position of the next character to read.
+   */
+  constexpr auto position() const noexcept -> uint32_t { return next_; }
+
+  /**
+   * @brief Returns true if the whole input has been read.
+   */
+  constexpr auto at_end() const noexcept -> bool {
+    return next_ >= str_.size();
+  }
+
+  /**
+   * @brief Returns the next character, or '\0' at the end of the input.
+   */
+  constexpr auto peek() const noexcept -> char {
+    return next_ < str_.size() ? str_[next_] : '\0';
+  }
+
+  /**
+   * @brief Returns the first failure, or success.
+   */
+  constexpr auto result() const noexcept -> parse_result { return result_; }
+
+  /**
+   * @brief Records a failure.
+   *
+   * @return bool Always false, so callers can return it.
+   */
+  MGUTILITY_CNSTXPR auto fail(std::errc error, uint32_t position,
+                              char specifier, parse_stage stage) noexcept
+      -> bool {
+    result_ = parse_result{error, position, specifier, stage};
+    return false;
+  }
+
+  /**
+   * @brief Consumes chr if it is the next character.
+   *
+   * @return bool True if chr was consumed.
+   */
+  MGUTILITY_CNSTXPR auto skip(char chr) noexcept -> bool {
+    if (at_end() || str_[next_] != chr) {
+      return false;
+    }
+    ++next_;
+    return true;
+  }
+
+  /**
+   * @brief Consumes a separator that the layout requires.
+   *
+   * @return bool False, with a separator failure, if chr is not next.
+   */
+  MGUTILITY_CNSTXPR auto expect(char chr) noexcept -> bool {
+    return skip(chr) || fail(std::errc::invalid_argument, next_, '\0',
+                             parse_stage::separator);
+  }
+
+  /**
+   * @brief Reads exactly digits digits as a number in [min, max].
+   *
+   * @param value The number.
+   * @param digits The number of digits.
+   * @param min The smallest valid value.
+   * @param max The largest valid value.
+   * @param specifier The equivalent format specifier, for diagnostics.
+   * @return bool False, with a field failure, if the digits are missing or
+   * the number is out of range.
+   */
+  MGUTILITY_CNSTXPR auto number(int32_t &value, uint32_t digits, int32_t min,
+                                int32_t max, char specifier) noexcept -> bool {
+    const uint32_t start = next_;
+    if (static_cast<std::size_t>(next_) + digits > str_.size()) {
+      return fail(std::errc::invalid_argument, start, specifier,
+                  parse_stage::field);
+    }
+    value = 0;
+    for (const uint32_t end = next_ + digits; next_ < end; ++next_) {
+      if (!mgutility::detail::is_digit(str_[next_])) {
+        next_ = start;
+        return fail(std::errc::invalid_argument, start, specifier,
+                    parse_stage::field);
+      }
+      value = (value * 10) + (str_[next_] - '0');
+    }
+    if (value < min || value > max) {
+      next_ = start;
+      return fail(std::errc::result_out_of_range, start, specifier,
+                  parse_stage::field);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads a run of digits of any length as a number, e.g. the count
+   * of a duration component.
+   *
+   * @param value The number.
+   * @param specifier The equivalent format specifier, for diagnostics.
+   * @return bool False, with a field failure, without digits or if the
+   * number does not fit in int64_t.
+   */
+  MGUTILITY_CNSTXPR auto integer(int64_t &value, char specifier) noexcept
+      -> bool {
+    uint32_t digits = 0;
+    while (static_cast<std::size_t>(next_) + digits < str_.size() &&
+           mgutility::detail::is_digit(str_[next_ + digits])) {
+      ++digits;
+    }
+    // Compare runs of 19 digits with INT64_MAX before converting them
+    uint32_t zeros = 0;
+    while (zeros + 1 < digits && str_[next_ + zeros] == '0') {
+      ++zeros;
+    }
+    bool too_large = digits - zeros > 19;
+    if (digits - zeros == 19) {
+      const char *const max = "9223372036854775807";
+      uint32_t i = 0;
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      while (i < 19 && str_[next_ + zeros + i] == max[i]) {
+        ++i;
+      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      too_large = i < 19 && str_[next_ + zeros + i] > max[i];
+    }
+    uint32_t next = next_;
+    const auto error = digits == 0 ? std::errc::invalid_argument
+                       : too_large ? std::errc::result_out_of_range
+                                   : parse_integer(value, str_, digits, next);
+    if (error != std::errc{}) {
+      return fail(error, next_, specifier, parse_stage::field);
+    }
+    next_ += digits;
+    return true;
+  }
+
+  /**
+   * @brief Reads the digits of a fraction of a second, truncating those
+   * past nanoseconds.
+   *
+   * @param nanoseconds The fraction in nanoseconds.
+   * @return bool False, with a field failure, without digits.
+   */
+  MGUTILITY_CNSTXPR auto fraction(uint32_t &nanoseconds) noexcept -> bool {
+    const uint32_t start = next_;
+    uint32_t digits = 0;
+    nanoseconds = 0;
+    for (; !at_end() && mgutility::detail::is_digit(str_[next_]); ++next_) {
+      if (digits < 9) {
+        nanoseconds = (nanoseconds * 10) +
+                      static_cast<uint32_t>(str_[next_] - '0');
+      }
+      ++digits;
+    }
+    if (digits == 0) {
+      next_ = start;
+      return fail(std::errc::invalid_argument, start, 'f',
+                  parse_stage::field);
+    }
+    nanoseconds *= pow<uint32_t>(10, digits < 9 ? 9 - digits : 0);
+    return true;
+  }
+
+private:
+  string_view str_;
+  bool lenient_;
+  uint32_t next_;
+  parse_result result_;
+};
+
+/**
+ * @brief Reads YYYY-MM-DD, or YYYYMMDD if not extended.
+ */
+MGUTILITY_CNSTXPR auto read_calendar_date(profile_reader &reader,
+                                          detail::tm &result, bool extended)
+    -> bool {
+  if (!reader.number(result.tm_year, 4, 0, 9999, 'Y') ||
+      (extended && !reader.expect('-')) ||
+      !reader.number(result.tm_mon, 2, 1, 12, 'm') ||
+      (extended && !reader.expect('-'))) {
+    return false;
+  }
+  result.tm_year -= 1900;
+  result.tm_mon -= 1;
+  result.tm_derive |= has_year;
+  return reader.number(result.tm_mday, 2, 1,
+                       days_in_month(result.tm_year + 1900, result.tm_mon),
+                       'd');
+}
+
+/**
+ * @brief Reads YYYY-Www-D, or in lenient mode also YYYYWwwD and a date
+ * without the weekday. The date itself is derived by finish_fields().
+ *
+ * @param extended Set to true if the date had '-' separators.
+ */
+MGUTILITY_CNSTXPR auto read_week_date(profile_reader &reader,
+                                      detail::tm &result, bool &extended)
+    -> bool {
+  if (!reader.number(result.tm_iso_year, 4, 0, 9999, 'G')) {
+    return false;
+  }
+  extended = reader.skip('-');
+  if (!extended && !reader.lenient()) {
+    return reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                       parse_stage::separator);
+  }
+  if (!reader.skip('W') && !(reader.lenient() && reader.skip('w'))) {
+    return reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                       parse_stage::separator);
+  }
+  if (!reader.number(result.tm_iso_week, 2, 1, 53, 'V')) {
+    return false;
+  }
+  result.tm_derive |= derive_iso_week | has_iso_year;
+  const bool has_day = extended
+                           ? reader.peek() == '-'
+                           : mgutility::detail::is_digit(reader.peek());
+  if (!has_day && reader.lenient()) {
+    return true;
+  }
+  if ((extended && !reader.expect('-')) ||
+      !reader.number(result.tm_wday, 1, 1, 7, 'u')) {
+    return false;
+  }
+  result.tm_wday %= 7;
+  result.tm_derive |= has_weekday;
+  return true;
+}
+
+/**
+ * @brief Reads HH:MM:SS, or HHMMSS if not extended, and an optional
+ * fraction. In lenient mode the first separator decides the form.
+ *
+ * @param comma True if ',' may start the fraction.
+ */
+MGUTILITY_CNSTXPR auto read_time(profile_reader &reader, detail::tm &result,
+                                 bool extended, bool comma) -> bool {
+  if (!reader.number(result.tm_hour, 2, 0, 23, 'H')) {
+    return false;
+  }
+  extended = reader.lenient() ? reader.peek() == ':' : extended;
+  if ((extended && !reader.expect(':')) ||
+      !reader.number(result.tm_min, 2, 0, 59, 'M') ||
+      (extended && !reader.expect(':')) ||
+      !reader.number(result.tm_sec, 2, 0, 60, 'S')) {
+    return false;
+  }
+  if (reader.skip('.') || (comma && reader.skip(','))) {
+    return reader.fraction(result.tm_ms);
+  }
+  return true;
+}
+
+/**
+ * @brief Reads Z, +hh:mm, or +hhmm if not extended, and +hh if hours_only.
+ * In lenient mode the colon is optional and so is +hh.
+ *
+ * @param required True if the input must end with an offset.
+ */
+MGUTILITY_CNSTXPR auto read_offset(profile_reader &reader, detail::tm &result,
+                                   bool extended, bool required,
+                                   bool hours_only) -> bool {
+  const uint32_t start = reader.position();
+  if (reader.at_end()) {
+    return !required || reader.fail(std::errc::invalid_argument, start, 'z',
+                                    parse_stage::field);
+  }
+  result.tm_has_offset = true;
+  result.tm_offset = 0;
+  if (reader.skip('Z') || (reader.lenient() && reader.skip('z'))) {
+    return true;
+  }
+  const char sign = reader.peek();
+  if ((sign != '+' && sign != '-') || !reader.skip(sign)) {
+    return reader.fail(std::errc::invalid_argument, start, 'z',
+                       parse_stage::field);
+  }
+  int32_t hours = 0;
+  int32_t minutes = 0;
+  if (!reader.number(hours, 2, 0, 14, 'z')) {
+    return false;
+  }
+  if (!reader.at_end() || !(hours_only || reader.lenient())) {
+    extended = reader.lenient() ? reader.peek() == ':' : extended;
+    if ((extended && !reader.expect(':')) ||
+        !reader.number(minutes, 2, 0, 59, 'z')) {
+      return false;
+    }
+  }
+  const int32_t offset = (hours * 3600) + (minutes * 60);
+  if (offset > 14 * 3600) {
+    return reader.fail(std::errc::result_out_of_range, start, 'z',
+                       parse_stage::field);
+  }
+  result.tm_offset = sign == '+' ? offset : -offset;
+  return true;
+}
+
+/**
+ * @brief Parses a date and time string laid out as a predefined profile,
+ * reporting where and why parsing stopped. Specifiers in the diagnostics are
+ * those of the equivalent format string, e.g. 'm' for the month.
+ *
+ * @param result The tm structure to populate.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result, const profile &format,
+                                string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  profile_reader reader{date_str, format.mode == parse_mode::lenient};
+  const bool rfc3339 = format.layout == profile_layout::rfc3339;
+  bool extended = format.layout != profile_layout::iso8601_basic;
+  const bool date =
+      format.layout == profile_layout::iso_week_date
+          ? read_week_date(reader, result, extended)
+          : read_calendar_date(reader, result, extended);
+  if (!date) {
+    return reader.result();
+  }
+
+  // A week date, and any date in lenient mode, may stand alone
+  if (!reader.at_end() ||
+      !(reader.lenient() || format.layout == profile_layout::iso_week_date)) {
+    if (!reader.skip('T') &&
+        !(reader.lenient() && (reader.skip('t') || reader.skip(' ')))) {
+      reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                  parse_stage::separator);
+      return reader.result();
+    }
+    if (!read_time(reader, result, extended, !rfc3339 || reader.lenient()) ||
+        !read_offset(reader, result, extended, rfc3339 && !reader.lenient(),
+                     !rfc3339)) {
+      return reader.result();
+    }
+  }
+
+  if (!reader.at_end()) {
+    reader.fail(std::errc::invalid_argument, reader.position(), '\0',
+                parse_stage::separator);
+    return reader.result();
+  }
+  return finish_fields(result, date_str, reader.position());
+}
+
+/**
+ * @brief Parses a date and time string laid out as a predefined profile.
+ *
+ * @param result The tm structure to populate.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return std::errc An error code indicating success or failure.
+ */
+MGUTILITY_CNSTXPR auto get_time(detail::tm &result, const profile &format,
+                                string_view date_str) noexcept -> std::errc {
+  return get_time(result, format, date_str, diagnostics_t{}).error;
+}
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a count of
+ * Period since 1970-01-01 UTC. Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count.
+ * @param count The count of Period since the epoch.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period>
+MGUTILITY_CNSTXPR auto parse_profile_epoch(int64_t &count,
+                                           const profile &format,
+                                           string_view date_str) noexcept
+    -> parse_result {
+  detail::tm time_struct{};
+  parse_result result =
+      get_time(time_struct, format, date_str, diagnostics_t{});
+  if (!result.ok()) {
+    return result;
+  }
+  result.error = to_epoch_count<Period>(count, time_struct);
+  result.stage = result.ok() ? parse_stage::none : parse_stage::conversion;
+  return result;
+}
+} // namespace detail
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a
+ * std::chrono::time_point, e.g. parse(time_point, formats::rfc3339, str).
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param format The profile, e.g. formats::rfc3339.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(typename Clock::time_point &time_point, const profile &format,
+           string_view date_str) -> std::error_code {
+  detail::tm time_struct{};
+  auto error = detail::get_time(time_struct, format, date_str);
+  if (error == std::errc{}) {
+    error = detail::to_time_point<Clock>(time_point, time_struct);
+  }
+  return detail::to_error_code(error);
+}
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a
+ * std::chrono::time_point, reporting where and why parsing stopped.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param format The profile, e.g. formats::rfc3339.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(typename Clock::time_point &time_point, const profile &format,
+           string_view date_str, diagnostics_t) -> parse_result {
+  detail::tm time_struct{};
+  return detail::to_time_point<Clock>(
+      time_point, time_struct,
+      detail::get_time(time_struct, format, date_str, diagnostics_t{}));
+}
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a count of
+ * Period since 1970-01-01 UTC.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Period = std::ratio<1>>
+auto parse_epoch(int64_t &count, const profile &format, string_view date_str)
+    -> std::error_code {
+  return detail::to_error_code(
+      detail::parse_profile_epoch<Period>(count, format, date_str).error);
+}
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a count of
+ * Period since 1970-01-01 UTC, reporting where and why parsing stopped.
+ * Usable in constant expressions from C++14.
+ *
+ * @tparam Period The period of the count (defaults to seconds).
+ * @param count The count of Period since the epoch.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Period = std::ratio<1>>
+MGUTILITY_CNSTXPR auto parse_epoch(int64_t &count, const profile &format,
+                                   string_view date_str, diagnostics_t) noexcept
+    -> parse_result {
+  return detail::parse_profile_epoch<Period>(count, format, date_str);
+}
+
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a duration
+ * since 1970-01-01 UTC, reporting where and why parsing stopped. Usable in
+ * constant expressions from C++14.
+ *
+ * @param since_epoch The duration since the epoch.
+ * @param format The profile.
+ * @param date_str The date and time string to parse.
+ * @return parse_result The diagnostics.
+ */
+template <typename Rep, typename Period>
+MGUTILITY_CNSTXPR auto parse_epoch(
+    std::chrono::duration<Rep, Period> &since_epoch, const profile &format,
+    string_view date_str, diagnostics_t) noexcept -> parse_result {
+  int64_t count = 0;
+  parse_result result =
+      detail::parse_profile_epoch<Period>(count, format, date_str);
+  if (result.ok() && !detail::fits_rep<Rep>(count)) {
+    result.error = std::errc::result_out_of_range;
+    result.stage = parse_stage::conversion;
+  }
+  if (result.ok()) {
+    since_epoch = std::chrono::duration<Rep, Period>{static_cast<Rep>(count)};
+  }
+  return result;
+}
+
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
+/**
+ * @brief Parses a timestamp laid out as a predefined profile into a
+ * std::chrono::time_point.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The profile, e.g. formats::rfc3339.
+ * @param date_str The date and time string to parse.
+ * @throw std::system_error if parsing fails
+ * @return Clock::time_point The parsed time point.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(const profile &format, string_view date_str) ->
+    typename Clock::time_point {
+  typename Clock::time_point time_point{};
+  auto error = parse<Clock>(time_point, format, date_str);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return time_point;
+}
+#endif // CHRONO_PARSE_NO_EXCEPTIONS
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_PROFILES_HPP
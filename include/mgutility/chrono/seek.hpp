@@ -0,0 +1,250 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_SEEK_HPP
+#define MGUTILITY_CHRONO_SEEK_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/stream.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief A range of bytes [first, last) of a file or buffer.
+ */
+struct byte_range {
+  std::size_t first; ///< Offset of the first byte.
+  std::size_t last;  ///< Offset one past the last byte.
+};
+
+namespace detail {
+/**
+ * @brief Returns the start of the first line that starts at or after a byte
+ * offset.
+ *
+ * @param data The newline-separated lines.
+ * @param pos The byte offset.
+ * @return std::size_t The start of the line, data.size() if there is none.
+ */
+inline auto line_start_from(string_view data, std::size_t pos) noexcept
+    -> std::size_t {
+  if (pos == 0 || data[pos - 1] == '\n') {
+    return pos;
+  }
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const char *const last = data.data() + data.size();
+  const char *newline = find_newline(data.data() + pos, last);
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return newline == last ? data.size()
+                         : static_cast<std::size_t>(newline - data.data()) + 1;
+}
+} // namespace detail
+
+/**
+ * @brief Finds the lines of a time-ordered log that fall in a time window by
+ * bisecting byte offsets, e.g. 14:05 to 14:10 of a memory-mapped file of
+ * many gigabytes, without reading the lines outside the window.
+ *
+ * Each probe moves to the start of the next line and parses only that
+ * line's timestamp; lines whose timestamp does not parse, e.g. the
+ * continuation lines of a stack trace, are skipped and belong to the line
+ * before them. A window takes O(log n) probes, plus the lines whose
+ * timestamps lie within the tolerance before each end of the window.
+ *
+ * A tolerance makes the result exact for logs whose lines are out of order
+ * by at most that much, e.g. lines written by several threads: probes then
+ * only skip lines older than the tolerance before the window and scan
+ * forward from there.
+ *
+ * The probe count is plain per-object state: keep one seeker per thread.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Format The format type, string_view or a compiled_format.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Format = string_view>
+class time_seeker {
+public:
+  /**
+   * @brief Constructs a seeker.
+   *
+   * @param format The timestamp format. A string_view format must refer to
+   * characters that outlive the seeker.
+   * @param field Where the timestamp starts in each line.
+   * @param tolerance How far out of order lines may be.
+   */
+  explicit time_seeker(const Format &format,
+                       record_field field = at_offset(0),
+                       typename Clock::duration tolerance = {})
+      : format_(format), field_(field), tolerance_(tolerance) {}
+
+  /**
+   * @brief Finds the first line whose timestamp is at or after a time.
+   *
+   * @param data The newline-separated lines, e.g. mapped_file::view().
+   * @param time The time.
+   * @return std::size_t The start of the line, data.size() if there is none.
+   */
+  auto lower_bound(string_view data, typename Clock::time_point time)
+      -> std::size_t {
+    const typename Clock::time_point key = time - tolerance_;
+    // Every line that parses and starts before low is older than time; the
+    // probes search [low, high)
+    std::size_t low = 0;
+    std::size_t high = data.size();
+    typename Clock::time_point probe{};
+    while (low + 1 < high) {
+      const std::size_t mid = low + ((high - low) / 2);
+      const std::size_t start = detail::line_start_from(data, mid);
+      if (start >= high) {
+        high = mid;
+        continue;
+      }
+      std::size_t next = start;
+      const std::size_t line = next_timestamp(data, next, high, probe);
+      if (line >= high || probe >= key) {
+        high = start;
+        continue;
+      }
+      low = next;
+    }
+    for (std::size_t next = low; next < data.size();) {
+      const std::size_t line = next_timestamp(data, next, data.size(), probe);
+      if (line < data.size() && probe >= time) {
+        return line;
+      }
+    }
+    return data.size();
+  }
+
+  /**
+   * @brief Finds the lines whose timestamps fall in [from, to).
+   *
+   * @param data The newline-separated lines, e.g. mapped_file::view().
+   * @param from The start of the window.
+   * @param to The end of the window, excluded.
+   * @return byte_range The lines, with the lines after them that do not
+   * parse; empty if the window is.
+   */
+  auto find(string_view data, typename Clock::time_point from,
+            typename Clock::time_point to) -> byte_range {
+    const std::size_t first = lower_bound(data, from);
+    if (!(from < to)) {
+      return byte_range{first, first};
+    }
+    const std::size_t last = lower_bound(data, to);
+    return byte_range{first, last < first ? first : last};
+  }
+
+  /**
+   * @brief Returns the number of timestamps parsed so far.
+   */
+  auto probes() const noexcept -> std::size_t { return probes_; }
+
+private:
+  // Parses the timestamps of the lines starting at next, before end, until
+  // one parses. Returns the start of that line, or end, and leaves next at
+  // the line after it.
+  auto next_timestamp(string_view data, std::size_t &next, std::size_t end,
+                      typename Clock::time_point &time_point) -> std::size_t {
+    while (next < end) {
+      const std::size_t line = next;
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const char *const last = data.data() + data.size();
+      const char *newline = detail::find_newline(data.data() + line, last);
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto size = static_cast<std::size_t>(newline - data.data()) - line;
+      next = newline == last ? data.size() : line + size + 1;
+      string_view record = data.substr(line, size);
+      if (!record.empty() && record[record.size() - 1] == '\r') {
+        record = record.substr(0, record.size() - 1);
+      }
+      const std::size_t start = detail::field_start(record, field_);
+      if (start == string_view::npos) {
+        continue;
+      }
+      ++probes_;
+      detail::tm time_struct{};
+      if (detail::get_time(time_struct, format_, record.substr(start)) ==
+              std::errc{} &&
+          detail::to_time_point<Clock>(time_point, time_struct) ==
+              std::errc{}) {
+        return line;
+      }
+    }
+    return end;
+  }
+
+  Format format_;
+  record_field field_;
+  typename Clock::duration tolerance_;
+  std::size_t probes_{};
+};
+
+/**
+ * @brief Creates a time_seeker for a format string.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The timestamp format, whose characters must outlive the
+ * seeker.
+ * @param field Where the timestamp starts in each line.
+ * @param tolerance How far out of order lines may be.
+ * @return time_seeker<Clock> The seeker.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto make_time_seeker(string_view format, record_field field = at_offset(0),
+                      typename Clock::duration tolerance = {})
+    -> time_seeker<Clock> {
+  return time_seeker<Clock>{format, field, tolerance};
+}
+
+/**
+ * @brief Creates a time_seeker for a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The compiled format.
+ * @param field Where the timestamp starts in each line.
+ * @param tolerance How far out of order lines may be.
+ * @return time_seeker<Clock, compiled_format<N>> The seeker.
+ */
+template <typename Clock = std::chrono::system_clock, std::size_t N>
+auto make_time_seeker(const compiled_format<N> &format,
+                      record_field field = at_offset(0),
+                      typename Clock::duration tolerance = {})
+    -> time_seeker<Clock, compiled_format<N>> {
+  return time_seeker<Clock, compiled_format<N>>{format, field, tolerance};
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_SEEK_HPP
@@ -0,0 +1,329 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_STREAM_HPP
+#define MGUTILITY_CHRONO_STREAM_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/mapped_file.hpp"
+#include "mgutility/chrono/parse.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Where the timestamp of a record starts: a byte offset into the
+ * record, or into one of its delimited columns.
+ */
+struct record_field {
+  std::size_t offset; ///< Byte offset from the start of the record or column.
+  std::size_t column; ///< Index of the column holding the timestamp.
+  char delimiter;     ///< Column delimiter; every occurrence starts a column.
+};
+
+/**
+ * @brief Locates the timestamp at a byte offset of each record.
+ *
+ * @param offset The byte offset.
+ * @return record_field The field.
+ */
+constexpr auto at_offset(std::size_t offset) noexcept -> record_field {
+  return record_field{offset, 0, ' '};
+}
+
+/**
+ * @brief Locates the timestamp at the start of a delimited column of each
+ * record, e.g. at_column(2, ',') for the third field of a CSV line.
+ *
+ * @param column The index of the column.
+ * @param delimiter The column delimiter.
+ * @return record_field The field.
+ */
+constexpr auto at_column(std::size_t column, char delimiter = ' ') noexcept
+    -> record_field {
+  return record_field{0, column, delimiter};
+}
+
+namespace detail {
+
+/**
+ * @brief Finds the first newline in a range. memchr is vectorized by the C
+ * library and outperforms a hand-written SSE2 loop on typical log lines.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @return const char* The newline, or last if there is none.
+ */
+inline auto find_newline(const char *first, const char *last) noexcept
+    -> const char * {
+  // memchr() must not be given a null pointer, even with a zero length
+  if (first == last) {
+    return last;
+  }
+  const void *found =
+      std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+  return found != nullptr ? static_cast<const char *>(found) : last;
+}
+
+/**
+ * @brief Finds where the timestamp of a record starts.
+ *
+ * @param record The record, without its newline.
+ * @param field Where the timestamp starts in each record.
+ * @return std::size_t The offset of the timestamp, or string_view::npos if
+ * the record has too few columns or is too short.
+ */
+inline auto field_start(string_view record, const record_field &field) noexcept
+    -> std::size_t {
+  std::size_t start = 0;
+  for (std::size_t column = 0; column < field.column; ++column) {
+    start = record.find(field.delimiter, start);
+    if (start == string_view::npos) {
+      return string_view::npos;
+    }
+    ++start;
+  }
+  return start + field.offset > record.size() ? string_view::npos
+                                              : start + field.offset;
+}
+
+/**
+ * @brief Callback that ignores records that failed to parse.
+ */
+struct ignore_errors {
+  void operator()(string_view /*record*/, parse_result /*result*/) const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @brief Splits input into newline-terminated records and parses the
+ * timestamp of each one.
+ *
+ * Input is given as a sequence of chunks, e.g. reads from a socket or pages
+ * of a file. Records that lie within a chunk are parsed in place; only a
+ * record that straddles two chunks is copied, once. A trailing "\r" is
+ * removed from every record.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @tparam Format The format type, string_view or a compiled_format.
+ */
+template <typename Clock = std::chrono::system_clock,
+          typename Format = string_view>
+class record_reader {
+public:
+  /**
+   * @brief Constructs a reader.
+   *
+   * @param format The timestamp format. A string_view format must refer to
+   * characters that outlive the reader.
+   * @param field Where the timestamp starts in each record.
+   */
+  explicit record_reader(const Format &format,
+                         record_field field = at_offset(0))
+      : format_(format), field_(field) {}
+
+  /**
+   * @brief Processes a chunk of input.
+   *
+   * Calls on_record(time_point, rest) for every complete record whose
+   * timestamp parses, where rest is the remainder of the record after the
+   * timestamp and the character following it, and on_error(record, result)
+   * for every other complete record. The views are only valid during the
+   * call. An incomplete last record is kept until the next chunk or
+   * finish().
+   *
+   * @param chunk The input, which need not outlive the call.
+   * @param on_record The record callback.
+   * @param on_error The error callback.
+   * @return std::size_t The number of complete records in the chunk.
+   */
+  template <typename OnRecord, typename OnError = detail::ignore_errors>
+  auto feed(string_view chunk, OnRecord &&on_record,
+            OnError &&on_error = OnError{}) -> std::size_t {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char *first = chunk.data();
+    const char *const last = chunk.data() + chunk.size();
+    std::size_t count = 0;
+    if (!carry_.empty()) {
+      const char *newline = detail::find_newline(first, last);
+      carry_.append(first, newline);
+      if (newline == last) {
+        return 0;
+      }
+      process(string_view{carry_.data(), carry_.size()}, on_record, on_error);
+      carry_.clear();
+      first = newline + 1;
+      ++count;
+    }
+    for (;;) {
+      const char *newline = detail::find_newline(first, last);
+      if (newline == last) {
+        break;
+      }
+      process(string_view{first, static_cast<std::size_t>(newline - first)},
+              on_record, on_error);
+      first = newline + 1;
+      ++count;
+    }
+    carry_.assign(first, last);
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return count;
+  }
+
+  /**
+   * @brief Processes the last record if the input did not end with a
+   * newline.
+   *
+   * @param on_record The record callback.
+   * @param on_error The error callback.
+   * @return std::size_t The number of records processed, 0 or 1.
+   */
+  template <typename OnRecord, typename OnError = detail::ignore_errors>
+  auto finish(OnRecord &&on_record, OnError &&on_error = OnError{})
+      -> std::size_t {
+    if (carry_.empty()) {
+      return 0;
+    }
+    process(string_view{carry_.data(), carry_.size()}, on_record, on_error);
+    carry_.clear();
+    return 1;
+  }
+
+  /**
+   * @brief Returns the number of records whose timestamp parsed.
+   */
+  auto records() const noexcept -> std::size_t { return records_; }
+
+  /**
+   * @brief Returns the number of records whose timestamp did not parse.
+   */
+  auto failures() const noexcept -> std::size_t { return failures_; }
+
+private:
+  template <typename OnRecord, typename OnError>
+  void process(string_view record, OnRecord &on_record, OnError &on_error) {
+    if (!record.empty() && record[record.size() - 1] == '\r') {
+      record = record.substr(0, record.size() - 1);
+    }
+    const std::size_t start = detail::field_start(record, field_);
+    if (start == string_view::npos) {
+      ++failures_;
+      on_error(record, parse_result{std::errc::invalid_argument,
+                                    static_cast<uint32_t>(record.size()), '\0',
+                                    parse_stage::separator});
+      return;
+    }
+
+    typename Clock::time_point time_point{};
+    detail::tm time_struct{};
+    parse_result result = detail::to_time_point<Clock>(
+        time_point, time_struct,
+        detail::get_time(time_struct, format_, record.substr(start),
+                         diagnostics_t{}));
+    result.position += static_cast<uint32_t>(start);
+    if (!result.ok()) {
+      ++failures_;
+      on_error(record, result);
+      return;
+    }
+    ++records_;
+    on_record(time_point, record.substr(result.position));
+  }
+
+  Format format_;
+  record_field field_;
+  std::string carry_;
+  std::size_t records_{};
+  std::size_t failures_{};
+};
+
+/**
+ * @brief Creates a record_reader for a format string.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The timestamp format, whose characters must outlive the
+ * reader.
+ * @param field Where the timestamp starts in each record.
+ * @return record_reader<Clock> The reader.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto make_record_reader(string_view format,
+                        record_field field = at_offset(0))
+    -> record_reader<Clock> {
+  return record_reader<Clock>{format, field};
+}
+
+/**
+ * @brief Creates a record_reader for a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The compiled format.
+ * @param field Where the timestamp starts in each record.
+ * @return record_reader<Clock, compiled_format<N>> The reader.
+ */
+template <typename Clock = std::chrono::system_clock, std::size_t N>
+auto make_record_reader(const compiled_format<N> &format,
+                        record_field field = at_offset(0))
+    -> record_reader<Clock, compiled_format<N>> {
+  return record_reader<Clock, compiled_format<N>>{format, field};
+}
+
+/**
+ * @brief Memory-maps a file and gives each of its lines to a record_reader.
+ *
+ * @param path The file path.
+ * @param reader The reader, which also counts the records and failures.
+ * @param on_record Called as on_record(time_point, rest) for every line
+ * whose timestamp parses.
+ * @param on_error Called as on_error(line, parse_result) for every other
+ * line.
+ * @return std::errc An error code indicating whether the file could be read.
+ */
+template <typename Clock, typename Format, typename OnRecord,
+          typename OnError = detail::ignore_errors>
+auto read_records(string_view path, record_reader<Clock, Format> &reader,
+                  OnRecord &&on_record, OnError &&on_error = OnError{})
+    -> std::errc {
+  mapped_file file;
+  const auto error = mapped_file::open(path, file, true);
+  if (error != std::errc{}) {
+    return error;
+  }
+  reader.feed(file.view(), on_record, on_error);
+  reader.finish(on_record, on_error);
+  return std::errc{};
+}
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_STREAM_HPP
@@ -0,0 +1,1203 @@
+/*
+ * MIT License
+ *
+ * (c) 2023 Muhammed Galib Uludag
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MGUTILITY_CHRONO_TZ_HPP
+#define MGUTILITY_CHRONO_TZ_HPP
+
+// trunk-ignore-all(clang-format)
+
+#include "mgutility/chrono/mapped_file.hpp"
+#include "mgutility/chrono/parse.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// NOLINTBEGIN(modernize-concat-nested-namespaces)
+namespace mgutility {
+namespace chrono {
+namespace detail {
+// NOLINTEND(modernize-concat-nested-namespaces)
+
+/**
+ * @brief Header of a compiled zone database image.
+ *
+ * The image is the header followed by the zone records sorted by name, the
+ * transitions of all zones, the abbreviation records sorted by name, a hash
+ * index over both names and the zone names. Every section is 8-byte aligned
+ * and stored in host byte order, so an image is only portable between hosts
+ * of the same endianness.
+ */
+struct tzdb_header {
+  char magic[8];               ///< "MGTZDB1".
+  uint64_t size;               ///< Size of the whole image in bytes.
+  uint32_t zone_count;         ///< Number of zone records.
+  uint32_t transition_count;   ///< Number of transitions.
+  uint32_t abbreviation_count; ///< Number of abbreviation records.
+  uint32_t string_size;        ///< Size of the zone names in bytes.
+  uint32_t index_size;         ///< Number of hash index slots, a power of 2.
+  uint32_t reserved;           ///< Padding, always 0.
+};
+
+/**
+ * @brief A change of UTC offset. Transitions that keep the offset are dropped.
+ */
+struct tz_transition {
+  int64_t utc;    ///< Instant of the transition, in seconds since the epoch.
+  int32_t before; ///< UTC offset in seconds before the transition.
+  int32_t after;  ///< UTC offset in seconds from the transition on.
+};
+
+/**
+ * @brief A POSIX TZ rule date: Mm.w.d, Jn or n, followed by /time.
+ */
+struct tz_rule_date {
+  uint8_t kind;    ///< 'M', 'J', 'n', or 0 if the rule has no DST.
+  uint8_t month;   ///< Month [1, 12] for 'M'.
+  uint8_t week;    ///< Week [1, 5] for 'M', 5 meaning the last one.
+  uint8_t weekday; ///< Weekday [0, 6] for 'M', 0 meaning Sunday.
+  uint16_t day;    ///< Day [1, 365] for 'J', [0, 365] for 'n'.
+  int32_t time;    ///< Local time of day of the change, in seconds.
+};
+
+/**
+ * @brief The POSIX TZ rule that applies after the last transition of a zone.
+ */
+struct tz_posix_rule {
+  int32_t std_offset; ///< Standard UTC offset in seconds.
+  int32_t dst_offset; ///< Daylight saving UTC offset in seconds.
+  tz_rule_date start; ///< Start of daylight saving time, in standard time.
+  tz_rule_date end;   ///< End of daylight saving time, in daylight time.
+};
+
+/**
+ * @brief A zone of a compiled zone database image.
+ */
+struct tz_zone_record {
+  uint32_t name_offset;      ///< Offset of the name in the string section.
+  uint32_t name_size;        ///< Size of the name.
+  uint32_t first_transition; ///< Index of the first transition.
+  uint32_t transition_count; ///< Number of transitions.
+  int32_t initial_offset;    ///< UTC offset before the first transition.
+  uint32_t reserved;         ///< Padding, always 0.
+  tz_posix_rule rule;        ///< Rule after the last transition.
+};
+
+/**
+ * @brief A time zone abbreviation such as CET, with its current offset.
+ */
+struct tz_abbreviation_record {
+  char name[8];       ///< Null-terminated abbreviation.
+  int32_t offset;     ///< UTC offset in seconds.
+  uint32_t ambiguous; ///< Non-zero if zones disagree on the offset.
+};
+
+/**
+ * @brief Hash index slots refer to an abbreviation record if this bit is set,
+ * otherwise to a zone record. Slot value 0 is empty; others hold index + 1.
+ */
+constexpr uint32_t tz_index_abbreviation = 0x80000000U;
+
+/**
+ * @brief Hashes a zone name or abbreviation for the index (32-bit FNV-1a).
+ *
+ * @param name The name.
+ * @return uint32_t The hash.
+ */
+inline auto name_hash(string_view name) noexcept -> uint32_t {
+  uint32_t hash = 2166136261U;
+  for (const char chr : name) {
+    hash = (hash ^ static_cast<unsigned char>(chr)) * 16777619U;
+  }
+  return hash;
+}
+
+/**
+ * @brief Returns the name of an abbreviation record.
+ */
+inline auto abbreviation_name(const tz_abbreviation_record &record) noexcept
+    -> string_view {
+  std::size_t size = 0;
+  while (size < sizeof(record.name) && record.name[size] != '\0') { // NOLINT
+    ++size;
+  }
+  return string_view{&record.name[0], size};
+}
+
+/**
+ * @brief Returns the day of a POSIX TZ rule date in a year, in days since
+ * the epoch.
+ *
+ * @param date The rule date.
+ * @param year The year.
+ * @return int64_t Days since 1970-01-01.
+ */
+inline auto rule_day(const tz_rule_date &date, int32_t year) noexcept
+    -> int64_t {
+  const int32_t january_first = days_from_civil(year, 1, 1);
+  if (date.kind == 'J') {
+    return january_first + date.day - 1 +
+           (is_leap_year(year) && date.day >= 60 ? 1 : 0);
+  }
+  if (date.kind == 'n') {
+    return january_first + date.day;
+  }
+  const int32_t first = days_from_civil(year, date.month, 1);
+  // 1970-01-01 was a Thursday
+  const auto weekday =
+      static_cast<int32_t>(first + 4 - (floor_div(first + 4, 7) * 7));
+  int32_t day = first + ((date.weekday - weekday + 7) % 7) + ((date.week - 1) * 7);
+  const int32_t last = first + days_in_month(year, date.month - 1) - 1;
+  while (day > last) {
+    day -= 7;
+  }
+  return day;
+}
+
+/**
+ * @brief Evaluates a POSIX TZ rule at an instant.
+ *
+ * @param rule The rule.
+ * @param utc Seconds since the epoch.
+ * @return int32_t The UTC offset in seconds.
+ */
+inline auto rule_offset_at(const tz_posix_rule &rule, int64_t utc) noexcept
+    -> int32_t {
+  if (rule.start.kind == 0) {
+    return rule.std_offset;
+  }
+  // Clamp to years [0, 9999], the range epoch_seconds() produces
+  const int64_t days = std::min<int64_t>(
+      std::max<int64_t>(floor_div(utc + rule.std_offset, 86400), -719528),
+      2932896);
+  int32_t year = 0;
+  uint32_t month = 0;
+  uint32_t day = 0;
+  civil_from_days(static_cast<int32_t>(days), year, month, day);
+  const int64_t start =
+      (rule_day(rule.start, year) * 86400) + rule.start.time - rule.std_offset;
+  const int64_t end =
+      (rule_day(rule.end, year) * 86400) + rule.end.time - rule.dst_offset;
+  // Southern hemisphere rules have daylight saving time across new year
+  const bool daylight = start < end ? utc >= start && utc < end
+                                    : utc < end || utc >= start;
+  return daylight ? rule.dst_offset : rule.std_offset;
+}
+
+} // namespace detail
+
+/**
+ * @brief A time zone of a tzdb. A cheap view that stays valid as long as the
+ * tzdb it was located in.
+ */
+class time_zone {
+public:
+  /**
+   * @brief Constructs an empty time zone, at UTC.
+   */
+  time_zone() noexcept = default;
+
+  /**
+   * @brief Constructs a view of a zone record.
+   *
+   * @param record The zone record.
+   * @param transitions The transitions of the zone.
+   * @param name The name of the zone.
+   */
+  time_zone(const detail::tz_zone_record *record,
+            const detail::tz_transition *transitions, string_view name) noexcept
+      : record_{record}, transitions_{transitions}, name_{name} {}
+
+  /**
+   * @brief Returns the name of the zone, e.g. Europe/Istanbul.
+   */
+  auto name() const noexcept -> string_view { return name_; }
+
+  /**
+   * @brief Returns the UTC offset at an instant.
+   *
+   * Looks the instant up in the transition table with a binary search, and
+   * evaluates the POSIX TZ rule of the zone after its last transition.
+   *
+   * @param utc Seconds since the epoch.
+   * @return int32_t The UTC offset in seconds.
+   */
+  auto offset_at(int64_t utc) const noexcept -> int32_t {
+    if (record_ == nullptr) {
+      return 0;
+    }
+    const uint32_t count = record_->transition_count;
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (count == 0 || utc >= transitions_[count - 1].utc) {
+      return count == 0 && record_->rule.start.kind == 0
+                 ? record_->initial_offset
+                 : detail::rule_offset_at(record_->rule, utc);
+    }
+    const detail::tz_transition *next = std::upper_bound(
+        transitions_, transitions_ + count, utc,
+        [](int64_t value, const detail::tz_transition &transition) {
+          return value < transition.utc;
+        });
+    return next == transitions_ ? record_->initial_offset : (next - 1)->after;
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+
+  /**
+   * @brief Returns the UTC offset of a local time.
+   *
+   * A local time repeated by a backward transition resolves to the earliest
+   * instant, and a local time skipped by a forward transition uses the offset
+   * before the transition, i.e. it is shifted forward by the gap. Offsets are
+   * probed one day either side, so transitions less than two days apart are
+   * not told apart.
+   *
+   * @param local Local time in seconds since the local epoch.
+   * @return int32_t The UTC offset in seconds.
+   */
+  auto offset_from_local(int64_t local) const noexcept -> int32_t {
+    const int32_t before = offset_at(local - 86400);
+    const int32_t after = offset_at(local + 86400);
+    if (before == after) {
+      return before;
+    }
+    const bool before_valid = offset_at(local - before) == before;
+    const bool after_valid = offset_at(local - after) == after;
+    if (before_valid && after_valid) {
+      return std::max(before, after);
+    }
+    return after_valid ? after : before;
+  }
+
+private:
+  const detail::tz_zone_record *record_{};
+  const detail::tz_transition *transitions_{};
+  string_view name_{};
+};
+
+namespace detail {
+
+/**
+ * @brief A zone read from a TZif file, before it is packed into an image.
+ */
+struct tz_source_zone {
+  std::string name;                       ///< Name of the zone.
+  std::vector<tz_transition> transitions; ///< Offset changes.
+  int32_t initial_offset;                 ///< Offset before the first change.
+  tz_posix_rule rule;                     ///< Rule after the last change.
+  std::string std_name;                   ///< Current standard abbreviation.
+  std::string dst_name;                   ///< Current daylight abbreviation.
+};
+
+/**
+ * @brief Reads a big-endian integer of a TZif file.
+ *
+ * @param content The file content.
+ * @param position The position of the integer.
+ * @param size The size of the integer, 4 or 8.
+ * @return int64_t The sign-extended value.
+ */
+inline auto read_big_endian(const std::vector<char> &content,
+                            std::size_t position, std::size_t size) noexcept
+    -> int64_t {
+  uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value = (value << 8) | static_cast<unsigned char>(content[position + i]);
+  }
+  return size == 4 ? static_cast<int64_t>(static_cast<int32_t>(value))
+                   : static_cast<int64_t>(value);
+}
+
+/**
+ * @brief Parses an up to three digit number of a POSIX TZ string.
+ */
+inline auto parse_posix_number(const std::string &str, std::size_t &pos,
+                               int32_t &value) noexcept -> bool {
+  const std::size_t begin = pos;
+  value = 0;
+  while (pos < str.size() && pos - begin < 3 &&
+         mgutility::detail::is_digit(str[pos])) {
+    value = (value * 10) + (str[pos++] - '0');
+  }
+  return pos != begin;
+}
+
+/**
+ * @brief Parses a [+-]hh[:mm[:ss]] offset or time of a POSIX TZ string.
+ */
+inline auto parse_posix_time(const std::string &str, std::size_t &pos,
+                             int32_t &seconds) noexcept -> bool {
+  const bool negative = pos < str.size() && str[pos] == '-';
+  pos += pos < str.size() && (str[pos] == '-' || str[pos] == '+') ? 1 : 0;
+  int32_t fields[3] = {0, 0, 0}; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+  for (int32_t &field : fields) {
+    if (!parse_posix_number(str, pos, field)) {
+      return false;
+    }
+    if (pos >= str.size() || str[pos] != ':') {
+      break;
+    }
+    ++pos;
+  }
+  seconds = (fields[0] * 3600) + (fields[1] * 60) + fields[2];
+  seconds = negative ? -seconds : seconds;
+  return true;
+}
+
+/**
+ * @brief Parses an abbreviation of a POSIX TZ string, alphabetic or quoted
+ * in angle brackets.
+ */
+inline auto parse_posix_name(const std::string &str, std::size_t &pos,
+                             std::string &name) -> bool {
+  if (pos < str.size() && str[pos] == '<') {
+    const std::size_t close = str.find('>', pos);
+    if (close == std::string::npos) {
+      return false;
+    }
+    name = str.substr(pos + 1, close - pos - 1);
+    pos = close + 1;
+    return !name.empty();
+  }
+  const std::size_t begin = pos;
+  while (pos < str.size() &&
+         ((str[pos] >= 'A' && str[pos] <= 'Z') ||
+          (str[pos] >= 'a' && str[pos] <= 'z'))) {
+    ++pos;
+  }
+  name = str.substr(begin, pos - begin);
+  return name.size() >= 3;
+}
+
+/**
+ * @brief Parses a Mm.w.d, Jn or n rule date and its optional /time.
+ */
+inline auto parse_posix_date(const std::string &str, std::size_t &pos,
+                             tz_rule_date &date) noexcept -> bool {
+  int32_t value = 0;
+  date = tz_rule_date{};
+  if (pos < str.size() && str[pos] == 'M') {
+    int32_t month = 0;
+    int32_t week = 0;
+    ++pos;
+    if (!parse_posix_number(str, pos, month) || pos >= str.size() ||
+        str[pos++] != '.' || !parse_posix_number(str, pos, week) ||
+        pos >= str.size() || str[pos++] != '.' ||
+        !parse_posix_number(str, pos, value) || month < 1 || month > 12 ||
+        week < 1 || week > 5 || value > 6) {
+      return false;
+    }
+    date.kind = 'M';
+    date.month = static_cast<uint8_t>(month);
+    date.week = static_cast<uint8_t>(week);
+    date.weekday = static_cast<uint8_t>(value);
+  } else {
+    const bool julian = pos < str.size() && str[pos] == 'J';
+    pos += julian ? 1 : 0;
+    if (!parse_posix_number(str, pos, value) || value > 365 ||
+        (julian && value < 1)) {
+      return false;
+    }
+    date.kind = julian ? 'J' : 'n';
+    date.day = static_cast<uint16_t>(value);
+  }
+  date.time = 7200;
+  if (pos < str.size() && str[pos] == '/') {
+    ++pos;
+    return parse_posix_time(str, pos, date.time);
+  }
+  return true;
+}
+
+/**
+ * @brief Parses the POSIX TZ string of a TZif footer, e.g.
+ * EST5EDT,M3.2.0,M11.1.0.
+ *
+ * @param str The TZ string.
+ * @param zone The zone whose rule and abbreviations to populate.
+ * @return bool False if the string is malformed.
+ */
+inline auto parse_posix_rule(const std::string &str, tz_source_zone &zone)
+    -> bool {
+  std::size_t pos = 0;
+  int32_t offset = 0;
+  tz_posix_rule &rule = zone.rule;
+  // POSIX offsets count hours west of Greenwich
+  if (!parse_posix_name(str, pos, zone.std_name) ||
+      !parse_posix_time(str, pos, offset)) {
+    return false;
+  }
+  rule.std_offset = -offset;
+  rule.dst_offset = -offset;
+  rule.start = tz_rule_date{};
+  rule.end = tz_rule_date{};
+  if (pos == str.size()) {
+    return true;
+  }
+  if (!parse_posix_name(str, pos, zone.dst_name)) {
+    return false;
+  }
+  rule.dst_offset = rule.std_offset + 3600;
+  if (pos < str.size() && str[pos] != ',') {
+    if (!parse_posix_time(str, pos, offset)) {
+      return false;
+    }
+    rule.dst_offset = -offset;
+  }
+  if (pos == str.size()) {
+    // The POSIX default, the United States rules
+    const std::string default_rules = ",M3.2.0,M11.1.0";
+    std::size_t default_pos = 0;
+    return parse_posix_date(default_rules, ++default_pos, rule.start) &&
+           parse_posix_date(default_rules, ++default_pos, rule.end);
+  }
+  if (str[pos++] != ',' || !parse_posix_date(str, pos, rule.start) ||
+      pos >= str.size() || str[pos++] != ',' ||
+      !parse_posix_date(str, pos, rule.end)) {
+    return false;
+  }
+  return pos == str.size();
+}
+
+/**
+ * @brief Reads a TZif file (RFC 8536), versions 1 to 4.
+ *
+ * @param content The file content.
+ * @param zone The zone to populate, except for its name.
+ * @return bool False if the content is not a valid TZif file.
+ */
+inline auto read_tzif(const std::vector<char> &content, tz_source_zone &zone)
+    -> bool {
+  constexpr std::size_t header_size = 44;
+  std::size_t header = 0;
+  std::size_t time_size = 4;
+  for (;;) {
+    if (content.size() < header + header_size ||
+        std::memcmp(&content[header], "TZif", 4) != 0) {
+      return false;
+    }
+    if (time_size == 8 || content[header + 4] < '2') {
+      break;
+    }
+    // Skip the 32-bit block of a version 2+ file
+    std::size_t counts[6]; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    for (std::size_t i = 0; i < 6; ++i) {
+      counts[i] = static_cast<uint32_t>(
+          read_big_endian(content, header + 20 + (i * 4), 4));
+    }
+    header += header_size + (counts[3] * 5) + (counts[4] * 6) + counts[5] +
+              (counts[2] * 8) + counts[1] + counts[0];
+    time_size = 8;
+  }
+
+  const auto count = [&](std::size_t index) {
+    return static_cast<std::size_t>(static_cast<uint32_t>(
+        read_big_endian(content, header + 20 + (index * 4), 4)));
+  };
+  const std::size_t leap_count = count(2);
+  const std::size_t time_count = count(3);
+  const std::size_t type_count = count(4);
+  const std::size_t data = header + header_size;
+  const std::size_t indices = data + (time_count * time_size);
+  const std::size_t types = indices + time_count;
+  const std::size_t end = types + (type_count * 6) + count(5) +
+                          (leap_count * (time_size + 4)) + count(1) + count(0);
+  if (type_count == 0 || content.size() < end) {
+    return false;
+  }
+
+  const auto type_offset = [&](std::size_t type) {
+    return static_cast<int32_t>(read_big_endian(content, types + (type * 6), 4));
+  };
+  zone.initial_offset = type_offset(0);
+  zone.transitions.clear();
+  int32_t previous = zone.initial_offset;
+  for (std::size_t i = 0; i < time_count; ++i) {
+    const auto type = static_cast<unsigned char>(content[indices + i]);
+    if (type >= type_count) {
+      return false;
+    }
+    const int32_t offset = type_offset(type);
+    if (offset != previous) {
+      zone.transitions.push_back(tz_transition{
+          read_big_endian(content, data + (i * time_size), time_size),
+          previous, offset});
+      previous = offset;
+    }
+  }
+
+  // Without a footer the last offset stays in effect
+  zone.rule = tz_posix_rule{previous, previous, tz_rule_date{}, tz_rule_date{}};
+  zone.std_name.clear();
+  zone.dst_name.clear();
+  if (time_size == 8 && end < content.size() && content[end] == '\n') {
+    const auto newline = std::find(content.begin() + static_cast<std::ptrdiff_t>(end) + 1,
+                                   content.end(), '\n');
+    const std::string footer(content.begin() + static_cast<std::ptrdiff_t>(end) + 1,
+                             newline);
+    if (!footer.empty() && !parse_posix_rule(footer, zone)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Reads every TZif file under a directory, recursively.
+ *
+ * Skips dotfiles, non-TZif files such as zone.tab, and the posix/ and right/
+ * trees, which duplicate the top level or count leap seconds.
+ *
+ * @param directory The directory to read.
+ * @param prefix The zone name prefix of the directory, e.g. "America/".
+ * @param zones The zones read.
+ */
+inline void collect_zones(const std::string &directory,
+                          const std::string &prefix,
+                          std::vector<tz_source_zone> &zones) {
+#if !defined(_WIN32)
+  DIR *handle = ::opendir(directory.c_str());
+  if (handle == nullptr) {
+    return;
+  }
+  std::vector<char> content;
+  while (const dirent *entry = ::readdir(handle)) { // NOLINT(concurrency-mt-unsafe)
+    const std::string name = entry->d_name;       // NOLINT
+    if (name.empty() || name[0] == '.' ||
+        (prefix.empty() && (name == "posix" || name == "right"))) {
+      continue;
+    }
+    const std::string path = directory + '/' + name;
+    struct stat status {};
+    if (::stat(path.c_str(), &status) != 0) {
+      continue;
+    }
+    if (S_ISDIR(status.st_mode)) { // NOLINT(hicpp-signed-bitwise)
+      collect_zones(path, prefix + name + '/', zones);
+      continue;
+    }
+    tz_source_zone zone{};
+    if (S_ISREG(status.st_mode) && // NOLINT(hicpp-signed-bitwise)
+        read_file(path, content) && read_tzif(content, zone)) {
+      zone.name = prefix + name;
+      zones.push_back(std::move(zone));
+    }
+  }
+  ::closedir(handle);
+#else
+  (void)directory;
+  (void)prefix;
+  (void)zones;
+#endif
+}
+
+/**
+ * @brief Appends a trivially copyable record to an image.
+ */
+template <typename T> void append_record(std::vector<char> &image, const T &record) {
+  const std::size_t position = image.size();
+  image.resize(position + sizeof(T));
+  std::memcpy(&image[position], &record, sizeof(T));
+}
+
+/**
+ * @brief Packs zones into a database image.
+ *
+ * @param zones The zones, sorted by name in place.
+ * @param image The image.
+ */
+inline void build_image(std::vector<tz_source_zone> &zones,
+                        std::vector<char> &image) {
+  std::sort(zones.begin(), zones.end(),
+            [](const tz_source_zone &lhs, const tz_source_zone &rhs) {
+              return lhs.name < rhs.name;
+            });
+
+  // An abbreviation maps to an offset only if every zone agrees on it
+  std::map<std::string, std::pair<int32_t, bool>> abbreviations;
+  const auto add_abbreviation = [&](const std::string &name, int32_t offset) {
+    if (name.size() < 3 || name.size() >= sizeof(tz_abbreviation_record::name) ||
+        !std::all_of(name.begin(), name.end(), [](char chr) {
+          return (chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z');
+        })) {
+      return;
+    }
+    const auto inserted =
+        abbreviations.insert(std::make_pair(name, std::make_pair(offset, false)));
+    if (!inserted.second && inserted.first->second.first != offset) {
+      inserted.first->second.second = true;
+    }
+  };
+
+  tzdb_header header{};
+  std::memcpy(header.magic, "MGTZDB1", sizeof(header.magic));
+  header.zone_count = static_cast<uint32_t>(zones.size());
+  std::string strings;
+  for (const tz_source_zone &zone : zones) {
+    header.transition_count += static_cast<uint32_t>(zone.transitions.size());
+    strings += zone.name;
+    add_abbreviation(zone.std_name, zone.rule.std_offset);
+    if (zone.rule.start.kind != 0) {
+      add_abbreviation(zone.dst_name, zone.rule.dst_offset);
+    }
+  }
+  strings.resize((strings.size() + 7) / 8 * 8, '\0');
+  header.abbreviation_count = static_cast<uint32_t>(abbreviations.size());
+  header.string_size = static_cast<uint32_t>(strings.size());
+
+  // Open addressing with linear probing, at most half full
+  header.index_size = 2;
+  while (header.index_size < 2 * (zones.size() + abbreviations.size())) {
+    header.index_size *= 2;
+  }
+  std::vector<uint32_t> index(header.index_size, 0);
+  const auto add_index = [&](const std::string &name, uint32_t value) {
+    uint32_t slot = name_hash(name) & (header.index_size - 1);
+    while (index[slot] != 0) {
+      slot = (slot + 1) & (header.index_size - 1);
+    }
+    index[slot] = value;
+  };
+  for (uint32_t i = 0; i < header.zone_count; ++i) {
+    add_index(zones[i].name, i + 1);
+  }
+  uint32_t abbreviation_index = 0;
+  for (const auto &abbreviation : abbreviations) {
+    add_index(abbreviation.first, tz_index_abbreviation | ++abbreviation_index);
+  }
+
+  header.size = sizeof(tzdb_header) + (zones.size() * sizeof(tz_zone_record)) +
+                (header.transition_count * sizeof(tz_transition)) +
+                (abbreviations.size() * sizeof(tz_abbreviation_record)) +
+                (index.size() * sizeof(uint32_t)) + strings.size();
+
+  image.clear();
+  image.reserve(static_cast<std::size_t>(header.size));
+  append_record(image, header);
+  uint32_t name_offset = 0;
+  uint32_t first_transition = 0;
+  for (const tz_source_zone &zone : zones) {
+    const tz_zone_record record{name_offset,
+                                static_cast<uint32_t>(zone.name.size()),
+                                first_transition,
+                                static_cast<uint32_t>(zone.transitions.size()),
+                                zone.initial_offset,
+                                0,
+                                zone.rule};
+    append_record(image, record);
+    name_offset += record.name_size;
+    first_transition += record.transition_count;
+  }
+  for (const tz_source_zone &zone : zones) {
+    for (const tz_transition &transition : zone.transitions) {
+      append_record(image, transition);
+    }
+  }
+  for (const auto &abbreviation : abbreviations) {
+    tz_abbreviation_record record{};
+    std::memcpy(record.name, abbreviation.first.data(), abbreviation.first.size());
+    record.offset = abbreviation.second.first;
+    record.ambiguous = abbreviation.second.second ? 1 : 0;
+    append_record(image, record);
+  }
+  for (const uint32_t slot : index) {
+    append_record(image, slot);
+  }
+  image.insert(image.end(), strings.begin(), strings.end());
+}
+
+/**
+ * @brief Checks that an image is well formed, so lookups need no bounds
+ * checks.
+ *
+ * @param data The image.
+ * @param size The size of the image.
+ * @return bool True if the image is valid.
+ */
+inline auto validate_image(const char *data, std::size_t size) noexcept
+    -> bool {
+  if (size < sizeof(tzdb_header)) {
+    return false;
+  }
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  const auto *header = reinterpret_cast<const tzdb_header *>(data);
+  if (std::memcmp(header->magic, "MGTZDB1", sizeof(header->magic)) != 0 ||
+      header->size != size ||
+      size != sizeof(tzdb_header) +
+                  (uint64_t{header->zone_count} * sizeof(tz_zone_record)) +
+                  (uint64_t{header->transition_count} * sizeof(tz_transition)) +
+                  (uint64_t{header->abbreviation_count} *
+                   sizeof(tz_abbreviation_record)) +
+                  (uint64_t{header->index_size} * sizeof(uint32_t)) +
+                  header->string_size ||
+      header->index_size < 2 ||
+      (header->index_size & (header->index_size - 1)) != 0) {
+    return false;
+  }
+  const auto *zones =
+      reinterpret_cast<const tz_zone_record *>(data + sizeof(tzdb_header));
+  for (uint32_t i = 0; i < header->zone_count; ++i) {
+    if (uint64_t{zones[i].name_offset} + zones[i].name_size > header->string_size ||
+        uint64_t{zones[i].first_transition} + zones[i].transition_count >
+            header->transition_count) {
+      return false;
+    }
+  }
+  const auto *index = reinterpret_cast<const uint32_t *>(
+      data + size - header->string_size - (header->index_size * sizeof(uint32_t)));
+  // Probing stops at an empty slot, so at least one must exist
+  bool has_empty_slot = false;
+  for (uint32_t i = 0; i < header->index_size; ++i) {
+    const uint32_t slot = index[i] & ~tz_index_abbreviation;
+    if (slot > ((index[i] & tz_index_abbreviation) != 0
+                    ? header->abbreviation_count
+                    : header->zone_count) ||
+        (slot == 0 && index[i] != 0)) {
+      return false;
+    }
+    has_empty_slot = has_empty_slot || index[i] == 0;
+  }
+  if (!has_empty_slot) {
+    return false;
+  }
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief A compact, sorted zone database compiled from TZif files.
+ *
+ * The database is a single read-only image, either owned or memory-mapped
+ * from a file written by save(), so it can be shared across threads without
+ * synchronization. Names are found through a hash index and offsets by a
+ * binary search over the transitions of a zone.
+ */
+class tzdb {
+public:
+  tzdb() noexcept = default;
+  tzdb(const tzdb &) = delete;
+  auto operator=(const tzdb &) -> tzdb & = delete;
+
+  tzdb(tzdb &&other) noexcept { swap(other); }
+
+  auto operator=(tzdb &&other) noexcept -> tzdb & {
+    tzdb moved{std::move(other)};
+    swap(moved);
+    return *this;
+  }
+
+  ~tzdb() = default;
+
+  /**
+   * @brief Compiles a database from a directory of TZif files.
+   *
+   * @param directory The directory, e.g. /usr/share/zoneinfo.
+   * @param database The compiled database.
+   * @return std::errc An error code indicating success or failure.
+   */
+  static auto compile(string_view directory, tzdb &database) -> std::errc {
+    std::vector<detail::tz_source_zone> zones;
+    detail::collect_zones(std::string(directory.data(), directory.size()), "",
+                          zones);
+    if (zones.empty()) {
+      return std::errc::no_such_file_or_directory;
+    }
+    tzdb compiled{};
+    detail::build_image(zones, compiled.buffer_);
+    compiled.data_ = compiled.buffer_.data();
+    compiled.size_ = compiled.buffer_.size();
+    database = std::move(compiled);
+    return std::errc{};
+  }
+
+  /**
+   * @brief Opens a database image written by save(), memory-mapping it.
+   *
+   * @param path The image path.
+   * @param database The opened database.
+   * @return std::errc An error code indicating success or failure.
+   */
+  static auto open(string_view path, tzdb &database) -> std::errc {
+    tzdb opened{};
+    const auto error = mapped_file::open(path, opened.file_);
+    if (error != std::errc{}) {
+      return error;
+    }
+    opened.data_ = opened.file_.data();
+    opened.size_ = opened.file_.size();
+    if (!detail::validate_image(opened.data_, opened.size_)) {
+      return std::errc::illegal_byte_sequence;
+    }
+    database = std::move(opened);
+    return std::errc{};
+  }
+
+  /**
+   * @brief Writes the database image to a file, to be opened by open().
+   *
+   * @param path The image path.
+   * @return std::errc An error code indicating success or failure.
+   */
+  auto save(string_view path) const -> std::errc {
+    std::FILE *file =
+        std::fopen(std::string(path.data(), path.size()).c_str(), "wb");
+    if (file == nullptr) {
+      return std::errc::permission_denied;
+    }
+    const bool written = std::fwrite(data_, 1, size_, file) == size_;
+    return std::fclose(file) == 0 && written ? std::errc{} : std::errc::io_error;
+  }
+
+  /**
+   * @brief Returns the number of zones.
+   */
+  auto zone_count() const noexcept -> std::size_t {
+    return data_ == nullptr ? 0 : header()->zone_count;
+  }
+
+  /**
+   * @brief Returns the size of the image in bytes.
+   */
+  auto size() const noexcept -> std::size_t { return size_; }
+
+  /**
+   * @brief Finds a zone by name, e.g. America/New_York.
+   *
+   * @param name The zone name.
+   * @param zone The zone found.
+   * @return std::errc An error code indicating success or failure.
+   */
+  auto locate_zone(string_view name, time_zone &zone) const noexcept
+      -> std::errc {
+    const uint32_t found = find(name, false);
+    if (found == 0) {
+      return std::errc::invalid_argument;
+    }
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const detail::tz_zone_record &record = zones()[found - 1];
+    zone = time_zone{&record, transitions() + record.first_transition,
+                     zone_name(record)};
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return std::errc{};
+  }
+
+  /**
+   * @brief Finds the offset of an abbreviation, e.g. CET or EST.
+   *
+   * Abbreviations are taken from the current rules of every zone; one that
+   * zones disagree on, such as IST or CST, is rejected as ambiguous.
+   *
+   * @param abbreviation The abbreviation.
+   * @param offset The UTC offset in seconds.
+   * @return std::errc An error code indicating success or failure.
+   */
+  auto abbreviation_offset(string_view abbreviation, int32_t &offset) const noexcept
+      -> std::errc {
+    const uint32_t found = find(abbreviation, true);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (found == 0 || abbreviations()[found - 1].ambiguous != 0) {
+      return std::errc::invalid_argument;
+    }
+    offset = abbreviations()[found - 1].offset; // NOLINT
+    return std::errc{};
+  }
+
+  /**
+   * @brief Resolves the UTC offset of a local time in a zone or at an
+   * abbreviation. Abbreviations take precedence, so CET means a fixed +01:00
+   * rather than the CET zone, which observes daylight saving time.
+   *
+   * @param name The zone name or abbreviation.
+   * @param local Local time in seconds since the local epoch.
+   * @param offset The UTC offset in seconds.
+   * @return std::errc An error code indicating success or failure.
+   */
+  auto offset_from_local(string_view name, int64_t local,
+                         int32_t &offset) const noexcept -> std::errc {
+    // Zone names other than the legacy ones at the top level contain '/'
+    if (name.find('/') == string_view::npos &&
+        abbreviation_offset(name, offset) == std::errc{}) {
+      return std::errc{};
+    }
+    time_zone zone{};
+    const auto error = locate_zone(name, zone);
+    if (error != std::errc{}) {
+      return error;
+    }
+    offset = zone.offset_from_local(local);
+    return std::errc{};
+  }
+
+private:
+  void swap(tzdb &other) noexcept {
+    buffer_.swap(other.buffer_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(file_, other.file_);
+  }
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  auto header() const noexcept -> const detail::tzdb_header * {
+    return reinterpret_cast<const detail::tzdb_header *>(data_);
+  }
+
+  auto zones() const noexcept -> const detail::tz_zone_record * {
+    return reinterpret_cast<const detail::tz_zone_record *>(
+        data_ + sizeof(detail::tzdb_header));
+  }
+
+  auto transitions() const noexcept -> const detail::tz_transition * {
+    return reinterpret_cast<const detail::tz_transition *>(
+        zones() + header()->zone_count);
+  }
+
+  auto abbreviations() const noexcept
+      -> const detail::tz_abbreviation_record * {
+    return reinterpret_cast<const detail::tz_abbreviation_record *>(
+        transitions() + header()->transition_count);
+  }
+
+  auto index() const noexcept -> const uint32_t * {
+    return reinterpret_cast<const uint32_t *>(
+        abbreviations() + header()->abbreviation_count);
+  }
+
+  auto zone_name(const detail::tz_zone_record &record) const noexcept
+      -> string_view {
+    return string_view{data_ + size_ - header()->string_size + record.name_offset,
+                       record.name_size};
+  }
+
+  /**
+   * @brief Looks a name up in the hash index.
+   *
+   * @param name The zone name or abbreviation.
+   * @param abbreviation Look up an abbreviation rather than a zone.
+   * @return uint32_t The record index + 1, or 0 if not found.
+   */
+  auto find(string_view name, bool abbreviation) const noexcept -> uint32_t {
+    if (data_ == nullptr) {
+      return 0;
+    }
+    const uint32_t mask = header()->index_size - 1;
+    const uint32_t kind = abbreviation ? detail::tz_index_abbreviation : 0;
+    for (uint32_t slot = detail::name_hash(name) & mask; index()[slot] != 0;
+         slot = (slot + 1) & mask) {
+      const uint32_t value = index()[slot];
+      if ((value & detail::tz_index_abbreviation) != kind) {
+        continue;
+      }
+      const uint32_t found = value & ~detail::tz_index_abbreviation;
+      if (abbreviation ? detail::abbreviation_name(abbreviations()[found - 1]) == name
+                       : zone_name(zones()[found - 1]) == name) {
+        return found;
+      }
+    }
+    return 0;
+  }
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+  std::vector<char> buffer_;
+  mapped_file file_;
+  const char *data_{};
+  std::size_t size_{};
+};
+
+/**
+ * @brief Returns the process-wide zone database, loaded on first use.
+ *
+ * Opens the image named by $MGUTILITY_CHRONO_TZDB if set, otherwise compiles
+ * $TZDIR or /usr/share/zoneinfo. The database is empty if neither exists.
+ *
+ * @return const tzdb& The shared, read-only database.
+ */
+inline auto get_tzdb() -> const tzdb & {
+  static const tzdb database = [] {
+    tzdb loaded{};
+    // NOLINTBEGIN(concurrency-mt-unsafe)
+    const char *image = std::getenv("MGUTILITY_CHRONO_TZDB");
+    const char *directory = std::getenv("TZDIR");
+    // NOLINTEND(concurrency-mt-unsafe)
+    if (image == nullptr || tzdb::open(image, loaded) != std::errc{}) {
+      tzdb::compile(directory != nullptr ? directory : "/usr/share/zoneinfo",
+                    loaded);
+    }
+    return loaded;
+  }();
+  return database;
+}
+
+namespace detail {
+
+/**
+ * @brief Converts a parsed tm structure into a time point, resolving a zone
+ * name parsed by %Z in a zone database.
+ *
+ * @tparam Clock The clock type.
+ * @param time_point The time point to populate.
+ * @param time_struct The parsed tm structure.
+ * @param database The zone database.
+ * @return std::errc An error code indicating success or failure.
+ */
+template <typename Clock>
+auto to_time_point(typename Clock::time_point &time_point,
+                   detail::tm &time_struct, const tzdb &database) -> std::errc {
+  if (time_struct.tm_has_offset || time_struct.tm_zone_name.empty() ||
+      is_utc_zone_name(time_struct.tm_zone_name)) {
+    return to_time_point<Clock>(time_point, time_struct);
+  }
+  int64_t local = 0;
+  auto error = detail::epoch_seconds(local, time_struct);
+  if (error != std::errc{}) {
+    return error;
+  }
+  int32_t offset = 0;
+  error = database.offset_from_local(time_struct.tm_zone_name, local, offset);
+  if (error != std::errc{}) {
+    return error;
+  }
+  error = check_leap_second(time_struct, local - offset);
+  if (error != std::errc{}) {
+    return error;
+  }
+  int64_t count = 0;
+  error = epoch_count<typename Clock::period>(local - offset,
+                                              time_struct.tm_ms, count);
+  return error != std::errc{} ? error
+                              : from_utc_count<Clock>(time_point, count,
+                                                      time_struct.tm_sec == 60);
+}
+
+} // namespace detail
+
+/**
+ * @brief Parses a date and time string whose %Z field names a time zone,
+ * e.g. Europe/Istanbul, or an abbreviation, e.g. CET.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @param database The zone database, usually get_tzdb().
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(typename Clock::time_point &time_point, string_view format,
+           string_view date_str, const tzdb &database) -> std::error_code {
+  detail::tm time_struct{};
+  auto error = detail::get_time(time_struct, format, date_str);
+  if (error != std::errc{}) {
+    return std::make_error_code(error);
+  }
+  error = detail::to_time_point<Clock>(time_point, time_struct, database);
+  return error != std::errc{} ? std::make_error_code(error)
+                              : std::error_code{};
+}
+
+/**
+ * @brief Parses a date and time string whose %Z field names a time zone
+ * using a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param time_point The time point to populate.
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @param database The zone database, usually get_tzdb().
+ * @return std::error_code An error code indicating success or failure.
+ */
+template <typename Clock = std::chrono::system_clock, std::size_t N>
+auto parse(typename Clock::time_point &time_point,
+           const compiled_format<N> &format, string_view date_str,
+           const tzdb &database) -> std::error_code {
+  detail::tm time_struct{};
+  auto error = detail::get_time(time_struct, format, date_str);
+  if (error != std::errc{}) {
+    return std::make_error_code(error);
+  }
+  error = detail::to_time_point<Clock>(time_point, time_struct, database);
+  return error != std::errc{} ? std::make_error_code(error)
+                              : std::error_code{};
+}
+
+#ifndef CHRONO_PARSE_NO_EXCEPTIONS
+/**
+ * @brief Parses a date and time string whose %Z field names a time zone.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The format string.
+ * @param date_str The date and time string to parse.
+ * @param database The zone database, usually get_tzdb().
+ * @throw std::system_error if parsing fails
+ * @return Clock::time_point The parsed time point.
+ */
+template <typename Clock = std::chrono::system_clock>
+auto parse(string_view format, string_view date_str, const tzdb &database) ->
+    typename Clock::time_point {
+  typename Clock::time_point time_point{};
+  auto error = parse<Clock>(time_point, format, date_str, database);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return time_point;
+}
+
+/**
+ * @brief Parses a date and time string whose %Z field names a time zone
+ * using a compiled format.
+ *
+ * @tparam Clock The clock type (defaults to std::chrono::system_clock).
+ * @param format The compiled format.
+ * @param date_str The date and time string to parse.
+ * @param database The zone database, usually get_tzdb().
+ * @throw std::system_error if parsing fails
+ * @return Clock::time_point The parsed time point.
+ */
+template <typename Clock = std::chrono::system_clock, std::size_t N>
+auto parse(const compiled_format<N> &format, string_view date_str,
+           const tzdb &database) -> typename Clock::time_point {
+  typename Clock::time_point time_point{};
+  auto error = parse<Clock>(time_point, format, date_str, database);
+  if (error) {
+    throw std::system_error(error);
+  }
+  return time_point;
+}
+#endif // CHRONO_PARSE_NO_EXCEPTIONS
+
+} // namespace chrono
+} // namespace mgutility
+
+#endif // MGUTILITY_CHRONO_TZ_HPP
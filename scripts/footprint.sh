@@ -0,0 +1,38 @@
+#!/bin/bash
+# Reports the code size and latency of parse_epoch() per specifier set, built
+# without exceptions. Extra flags, e.g. include paths, go in CXXFLAGS.
+#
+#   scripts/footprint.sh [compiler]
+
+set -e
+
+CXX=${1:-${CXX:-c++}}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=$(mktemp -d)
+trap 'rm -rf "${OUT}"' EXIT
+
+FLAGS="-std=c++17 -O2 -fno-exceptions -DCHRONO_PARSE_NO_EXCEPTIONS -I${ROOT}/include -I${ROOT}/mgutility/include ${CXXFLAGS}"
+
+# name|format|input|extra flags
+SETS=(
+  "date|{:%F}|2023-04-30|"
+  "date time|{:%FT%T}|2023-04-30T16:22:18|"
+  "fraction|{:%FT%T.%f}|2023-04-30T16:22:18.123456|"
+  "offset|{:%FT%T.%f%z}|2023-04-30T18:22:18.123+02:00|"
+  "am/pm|{:%Y-%m-%d %H:%M:%S %p}|2023-04-30 04:22:18 PM|"
+  "zone name|{:%F %T %Z}|2023-04-30 16:22:18 UTC|"
+  "runtime format|{:%FT%T.%f%z}|2023-04-30T18:22:18.123+02:00|-DFOOTPRINT_RUNTIME"
+)
+
+printf "%-16s %-28s %10s %10s\n" "set" "format" "text (B)" "ns/parse"
+for set in "${SETS[@]}"; do
+  IFS='|' read -r name format input extra <<< "${set}"
+  defines=(-DFOOTPRINT_FORMAT="\"${format}\"" -DFOOTPRINT_INPUT="\"${input}\"" ${extra})
+  # shellcheck disable=SC2086
+  ${CXX} ${FLAGS} "${defines[@]}" -DFOOTPRINT_NO_MAIN -c "${ROOT}/bench/footprint.cpp" -o "${OUT}/parse.o"
+  text=$(size -A "${OUT}/parse.o" | awk '$1 ~ /^\.text/ { sum += $2 } END { print sum }')
+  # shellcheck disable=SC2086
+  ${CXX} ${FLAGS} "${defines[@]}" "${ROOT}/bench/footprint.cpp" -o "${OUT}/footprint"
+  latency=$("${OUT}/footprint" | cut -d' ' -f1)
+  printf "%-16s %-28s %10s %10s\n" "${name}" "${format}" "${text}" "${latency}"
+done
@@ -0,0 +1,38 @@
+#!/bin/bash
+# Runs each plain (unsanitized) fuzz target for a fixed time and reports its
+# executions per second, a standing signal for the speed of the hot path.
+# The results are also written to <build dir>/fuzz_throughput.json.
+#
+#   scripts/fuzz_throughput.sh <build dir> [seconds]
+
+set -e
+
+BUILD=$(cd "${1:?usage: $0 <build dir> [seconds]}" && pwd)
+SECONDS_PER_TARGET=${2:-30}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=$(mktemp -d)
+trap 'rm -rf "${OUT}"' EXIT
+
+FUZZERS=(fuzz_chrono_parse fuzz_chrono_differential)
+
+printf "%-28s %12s %14s\n" "fuzzer" "execs" "execs/sec"
+json="["
+for fuzzer in "${FUZZERS[@]}"; do
+  # libFuzzer adds to its corpus, so every run starts from the same seeds
+  mkdir -p "${OUT}/${fuzzer}"
+  if [ -d "${ROOT}/fuzz/corpus/${fuzzer}" ]; then
+    cp "${ROOT}/fuzz/corpus/${fuzzer}/"* "${OUT}/${fuzzer}/"
+  fi
+  dict=()
+  if [ -f "${ROOT}/fuzz/${fuzzer}.dict" ]; then
+    dict=(-dict="${ROOT}/fuzz/${fuzzer}.dict")
+  fi
+  "${BUILD}/${fuzzer}" -max_total_time="${SECONDS_PER_TARGET}" -seed=1 -print_final_stats=1 \
+    "${dict[@]}" "${OUT}/${fuzzer}" > "${OUT}/${fuzzer}.log" 2>&1
+  execs=$(awk '/stat::number_of_executed_units:/ { print $2 }' "${OUT}/${fuzzer}.log")
+  rate=$(awk '/stat::average_exec_per_sec:/ { print $2 }' "${OUT}/${fuzzer}.log")
+  printf "%-28s %12s %14s\n" "${fuzzer}" "${execs}" "${rate}"
+  [ "${json}" = "[" ] || json="${json},"
+  json="${json}{\"fuzzer\":\"${fuzzer}\",\"seconds\":${SECONDS_PER_TARGET},\"execs\":${execs},\"execs_per_sec\":${rate}}"
+done
+echo "${json}]" > "${BUILD}/fuzz_throughput.json"
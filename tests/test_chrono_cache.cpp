@@ -0,0 +1,158 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/cache.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::cached_parser;
+using mgutility::chrono::parse_result;
+using mgutility::chrono::parse_stage;
+using time_point = std::chrono::system_clock::time_point;
+
+auto to_milliseconds(time_point value) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(value.time_since_epoch()).count();
+}
+
+// Parses with a cached parser and with parse(), which must agree
+void check_same(cached_parser<> &parser, mgutility::string_view format, mgutility::string_view date_str) {
+  time_point cached{};
+  time_point plain{};
+  const parse_result expected = mgutility::chrono::parse(plain, format, date_str, mgutility::chrono::diagnostics);
+  const parse_result result = parser.parse(cached, date_str, mgutility::chrono::diagnostics);
+  CHECK(result.error == expected.error);
+  CHECK(result.position == expected.position);
+  CHECK(result.specifier == expected.specifier);
+  CHECK(result.stage == expected.stage);
+  if (expected.ok()) {
+    CHECK(to_milliseconds(cached) == to_milliseconds(plain));
+  }
+}
+
+TEST_CASE("Cached Prefix Hits") {
+  cached_parser<> parser{"{:%FT%T.%f}"};
+  time_point value{};
+  CHECK(parser.parse(value, "2023-04-30T16:22:18.250") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871738250);
+  CHECK(parser.parse(value, "2023-04-30T16:22:19.500") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871739500);
+  CHECK(parser.parse(value, "2023-04-30T23:59:59.999") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682899199999);
+  CHECK(parser.misses() == 1);
+  CHECK(parser.hits() == 2);
+
+  CHECK(parser.parse(value, "2023-05-01T00:00:00.000") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682899200000);
+  CHECK(parser.misses() == 2);
+
+  parser.clear();
+  CHECK(parser.hits() == 0);
+  CHECK(parser.misses() == 0);
+  CHECK(parser.parse(value, "2023-05-01T00:00:01.000") == std::errc{});
+  CHECK(parser.misses() == 1);
+}
+
+TEST_CASE("Cached Hour And Minute") {
+  const auto format = mgutility::chrono::compile("{:%F %H:%M:%S.%f%z}");
+  cached_parser<> parser{format};
+  time_point value{};
+  CHECK(parser.parse(value, "2023-04-30 16:22:18.250+0300") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682860938250);
+  CHECK(parser.parse(value, "2023-04-30 16:22:59.000-0100") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682875379000);
+  CHECK(parser.parse(value, "2023-04-30 16:23:00.000+0000") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871780000);
+  CHECK(parser.hits() == 1);
+  CHECK(parser.misses() == 2);
+}
+
+TEST_CASE("Cached Results Match Parse") {
+  const char *const formats[] = {"{:%FT%T}", "{:%F %T.%f}", "{:%Y%m%d%H%M%S}", "{:%d/%m/%Y %H:%M:%S %p}",
+                                 "{:%FT%T%z}", "{:%F %T %Z}"};
+  const char *const inputs[][5] = {
+      {"2023-04-30T16:22:18", "2023-04-30T16:22:19", "2023-04-30T24:00:00", "2023-04-30", "2023-04-31T00:00:00"},
+      {"2023-04-30 16:22:18.1", "2023-04-30 16:22:18.123456", "2023-04-30 16:22:18.", "2023-04-30 16:22:18x",
+       "2023-04-30T16:22:18.1"},
+      {"20230430162218", "20230430162219", "20230430162300", "2023043016221", "20230430166218"},
+      {"30/04/2023 04:22:18 PM", "30/04/2023 04:22:18 AM", "30/04/2023 12:00:00 AM", "30/04/2023 13:00:00 PM",
+       "30/04/2023 04:22:18 XM"},
+      {"2023-04-30T16:22:18+0300", "2023-04-30T23:22:18-0300", "2023-04-30T00:22:18+0100", "2023-04-30T00:22:18+2500",
+       "2023-04-30T16:22:18"},
+      {"2023-04-30 16:22:18 UTC", "2023-04-30 16:22:18 Z", "2023-04-30 16:22:18 Europe/Istanbul",
+       "2023-04-30 16:22:18 ", "2023-04-30 16:22:18"},
+  };
+  for (std::size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    cached_parser<> parser{formats[i]};
+    for (const char *input : inputs[i]) {
+      check_same(parser, formats[i], input);
+    }
+    // Again, with the last prefix cached
+    for (const char *input : inputs[i]) {
+      check_same(parser, formats[i], input);
+    }
+    CHECK(parser.hits() != 0);
+  }
+}
+
+TEST_CASE("Cached Names") {
+  cached_parser<> syslog{"{:%b %e %T}"};
+  check_same(syslog, "{:%b %e %T}", "Apr  3 14:05:01");
+  check_same(syslog, "{:%b %e %T}", "Apr  3 14:05:02");
+  check_same(syslog, "{:%b %e %T}", "Apr 13 14:05:02");
+  CHECK(syslog.hits() == 1);
+
+  // A one-digit day is not the start of a two-digit day
+  cached_parser<> short_day{"{:%b %e %T}"};
+  check_same(short_day, "{:%b %e %T}", "Apr 3 14:05:01");
+  check_same(short_day, "{:%b %e %T}", "Apr 30 14:05:01");
+  check_same(short_day, "{:%b %e %T}", "Apr 3 14:05:02");
+  cached_parser<> date_only{"{:%b %e}"};
+  check_same(date_only, "{:%b %e}", "Apr 3");
+  check_same(date_only, "{:%b %e}", "Apr 30");
+  check_same(date_only, "{:%b %e}", "Apr 3");
+  CHECK(date_only.hits() == 0);
+
+  cached_parser<> http{"{:%a, %d %b %Y %T %Z}"};
+  check_same(http, "{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:37 GMT");
+  check_same(http, "{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:38 UTC");
+  check_same(http, "{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:39 Europe/Istanbul");
+  CHECK(http.hits() == 2);
+
+  // A day of the year after the prefix replaces its date
+  cached_parser<> yday{"{:%m-%d %Y-%j}"};
+  check_same(yday, "{:%m-%d %Y-%j}", "01-01 2024-060");
+  check_same(yday, "{:%m-%d %Y-%j}", "01-01 2024-366");
+  CHECK(yday.hits() == 1);
+}
+
+TEST_CASE("Uncacheable Formats") {
+  cached_parser<> parser{"{:%T %F}"};
+  time_point value{};
+  CHECK(parser.parse(value, "16:22:18 2023-04-30") == std::errc{});
+  CHECK(parser.parse(value, "16:22:19 2023-04-30") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871739000);
+  CHECK(parser.hits() == 0);
+  CHECK(parser.misses() == 2);
+
+  cached_parser<> invalid{"%F %T"};
+  const parse_result result = invalid.parse(value, "2023-04-30 16:22:18", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.stage == parse_stage::format);
+}
+
+TEST_CASE("Cached Tick Stream") {
+  cached_parser<> parser{"{:%F %T.%f}"};
+  time_point value{};
+  char buffer[32];
+  for (int i = 0; i < 7200; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "2023-04-30 %02d:%02d:%02d.%03d", 16 + i / 3600, i / 60 % 60, i % 60,
+                  i % 1000);
+    REQUIRE(parser.parse(value, buffer) == std::errc{});
+    CHECK(to_milliseconds(value) == 1682812800000 + (16 * 3600 + i) * 1000LL + i % 1000);
+  }
+  CHECK(parser.misses() == 1);
+  CHECK(parser.hits() == 7199);
+}
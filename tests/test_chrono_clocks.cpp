@@ -0,0 +1,56 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/cache.hpp"
+#include "mgutility/chrono/clocks.hpp"
+#include "mgutility/chrono/parse.hpp"
+#include <chrono>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::gps_clock;
+using mgutility::chrono::tai_clock;
+
+template <typename Clock>
+auto seconds_since_epoch(mgutility::string_view date_str) -> int64_t {
+  typename Clock::time_point time_point{};
+  REQUIRE(mgutility::chrono::parse<Clock>(time_point, "{:%FT%T.%f%z}", date_str) == std::error_code{});
+  return std::chrono::duration_cast<std::chrono::seconds>(time_point.time_since_epoch()).count();
+}
+
+TEST_CASE("TAI - UTC") {
+  using mgutility::chrono::detail::days_from_civil;
+  using mgutility::chrono::detail::tai_minus_utc;
+
+  CHECK(tai_minus_utc(days_from_civil(1969, 1, 1)) == 10);
+  CHECK(tai_minus_utc(days_from_civil(1972, 6, 30)) == 10);
+  CHECK(tai_minus_utc(days_from_civil(1972, 7, 1)) == 11);
+  CHECK(tai_minus_utc(days_from_civil(1980, 1, 6)) == 19);
+  CHECK(tai_minus_utc(days_from_civil(2016, 12, 31)) == 36);
+  CHECK(tai_minus_utc(days_from_civil(2017, 1, 1)) == 37);
+  CHECK(tai_minus_utc(days_from_civil(2100, 1, 1)) == 37);
+}
+
+TEST_CASE("Parsing Into TAI And GPS Time") {
+  // 2017-01-01 00:00:00 UTC is 37 seconds behind TAI
+  CHECK(seconds_since_epoch<tai_clock>("2017-01-01T00:00:00.0Z") == 1483228800 + 378691200 + 37);
+  CHECK(seconds_since_epoch<gps_clock>("2017-01-01T00:00:00.0Z") == 1483228800 - 315964800 + 18);
+  CHECK(seconds_since_epoch<gps_clock>("1980-01-06T00:00:00.0Z") == 0);
+
+  // The leap second is a second of its own, between 23:59:59 and midnight
+  CHECK(seconds_since_epoch<tai_clock>("2016-12-31T23:59:59.0Z") == 1483228800 + 378691200 + 35);
+  CHECK(seconds_since_epoch<tai_clock>("2016-12-31T23:59:60.0Z") == 1483228800 + 378691200 + 36);
+  CHECK(seconds_since_epoch<tai_clock>("2017-01-01T08:59:60.0+0900") == 1483228800 + 378691200 + 36);
+  CHECK(seconds_since_epoch<gps_clock>("2016-12-31T23:59:60.5Z") == 1483228800 - 315964800 + 17);
+
+  // The cached day path hands leap seconds to the full conversion
+  mgutility::chrono::cached_parser<tai_clock> parser{"{:%FT%T%z}"};
+  tai_clock::time_point time_point{};
+  CHECK(parser.parse(time_point, "2016-12-31T23:59:59Z") == std::errc{});
+  CHECK(parser.parse(time_point, "2016-12-31T23:59:60Z") == std::errc{});
+  CHECK(std::chrono::duration_cast<std::chrono::seconds>(time_point.time_since_epoch()).count() ==
+        1483228800 + 378691200 + 36);
+  CHECK(parser.parse(time_point, "2016-12-31T23:58:60Z") == std::errc::result_out_of_range);
+
+  CHECK(tai_clock::now().time_since_epoch() > std::chrono::seconds{1861920037});
+}
@@ -0,0 +1,117 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/columns.hpp"
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::column_arena;
+using mgutility::chrono::time_columns;
+
+TEST_CASE("Arena Buffers") {
+  column_arena arena{256};
+  unsigned char *first = arena.allocate(10);
+  unsigned char *second = arena.allocate(100);
+  unsigned char *large = arena.allocate(1000);
+  CHECK(reinterpret_cast<std::uintptr_t>(first) % column_arena::alignment == 0);
+  CHECK(reinterpret_cast<std::uintptr_t>(second) % column_arena::alignment == 0);
+  CHECK(reinterpret_cast<std::uintptr_t>(large) % column_arena::alignment == 0);
+  CHECK(second - first == 64);
+  CHECK(arena.allocated() == 64 + 128 + 1024);
+  CHECK(large[999] == 0);
+
+  large[0] = 1;
+  arena.reset();
+  CHECK(arena.allocated() == 0);
+  CHECK(arena.allocate(10) == first);
+  CHECK(arena.allocate(1000) == large);
+  CHECK(large[0] == 0);
+}
+
+TEST_CASE("Fields And Validity") {
+  column_arena arena{};
+  const std::vector<mgutility::string_view> input{
+      "2023-04-30T18:22:18.250+02:00", "2023-04-31T12:00:00Z", "1969-12-31T23:59:59-01:30",
+      "not a date", "2024-02-29T00:00:00Z"};
+  time_columns<std::milli> columns{arena, 16, mgutility::chrono::column_year | mgutility::chrono::column_month |
+                                                  mgutility::chrono::column_day | mgutility::chrono::column_hour |
+                                                  mgutility::chrono::column_offset};
+  std::vector<std::errc> errors(input.size());
+  CHECK(mgutility::chrono::parse_columns("{:%FT%T.%f%z}", input.data(), 1, columns, errors.data()) == 1);
+  CHECK(mgutility::chrono::parse_columns("{:%FT%T%z}", input.data() + 1, input.size() - 1, columns,
+                                         errors.data() + 1) == 4);
+
+  CHECK(columns.size() == 5);
+  CHECK(columns.null_count() == 2);
+  CHECK(columns.validity()[0] == 0x15);
+  CHECK(errors[0] == std::errc{});
+  CHECK(errors[1] == std::errc::result_out_of_range);
+  CHECK(errors[3] == std::errc::invalid_argument);
+
+  CHECK(columns.epoch()[0] == 1682871738250);
+  CHECK(columns.year()[0] == 2023);
+  CHECK(columns.month()[0] == 4);
+  CHECK(columns.day()[0] == 30);
+  CHECK(columns.hour()[0] == 16);
+  CHECK(columns.offset()[0] == 7200);
+
+  CHECK(columns.epoch()[2] == 5399000);
+  CHECK(columns.year()[2] == 1970);
+  CHECK(columns.day()[2] == 1);
+  CHECK(columns.hour()[2] == 1);
+  CHECK(columns.offset()[2] == -5400);
+
+  CHECK_FALSE(columns.valid(1));
+  CHECK(columns.epoch()[1] == 0);
+  CHECK(columns.year()[1] == 0);
+  CHECK(columns.valid(4));
+  CHECK(columns.month()[4] == 2);
+  CHECK(columns.offset()[4] == 0);
+
+  // The fields follow the epoch value for a leap second and a missing day
+  const mgutility::string_view leap = "2016-12-31 23:59:60";
+  CHECK(mgutility::chrono::parse_columns("{:%F %T}", &leap, 1, columns) == 1);
+  CHECK(columns.epoch()[5] == 1483228800000);
+  CHECK(columns.year()[5] == 2017);
+  CHECK(columns.month()[5] == 1);
+  CHECK(columns.day()[5] == 1);
+  CHECK(columns.hour()[5] == 0);
+  const mgutility::string_view month = "2023-05";
+  CHECK(mgutility::chrono::parse_columns("{:%Y-%m}", &month, 1, columns) == 1);
+  CHECK(columns.epoch()[6] == 1682812800000);
+  CHECK(columns.month()[6] == 4);
+  CHECK(columns.day()[6] == 30);
+}
+
+TEST_CASE("Capacity And Optional Columns") {
+  column_arena arena{};
+  const std::vector<mgutility::string_view> input{"2023-04-30", "2023-05-01", "2023-05-02"};
+  time_columns<> columns{arena, 2, mgutility::chrono::column_day};
+  CHECK(columns.year() == nullptr);
+  CHECK(columns.offset() == nullptr);
+
+  const auto format = mgutility::chrono::compile("{:%F}");
+  CHECK(mgutility::chrono::parse_columns(format, input.data(), input.size(), columns) == 2);
+  CHECK(mgutility::chrono::parse_columns(format, input.data() + 2, 1, columns) == 0);
+  CHECK(columns.size() == 2);
+  CHECK(columns.null_count() == 0);
+  CHECK(columns.epoch()[1] == 1682899200);
+  CHECK(columns.day()[0] == 30);
+  CHECK(columns.day()[1] == 1);
+  // Appending to full columns fails and leaves them as they are
+  CHECK(columns.append(mgutility::chrono::detail::tm{}) == std::errc::no_buffer_space);
+  CHECK(columns.append_null() == std::errc::no_buffer_space);
+  CHECK(columns.size() == 2);
+  CHECK(columns.null_count() == 0);
+
+  // A zone the parser cannot resolve is a null row
+  time_columns<> zones{arena, 1};
+  const mgutility::string_view zoned = "2023-04-30 12:00:00 Europe/Istanbul";
+  std::errc error{};
+  mgutility::chrono::parse_columns("{:%F %T %Z}", &zoned, 1, zones, &error);
+  CHECK(error == std::errc::not_supported);
+  CHECK_FALSE(zones.valid(0));
+}
@@ -0,0 +1,107 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/cache.hpp"
+#include "mgutility/chrono/clocks.hpp"
+#include "mgutility/chrono/columns.hpp"
+#include "mgutility/chrono/detect.hpp"
+#include "mgutility/chrono/duration.hpp"
+#include "mgutility/chrono/filter.hpp"
+#include "mgutility/chrono/format.hpp"
+#include "mgutility/chrono/incremental.hpp"
+#include "mgutility/chrono/instrument.hpp"
+#include "mgutility/chrono/parallel.hpp"
+#include "mgutility/chrono/parse.hpp"
+#include "mgutility/chrono/plan.hpp"
+#include "mgutility/chrono/profiles.hpp"
+#include "mgutility/chrono/seek.hpp"
+#include "mgutility/chrono/stream.hpp"
+#include "mgutility/chrono/tz.hpp"
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+
+// trunk-ignore-all(clang-format)
+
+// Built with -fno-exceptions where the compiler supports it, so every header
+// must compile without the throwing overloads.
+
+MGUTILITY_CNSTXPR auto epoch_millis(mgutility::string_view date_str) -> int64_t {
+  int64_t count = 0;
+  return mgutility::chrono::parse_epoch<std::milli>(count, mgutility::chrono::compile("{:%FT%T.%f%z}"), date_str,
+                                                    mgutility::chrono::diagnostics)
+                 .ok()
+             ? count
+             : -1;
+}
+
+MGUTILITY_CNSTXPR auto failure_position(mgutility::string_view date_str) -> uint32_t {
+  int64_t count = 0;
+  return mgutility::chrono::parse_epoch(count, "{:%F %T}", date_str, mgutility::chrono::diagnostics).position;
+}
+
+MGUTILITY_CNSTXPR auto profile_millis(const mgutility::chrono::profile &format, mgutility::string_view date_str)
+    -> int64_t {
+  int64_t count = 0;
+  return mgutility::chrono::parse_epoch<std::milli>(count, format, date_str, mgutility::chrono::diagnostics).ok() ? count
+                                                                                                                    : -1;
+}
+
+MGUTILITY_CNSTXPR auto plan_seconds(mgutility::string_view format, mgutility::string_view date_str) -> int64_t {
+  int64_t count = 0;
+  return mgutility::chrono::parse_epoch(count, mgutility::chrono::make_parser(format), date_str, mgutility::chrono::diagnostics)
+                 .ok()
+             ? count
+             : -1;
+}
+
+MGUTILITY_CNSTXPR auto duration_millis(mgutility::chrono::duration_layout layout, mgutility::string_view str) -> int64_t {
+  std::chrono::milliseconds duration{};
+  return mgutility::chrono::parse_duration(duration, layout, str, mgutility::chrono::diagnostics).ok() ? duration.count() : -1;
+}
+
+#if MGUTILITY_CPLUSPLUS > 201103L
+static_assert(epoch_millis("2023-04-30T18:22:18.250+0200") == 1682871738250, "");
+static_assert(epoch_millis("1969-12-31T23:59:59.250Z") == -750, "");
+static_assert(epoch_millis("2023-05-01T06:21:48.250+13:59:30") == 1682871738250, "");
+static_assert(epoch_millis("2023-04-31T18:22:18.250+0200") == -1, "");
+static_assert(failure_position("2023-04-31 16:22:18") == 8, "");
+static_assert(mgutility::chrono::parse_constant(mgutility::chrono::compile("{:%FT%T}"), "2023-04-30T16:22:18").count() ==
+                  1682871738,
+              "");
+static_assert(mgutility::chrono::parse_constant<std::chrono::microseconds>("{:%F %T.%f}", "1970-01-01 00:00:01.5").count() ==
+                  1500000,
+              "");
+static_assert(mgutility::chrono::parse_constant("{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:37 GMT").count() ==
+                  784111777,
+              "");
+static_assert(mgutility::chrono::parse_constant("{:%G-W%V-%u}", "2020-W53-7").count() == 1609632000, "");
+static_assert(profile_millis(mgutility::chrono::formats::rfc3339, "2023-04-30T18:22:18.250+02:00") == 1682871738250, "");
+static_assert(profile_millis(mgutility::chrono::formats::iso_week_date, "2020-W53-7") == 1609632000000, "");
+static_assert(plan_seconds("{:%d.%m.%Y %H:%M:%S}", "30.04.2023 16:22:18") == 1682871738, "");
+static_assert(plan_seconds("{:%d.%m.%Y %H:%M:%S}", "31.04.2023 16:22:18") == -1, "");
+static_assert(duration_millis(mgutility::chrono::duration_layout::iso8601, "PT1H30M15.250S") == 5415250, "");
+static_assert(duration_millis(mgutility::chrono::duration_layout::units, "1h30m15.25s") == 5415250, "");
+static_assert(duration_millis(mgutility::chrono::duration_layout::units, "1h30") == -1, "");
+#endif
+
+TEST_CASE("Exception-Free Parsing") {
+  CHECK(epoch_millis("2023-04-30T18:22:18.250+0200") == 1682871738250);
+  CHECK(epoch_millis("2023-04-30T18:22:18.250+02") == 1682871738250);
+  CHECK(epoch_millis("2023-04-30T18:22:18.250+0") == -1);
+  CHECK(failure_position("2023-04-31 16:22:18") == 8);
+
+  std::chrono::duration<int32_t> seconds{};
+  const auto result = mgutility::chrono::parse_epoch(seconds, "{:%FT%T}", "2038-01-19T03:14:08", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == mgutility::chrono::parse_stage::conversion);
+  CHECK(seconds.count() == 0);
+
+  // Outside a constant expression a bad timestamp yields Duration::min()
+  CHECK(mgutility::chrono::parse_constant("{:%FT%T}", "2023-04-31T16:22:18") == (std::chrono::seconds::min)());
+
+  std::chrono::system_clock::time_point time_point{};
+  CHECK(mgutility::chrono::parse(time_point, "{:%FT%T}", "2023-04-30T16:22:18") == std::error_code{});
+  char buffer[32];
+  const auto written = mgutility::chrono::format_to(buffer, "{:%FT%T}", time_point);
+  CHECK(written.error == std::errc{});
+}
@@ -0,0 +1,89 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/detect.hpp"
+#include <chrono>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::format_detector;
+using time_point = std::chrono::system_clock::time_point;
+
+auto to_milliseconds(time_point value) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(value.time_since_epoch()).count();
+}
+
+TEST_CASE("Format Shapes") {
+  using mgutility::chrono::detail::match_shape;
+  CHECK(match_shape("{:%FT%T%z}", "2023-04-30T16:22:18Z"));
+  CHECK(match_shape("{:%FT%T%z}", "2023-04-30T16:22:18+03:00"));
+  CHECK(match_shape("{:%FT%T.%f}", "2023-04-30T16:22:18.123456"));
+  CHECK(match_shape("{:%Y/%m/%d %T}", "2023/04/30 16:22:18"));
+  CHECK(match_shape("{:%d.%m.%Y %H:%M:%S %p}", "30.04.2023 04:22:18 PM"));
+  CHECK(match_shape("{:%F %T %Z}", "2023-04-30 16:22:18 Europe/Istanbul"));
+
+  CHECK(match_shape("{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:37 GMT"));
+  CHECK(match_shape("{:%b %e %T}", "Apr  3 14:05:01"));
+  CHECK(match_shape("{:%b %e %T}", "Apr 13 14:05:01"));
+  CHECK(match_shape("{:%s}", "1682871738"));
+  CHECK(match_shape("{:%s.%f}", "-1.5"));
+  CHECK(match_shape("{:%G-W%V-%u}", "2020-W53-7"));
+  CHECK(match_shape("{:%Y-%j}", "2024-060"));
+
+  CHECK(match_shape("{:%FT%T%z}", "2023-04-30T19:22:18+03"));
+  CHECK(match_shape("{:%FT%T%z}", "2023-04-30T17:22:48+01:00:30"));
+  CHECK(match_shape("{:%FT%T%z}", "2023-04-30T17:22:48+010030"));
+
+  CHECK_FALSE(match_shape("{:%FT%T%z}", "2023-04-30T16:22:18"));
+  CHECK_FALSE(match_shape("{:%FT%T%z}", "2023-04-30T16:22:18+031"));
+  CHECK_FALSE(match_shape("{:%FT%T%z}", "2023-04-30T16:22:18+03:0"));
+  CHECK_FALSE(match_shape("{:%b %e %T}", "April 3 14:05:01"));
+  CHECK_FALSE(match_shape("{:%s}", "1682871738Z"));
+  CHECK_FALSE(match_shape("{:%F %T}", "2023/04/30 16:22:18"));
+  CHECK_FALSE(match_shape("{:%F %T}", "2023-04-30 16:22:18 trailing"));
+  CHECK_FALSE(match_shape("{:%FT%T.%f}", "2023-04-30T16:22:18."));
+  CHECK_FALSE(match_shape("{:%d.%m.%Y}", "2023.04.30"));
+  CHECK_FALSE(match_shape("not a format", "2023-04-30"));
+}
+
+TEST_CASE("Detecting Formats") {
+  format_detector<> detector{"{:%FT%T%z}", "{:%Y/%m/%d %T}", "{:%d.%m.%Y %H:%M:%S %p}", "{:%F %T}"};
+  CHECK(detector.size() == 4);
+  CHECK(detector.detect("2023-04-30T16:22:18Z") == 0);
+  CHECK(detector.detect("2023/04/30 16:22:18") == 1);
+  CHECK(detector.detect("30.04.2023 04:22:18 PM") == 2);
+  CHECK(detector.detect("2023-04-30 16:22:18") == 3);
+  CHECK(detector.detect("1682871738") == format_detector<>::npos);
+  CHECK(format_detector<>{"{:%FT%T%z}", "{:%s}"}.detect("1682871738") == 1);
+  CHECK(detector.last() == format_detector<>::npos);
+
+  time_point value{};
+  CHECK(detector.parse(value, "2023-04-30T16:22:18Z") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871738000);
+  CHECK(detector.last() == 0);
+  CHECK(detector.parse(value, "2023/04/30 16:22:19") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871739000);
+  CHECK(detector.last() == 1);
+  CHECK(detector.parse(value, "30.04.2023 04:22:20 PM") == std::errc{});
+  CHECK(to_milliseconds(value) == 1682871740000);
+  CHECK(detector.last() == 2);
+  CHECK(detector.format(detector.last()) == "{:%d.%m.%Y %H:%M:%S %p}");
+
+  // The right shape with invalid fields reports the parse error and keeps the last format
+  CHECK(detector.parse(value, "2023/04/31 16:22:18") == std::errc::result_out_of_range);
+  CHECK(detector.parse(value, "yesterday") == std::errc::invalid_argument);
+  CHECK(detector.last() == 2);
+  CHECK(format_detector<>{}.parse(value, "2023-04-30T16:22:18Z") == std::errc::invalid_argument);
+
+  // The last format is not reused for an input of another shape it would
+  // parse by ignoring the rest
+  format_detector<> alternating{"{:%FT%T}", "{:%FT%T%z}"};
+  for (int i = 0; i < 2; ++i) {
+    CHECK(alternating.parse(value, "2023-04-30T10:00:00") == std::errc{});
+    CHECK(to_milliseconds(value) == 1682848800000);
+    CHECK(alternating.last() == 0);
+    CHECK(alternating.parse(value, "2023-04-30T16:22:18+0300") == std::errc{});
+    CHECK(to_milliseconds(value) == 1682860938000);
+    CHECK(alternating.last() == 1);
+  }
+}
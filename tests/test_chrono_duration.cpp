@@ -0,0 +1,149 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/duration.hpp"
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::duration_layout;
+using mgutility::chrono::parse_duration;
+using mgutility::chrono::parse_stage;
+
+// Parses into nanoseconds, or returns -1 on failure
+auto nanoseconds(duration_layout layout, mgutility::string_view str) -> int64_t {
+  std::chrono::nanoseconds duration{};
+  return parse_duration(duration, layout, str) ? -1 : duration.count();
+}
+
+TEST_CASE("ISO 8601 Durations") {
+  CHECK(nanoseconds(duration_layout::iso8601, "PT1H30M15.250S") == 5415250000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT1H30M15,25S") == 5415250000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "P2DT12H") == 216000000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "P1W") == 604800000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "P1W1D") == 691200000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT0S") == 0);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT36H") == 129600000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT1.5H") == 5400000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "P0.5D") == 43200000000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT0.000000001S") == 1);
+  CHECK(nanoseconds(duration_layout::iso8601, "PT0.0000000019S") == 1);
+  CHECK(nanoseconds(duration_layout::iso8601, "-PT0.5S") == -500000000);
+  CHECK(nanoseconds(duration_layout::iso8601, "+PT90M") == 5400000000000);
+
+  std::chrono::milliseconds negative{};
+  CHECK_FALSE(parse_duration(negative, duration_layout::iso8601, "-PT1.5S"));
+  CHECK(negative.count() == -1500);
+
+  for (const char *invalid : {"", "P", "PT", "P1DT", "PT1H30", "1H", "pt1h", "PT1M1H", "PT1H1H", "PT1.5H30M",
+                              "P1.5DT1H", "PT1S ", "PT.5S", "PT1.S", "P1H", "PT1D", "P1D2W", "PT-1S"}) {
+    INFO(invalid);
+    CHECK(nanoseconds(duration_layout::iso8601, invalid) == -1);
+  }
+
+  std::chrono::seconds duration{};
+  auto result = parse_duration(duration, duration_layout::iso8601, "P1Y2M", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::not_supported);
+  CHECK(result.position == 1);
+  CHECK(result.specifier == 'Y');
+  result = parse_duration(duration, duration_layout::iso8601, "P2M", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::not_supported);
+  CHECK(result.specifier == 'm');
+  result = parse_duration(duration, duration_layout::iso8601, "PT1H1X", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 5);
+  CHECK(result.stage == parse_stage::separator);
+}
+
+TEST_CASE("Unit Suffix Durations") {
+  CHECK(nanoseconds(duration_layout::units, "1h30m15.25s") == 5415250000000);
+  CHECK(nanoseconds(duration_layout::units, "250ms") == 250000000);
+  CHECK(nanoseconds(duration_layout::units, "1.5us") == 1500);
+  CHECK(nanoseconds(duration_layout::units, "1.5\xC2\xB5s") == 1500);
+  CHECK(nanoseconds(duration_layout::units, "1.5\xCE\xBCs") == 1500);
+  CHECK(nanoseconds(duration_layout::units, "42ns") == 42);
+  CHECK(nanoseconds(duration_layout::units, "0") == 0);
+  CHECK(nanoseconds(duration_layout::units, "-0") == 0);
+  CHECK(nanoseconds(duration_layout::units, "0s") == 0);
+  CHECK(nanoseconds(duration_layout::units, ".5s") == 500000000);
+  CHECK(nanoseconds(duration_layout::units, "1.5h") == 5400000000000);
+  CHECK(nanoseconds(duration_layout::units, "-1m30s") == -90000000000);
+  CHECK(nanoseconds(duration_layout::units, "+2h") == 7200000000000);
+  CHECK(nanoseconds(duration_layout::units, "1s1h") == 3601000000000);
+  CHECK(nanoseconds(duration_layout::units, "1500000000ms") == 1500000000000000);
+  CHECK(nanoseconds(duration_layout::units, "0.3333333333ms") == 333333);
+  CHECK(nanoseconds(duration_layout::units, "2562047h47m16.854775807s") == INT64_MAX);
+
+  for (const char *invalid : {"", "1", "10", "-", "s", "1x", "1.s", ".s", "1 s", "1hh", "1u", "1\xC2s", "00", "1h 30m"}) {
+    INFO(invalid);
+    CHECK(nanoseconds(duration_layout::units, invalid) == -1);
+  }
+}
+
+TEST_CASE("Duration Types And Overflow") {
+  std::chrono::nanoseconds nanoseconds_duration{};
+  auto result = parse_duration(nanoseconds_duration, duration_layout::units, "2562047h47m16.854775808s",
+                               mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == parse_stage::conversion);
+
+  std::chrono::hours hours{};
+  CHECK_FALSE(parse_duration(hours, duration_layout::units, "2562047788015215h"));
+  CHECK(hours.count() == 2562047788015215);
+  CHECK(parse_duration(hours, duration_layout::units, "9999999999999999999h") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(parse_duration(hours, duration_layout::iso8601, "PT99999999999999999999S") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(parse_duration(hours, duration_layout::iso8601, "PT9223372036854775808S") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK_FALSE(parse_duration(hours, duration_layout::iso8601, "PT0009223372036854775807S"));
+  CHECK(hours.count() == 2562047788015215);
+  // The fraction carries past the largest whole number of seconds
+  CHECK(parse_duration(hours, duration_layout::iso8601, "PT2562047788015215.9999H") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(parse_duration(hours, duration_layout::units, "153722867280912930.99m") ==
+        std::make_error_code(std::errc::result_out_of_range));
+
+  std::chrono::duration<int32_t> seconds32{};
+  CHECK(parse_duration(seconds32, duration_layout::units, "2147483648s") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK_FALSE(parse_duration(seconds32, duration_layout::units, "-2147483648s"));
+  CHECK(seconds32.count() == INT32_MIN);
+
+  std::chrono::duration<uint32_t, std::milli> unsigned_ms{};
+  CHECK(parse_duration(unsigned_ms, duration_layout::units, "-1ms"));
+  CHECK_FALSE(parse_duration(unsigned_ms, duration_layout::units, "1.9999ms"));
+  CHECK(unsigned_ms.count() == 1);
+
+  std::chrono::duration<double> double_seconds{};
+  CHECK_FALSE(parse_duration(double_seconds, duration_layout::iso8601, "-PT1M0.25S"));
+  CHECK(double_seconds.count() == -60.25);
+  std::chrono::duration<double, std::ratio<60>> double_minutes{};
+  CHECK_FALSE(parse_duration(double_minutes, duration_layout::units, "90s"));
+  CHECK(double_minutes.count() == 1.5);
+}
+
+TEST_CASE("Format Driven Durations") {
+  std::chrono::milliseconds duration{};
+  CHECK_FALSE(parse_duration(duration, "{:%H:%M:%S.%f}", "00:01:30.5"));
+  CHECK(duration.count() == 90500);
+  CHECK_FALSE(parse_duration(duration, "{:%T}", "23:59:59"));
+  CHECK(duration.count() == 86399000);
+  CHECK_FALSE(parse_duration(duration, "{:%M:%S}", "90:00") == std::error_code{});
+
+  auto result = parse_duration(duration, "{:%H:%M:%S}", "00:00:60", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == parse_stage::conversion);
+  result = parse_duration(duration, "{:%F %T}", "2023-04-30 00:00:00", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.stage == parse_stage::format);
+  result = parse_duration(duration, "{:%H:%M}", "01-30", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 2);
+
+  CHECK(parse_duration<std::chrono::seconds>("{:%T}", "01:00:00").count() == 3600);
+  CHECK(parse_duration<std::chrono::seconds>(duration_layout::iso8601, "PT1H").count() == 3600);
+  CHECK(parse_duration(duration_layout::units, "1.5ms").count() == 1500000);
+  REQUIRE_THROWS(parse_duration(duration_layout::units, "1.5"));
+}
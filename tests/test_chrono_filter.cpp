@@ -0,0 +1,164 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/filter.hpp"
+#include "mgutility/chrono/format.hpp"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::time_filter;
+using time_point = std::chrono::system_clock::time_point;
+
+constexpr int64_t start_seconds = 1682812800; // 2023-04-30T00:00:00Z
+
+auto at(int64_t seconds) -> time_point {
+  return time_point{std::chrono::seconds{start_seconds + seconds}};
+}
+
+// Parses in full and compares, as the filter must
+auto reference(mgutility::string_view format, mgutility::string_view date_str, time_point from, time_point to) -> bool {
+  time_point result{};
+  return !mgutility::chrono::parse(result, format, date_str) && !(result < from) && result < to;
+}
+
+auto format_at(mgutility::string_view format, time_point time, std::chrono::minutes offset = std::chrono::minutes{0}) -> std::string {
+  char buffer[64]; // NOLINT
+  const auto result = mgutility::chrono::format_to(buffer, format, time, offset);
+  REQUIRE(result.error == std::errc{});
+  return std::string(buffer, result.out);
+}
+
+// Checks a filter against the reference on strings near and around its
+// bounds, written by format_to() with layout
+void check_random(mgutility::string_view format, time_point from, time_point to, std::chrono::minutes offset = std::chrono::minutes{0},
+                  mgutility::string_view layout = {}) {
+  layout = layout.empty() ? format : layout;
+  const time_filter<> filter{format, from, to, offset};
+  std::mt19937_64 random{42};
+  std::uniform_int_distribution<int64_t> near(-90000, 90000);
+  std::uniform_int_distribution<int> offsets(-3, 3);
+  std::uniform_int_distribution<int> mutation(0, 15);
+  const time_point bounds[] = {from, to}; // NOLINT
+  for (int i = 0; i < 20000; ++i) {
+    const time_point base = bounds[i % 2]; // NOLINT
+    const auto time = base + std::chrono::milliseconds{near(random) * (i % 3 == 0 ? 1 : 1000)};
+    std::string date_str = format_at(layout, time, i % 4 == 0 ? std::chrono::minutes{offsets(random) * 90} : offset);
+    const int kind = mutation(random);
+    if (kind == 0) {
+      date_str[date_str.size() / 2] = '/';
+    } else if (kind == 1) {
+      date_str.resize(date_str.size() - 1);
+    } else if (kind == 2 && date_str.size() > 17) {
+      date_str[17] = '6'; // A leap second, or an invalid field
+    } else if (kind == 3) {
+      date_str += " trailing";
+    }
+    INFO(std::string{format.data(), format.size()} << " " << date_str);
+    CHECK(filter.contains(date_str) == reference(format, date_str, from, to));
+  }
+}
+
+TEST_CASE("Byte Ordered Layouts") {
+  const auto from = at(0);
+  const auto to = at(3600);
+  CHECK(time_filter<>{"{:%FT%T}", from, to}.byte_ordered());
+  CHECK(time_filter<>{"{:%Y%m%d%H%M%S}", from, to}.byte_ordered());
+  CHECK(time_filter<>{"{:[%F %H:%M]}", from, to}.byte_ordered());
+  CHECK(time_filter<>{"{:%FT%T.%f%z}", from, to}.byte_ordered());
+  CHECK(time_filter<>{"{:%F %I:%M:%S %p}", from, to}.byte_ordered());
+  CHECK(time_filter<>{"{:%F %a}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%d.%m.%Y %T}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%y%j}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%F %T %Z}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%Y %b %d}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%T %F}", from, to}.byte_ordered());
+  // Without %d the day is 0, the last day of the month before
+  CHECK_FALSE(time_filter<>{"{:%Y-%m}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%Y-%m %M}", from, to}.byte_ordered());
+  CHECK_FALSE(time_filter<>{"{:%FT%T}", to, from}.byte_ordered());
+}
+
+TEST_CASE("Filtering Matches parse()") {
+  check_random("{:%FT%T}", at(0), at(3600));
+  check_random("{:%FT%T}", at(-1), at(86399));
+  check_random("{:%FT%T.%f}", at(0) + std::chrono::milliseconds{250}, at(61) + std::chrono::microseconds{1});
+  check_random("{:%Y%m%d%H%M%S}", at(1800), at(7200));
+  check_random("{:[%F %H:%M]}", at(30), at(7230));
+  check_random("{:%F}", at(43200), at(3 * 86400));
+  check_random("{:%F %I:%M:%S %p}", at(0), at(3600), std::chrono::minutes{0}, "{:%F %H:%M:%S %p}");
+  check_random("{:%F %a %T}", at(0), at(3600), std::chrono::minutes{0}, "{:%F Sun %T}");
+  check_random("{:%FT%T%z}", at(0), at(3600));
+  check_random("{:%FT%T%z}", at(0), at(3600), std::chrono::minutes{90});
+  check_random("{:%FT%T.%f%z}", at(-5400), at(5400), std::chrono::minutes{-180});
+  check_random("{:%d.%m.%Y %T}", at(0), at(3600));
+  check_random("{:%Y-%m %M}", at(-29 * 86400), at(43200), std::chrono::minutes{0}, "{:%Y-%m 00}");
+  // Leap seconds at the end of 2016 count as the next midnight
+  const time_point midnight{std::chrono::seconds{1483228800}};
+  check_random("{:%FT%T}", midnight, midnight + std::chrono::hours{1});
+  check_random("{:%F %H:%M}", midnight - std::chrono::hours{1}, midnight);
+}
+
+TEST_CASE("Filtering Edge Cases") {
+  const time_filter<> filter{"{:%FT%T.%f}", at(0), at(60)};
+  CHECK(filter.contains("2023-04-30T00:00:00.000"));
+  CHECK(filter.contains("2023-04-30T00:00:59.999"));
+  CHECK_FALSE(filter.contains("2023-04-30T00:01:00.000"));
+  CHECK_FALSE(filter.contains("2023-04-29T23:59:59.999"));
+  CHECK_FALSE(filter.contains("2023-04-30T00:00:30"));
+  CHECK_FALSE(filter.contains("2023-04-30T00:00"));
+  CHECK_FALSE(filter.contains(""));
+  CHECK(filter.contains("2023/04/30T00:00:30.5"));
+  CHECK_FALSE(filter.contains("2023-04-31T00:00:30.5"));
+  CHECK_FALSE(filter.contains("2023-04-3xT00:00:30.5"));
+  // Without %z the offset does not apply
+  CHECK(time_filter<>("{:%FT%T}", at(0), at(60), std::chrono::minutes{120}).contains("2023-04-30T00:00:30"));
+
+  const time_point midnight{std::chrono::seconds{1483228800}};
+  const time_filter<> leap{"{:%FT%T}", midnight, midnight + std::chrono::seconds{1}};
+  CHECK(leap.contains("2016-12-31T23:59:60"));
+  CHECK(leap.contains("2017-01-01T00:00:00"));
+  CHECK_FALSE(leap.contains("2016-12-31T23:59:59"));
+  CHECK_FALSE(leap.contains("2017-01-01T00:00:01"));
+
+  // Strings at other offsets are parsed in full
+  const time_filter<> offsets{"{:%FT%T%z}", at(0), at(3600)};
+  CHECK(offsets.contains("2023-04-30T00:30:00+00:00"));
+  CHECK(offsets.contains("2023-04-30T03:30:00+03:00"));
+  CHECK(offsets.contains("2023-04-29T20:30:00-04:00"));
+  CHECK_FALSE(offsets.contains("2023-04-30T00:30:00+03:00"));
+  CHECK_FALSE(offsets.contains("2023-04-30T00:30:00+3"));
+
+  const time_filter<> open{"{:%FT%T}", time_point::min(), at(0)};
+  CHECK(open.byte_ordered());
+  CHECK(open.contains("1970-01-01T00:00:00"));
+  CHECK(open.contains("2023-04-29T23:59:59"));
+  CHECK_FALSE(open.contains("2023-04-30T00:00:00"));
+
+  // "2023-05" is day 0 of May, 2023-04-30
+  CHECK(time_filter<>{"{:%Y-%m}", at(-29 * 86400), at(43200)}.contains("2023-05"));
+  CHECK_FALSE(time_filter<>{"{:%Y-%m}", at(-29 * 86400), at(43200)}.contains("2023-04"));
+
+  const time_filter<> invalid{"{:%FT%Q}", at(0), at(60)};
+  CHECK(invalid.error() == std::errc::invalid_argument);
+  CHECK_FALSE(invalid.contains("2023-04-30T00:00:30"));
+}
+
+TEST_CASE("Selecting A Column") {
+  std::vector<std::string> column;
+  for (int64_t i = 0; i < 1000; ++i) {
+    column.push_back(format_at("{:%F %T}", at(i * 37)));
+  }
+  column.push_back("not a time");
+  const std::vector<mgutility::string_view> rows(column.begin(), column.end());
+  std::vector<std::size_t> selected(rows.size());
+  const time_filter<> filter{"{:%F %T}", at(3700), at(7400)};
+  const auto count = filter.select(rows.data(), rows.size(), selected.data());
+  REQUIRE(count == 100);
+  CHECK(selected[0] == 100);
+  CHECK(selected[count - 1] == 199);
+}
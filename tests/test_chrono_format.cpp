@@ -0,0 +1,87 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/format.hpp"
+#include <chrono>
+#include <string>
+
+// trunk-ignore-all(clang-format)
+
+using std::chrono::milliseconds;
+using std::chrono::system_clock;
+
+template <typename TimePoint>
+auto format(mgutility::string_view format_str, const TimePoint &time_point,
+            std::chrono::minutes offset = std::chrono::minutes{0}) -> std::string {
+  char buffer[64];
+  const auto result = mgutility::chrono::format_to(buffer, format_str, time_point, offset);
+  REQUIRE(result.error == std::errc{});
+  return std::string(buffer, result.out);
+}
+
+auto from_milliseconds(int64_t value) -> std::chrono::time_point<system_clock, milliseconds> {
+  return std::chrono::time_point<system_clock, milliseconds>{milliseconds{value}};
+}
+
+TEST_CASE("Formatting") {
+  CHECK(format("{:%FT%T}", from_milliseconds(1682871738000)) == "2023-04-30T16:22:18");
+  CHECK(format("{:%Y/%m/%d %H:%M:%S}", from_milliseconds(1672531199000)) == "2022/12/31 23:59:59");
+  CHECK(format("{:%FT%T.%f}", from_milliseconds(1682871738123)) == "2023-04-30T16:22:18.123");
+  CHECK(format("{:%FT%T.%f}", std::chrono::time_point_cast<std::chrono::seconds>(from_milliseconds(1682871738123))) == "2023-04-30T16:22:18.0");
+  CHECK(format("{:%FT%T.%f}", std::chrono::time_point<system_clock, std::chrono::nanoseconds>{std::chrono::nanoseconds{1682871738123456789}}) == "2023-04-30T16:22:18.123456789");
+  CHECK(format("{:%FT%T}", from_milliseconds(-1000)) == "1969-12-31T23:59:59");
+  CHECK(format("{:%FT%T.%f}", from_milliseconds(-750)) == "1969-12-31T23:59:59.250");
+  CHECK(format("{:%F}", from_milliseconds(951825600000)) == "2000-02-29");
+}
+
+TEST_CASE("Timezone Offset And AM/PM") {
+  CHECK(format("{:%FT%T%z}", from_milliseconds(1682871738000)) == "2023-04-30T16:22:18+0000");
+  CHECK(format("{:%FT%T%z}", from_milliseconds(1682871738000), std::chrono::hours{2}) == "2023-04-30T18:22:18+0200");
+  CHECK(format("{:%FT%T%z}", from_milliseconds(1682878938000), std::chrono::minutes{-150}) == "2023-04-30T15:52:18-0230");
+  CHECK(format("{:%FT%H:%M:%S %p}", from_milliseconds(1682812800000)) == "2023-04-30T12:00:00 AM");
+  CHECK(format("{:%FT%H:%M:%S %p}", from_milliseconds(1682856000000)) == "2023-04-30T12:00:00 PM");
+  CHECK(format("{:%FT%T %p}", from_milliseconds(1682899199000)) == "2023-04-30T11:59:59 PM");
+}
+
+TEST_CASE("Round Trip Through parse()") {
+  const char *const formats[] = {"{:%FT%T}", "{:%FT%T.%f}", "{:%FT%T.%f%z}", "{:%FT%T.%f %p %z}", "{:%Y/%m/%d %H:%M:%S}"};
+  const int64_t values[] = {0, 1682871738123, 951825600999, 1672531199000, -2208902400000};
+  for (const auto *format_str : formats) {
+    for (const auto value : values) {
+      const auto time_point = from_milliseconds(value);
+      const auto has_offset = std::string{format_str}.find("%z") != std::string::npos;
+      const auto has_fraction = std::string{format_str}.find("%f") != std::string::npos;
+      const auto text = format(format_str, time_point, std::chrono::minutes{has_offset ? -90 : 0});
+      const auto expected = has_fraction ? time_point : std::chrono::time_point_cast<std::chrono::seconds>(time_point);
+      CHECK(std::chrono::time_point_cast<milliseconds>(mgutility::chrono::parse(format_str, text)) == expected);
+    }
+  }
+}
+
+TEST_CASE("Compiled Format Size") {
+  MGUTILITY_CNSTXPR auto iso = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  CHECK(mgutility::chrono::formatted_size(iso) == 34);
+  CHECK(mgutility::chrono::formatted_size<milliseconds>(iso) == 28);
+  CHECK(mgutility::chrono::formatted_size<milliseconds>("{:%FT%T.%f%z}") == 28);
+  CHECK(mgutility::chrono::formatted_size("{:%FT%Q}") == 0);
+  CHECK(mgutility::chrono::formatted_size("{:%F %T %Z}") == 0);
+  CHECK(mgutility::chrono::formatted_size(mgutility::chrono::compile("{:%F %T %Z}")) == 0);
+
+#if MGUTILITY_CPLUSPLUS > 201103L
+  constexpr auto size = mgutility::chrono::formatted_size<milliseconds>(iso);
+  char buffer[size];
+#else
+  char buffer[28];
+#endif
+  const auto result = mgutility::chrono::format_to(buffer, iso, from_milliseconds(1682871738123), std::chrono::hours{2});
+  CHECK(result.error == std::errc{});
+  CHECK(std::string(buffer, result.out) == "2023-04-30T18:22:18.123+0200");
+}
+
+TEST_CASE("Formatting Errors") {
+  char buffer[64];
+  CHECK(mgutility::chrono::format_to(buffer, "{:%FT%Q}", from_milliseconds(0)).error == std::errc::invalid_argument);
+  CHECK(mgutility::chrono::format_to(buffer, "{:%F %T %Z}", from_milliseconds(0)).error == std::errc::invalid_argument);
+  CHECK(mgutility::chrono::format_to(buffer, "%FT%T", from_milliseconds(0)).error == std::errc::invalid_argument);
+  CHECK(mgutility::chrono::format_to(buffer, "{:%FT%T}", from_milliseconds(0), std::chrono::hours{24}).error == std::errc::result_out_of_range);
+  CHECK(mgutility::chrono::format_to(buffer, "{:%FT%T}", from_milliseconds(-62167219200001)).error == std::errc::result_out_of_range);
+}
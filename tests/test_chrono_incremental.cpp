@@ -0,0 +1,178 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/incremental.hpp"
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::feed_status;
+using mgutility::chrono::incremental_parser;
+using mgutility::chrono::parse_stage;
+using time_point = std::chrono::system_clock::time_point;
+
+// Feeds a string in pieces of at most piece bytes, 0 meaning whole, then
+// finishes it
+auto feed_pieces(incremental_parser<> &parser, mgutility::string_view date_str, std::size_t piece) -> feed_status {
+  parser.reset();
+  piece = piece == 0 ? date_str.size() : piece;
+  for (std::size_t i = 0; i < date_str.size() && parser.status() == feed_status::need_more; i += piece) {
+    parser.feed(date_str.substr(i, piece));
+  }
+  return parser.finish();
+}
+
+// Checks that feeding a string byte by byte, whole and split at every
+// position gives the diagnostics and time point of parse()
+void check_same(mgutility::string_view format, mgutility::string_view date_str) {
+  INFO(std::string{format.data(), format.size()} << " " << std::string{date_str.data(), date_str.size()});
+  time_point expected{};
+  const auto expected_result = mgutility::chrono::parse(expected, format, date_str, mgutility::chrono::diagnostics);
+  incremental_parser<> parser{format};
+  const auto check_result = [&](feed_status status) {
+    CHECK((status == feed_status::done) == expected_result.ok());
+    CHECK(parser.result().error == expected_result.error);
+    CHECK(parser.result().stage == expected_result.stage);
+    CHECK(parser.result().specifier == expected_result.specifier);
+    if (expected_result.stage == parse_stage::field || expected_result.stage == parse_stage::separator) {
+      CHECK(parser.result().position == expected_result.position);
+    }
+    CHECK((!expected_result.ok() || parser.time() == expected));
+  };
+  check_result(feed_pieces(parser, date_str, 0));
+  check_result(feed_pieces(parser, date_str, 1));
+  for (std::size_t split = 1; split < date_str.size(); ++split) {
+    parser.reset();
+    parser.feed(date_str.substr(0, split));
+    parser.feed(date_str.substr(split));
+    check_result(parser.finish());
+  }
+}
+
+TEST_CASE("Incremental Parsing Matches parse()") {
+  check_same("{:%FT%T}", "2023-04-30T16:22:18");
+  check_same("{:%FT%T.%f%z}", "2023-04-30T16:22:18.123+03:00");
+  check_same("{:%FT%T.%f%z}", "2023-04-30T16:22:18.123456789-0530");
+  check_same("{:%FT%T.%f%z}", "2023-04-30T16:22:18.1Z");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+03:30:15");
+  check_same("{:%FT%z.%f%z}", "2023-04-30T+02:18:22.18+01");
+  check_same("{:%FT%z:%f%z}", "2023-04-30T+02:18:22:18+01");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+03");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+03:");
+  check_same("{:%T%z %Y}", "16:22:18Z 2023");
+  check_same("{:%T%z:%Y}", "16:22:18+03:2023");
+  check_same("{:%d/%b/%Y:%T %z}", "30/Apr/2023:16:22:18 +0200");
+  check_same("{:%A, %d %B %Y %I:%M %p}", "Sunday, 30 April 2023 04:22 PM");
+  check_same("{:%a %b %e %T %Y}", "Sun Apr  3 16:22:18 2023");
+  check_same("{:%e.%m.%Y}", "3.04.2023");
+  check_same("{:%s}", "1682871738");
+  check_same("{:%s}", "-86400");
+  check_same("{:%s.%f}", "1682871738.5");
+  check_same("{:%G-W%V-%u}", "2020-W53-7");
+  check_same("{:%y%j%H%M%S}", "23120162218");
+  check_same("{:%Y%m%d%H%M%S}", "20230430162218");
+  check_same("{:%FT%T}", "2016-12-31T23:59:60");
+}
+
+TEST_CASE("Incremental Failures Match parse()") {
+  check_same("{:%FT%T}", "2023-04-30T16:22:1");
+  check_same("{:%FT%T}", "2023-04-31T16:22:18");
+  check_same("{:%FT%T}", "2023-04-30 16:22:18");
+  check_same("{:%FT%T}", "2023-04-30T24:22:18");
+  check_same("{:%FT%T.%f}", "2023-04-30T16:22:18.");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+15:00");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+03:60");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+3");
+  check_same("{:%FT%z.%f%z}", "2023-04-30T+02:18:22:18+01");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18");
+  check_same("{:%d %B %Y}", "30 Apri 2023");
+  check_same("{:%d %b %Y}", "30 Foo 2023");
+  check_same("{:%I:%M %p}", "13:22 PM");
+  check_same("{:%I:%M %p}", "04:22 XM");
+  check_same("{:%s}", "-");
+  check_same("{:%s}", "99999999999999999999");
+  check_same("{:%G-W%V-%u}", "2021-W53-1");
+  check_same("{:%y%j}", "23366");
+  check_same("{:%FT%T}", "2023-04-30T16:22:60");
+  check_same("{:%FT%T}", "");
+}
+
+TEST_CASE("Incremental Parsing Of Random Inputs") {
+  const char *const formats[][2] = {
+      {"{:%FT%T.%f%z}", "2023-04-30T16:22:18.123+03:00"},
+      {"{:%d/%b/%Y:%T %z}", "30/Apr/2023:16:22:18 +0200"},
+      {"{:%A, %e %B %Y %I:%M %p}", "Sunday, 30 April 2023 04:22 PM"},
+      {"{:%s.%f}", "1682871738.25"},
+  }; // NOLINT
+  const char alphabet[] = "0123456789:+-. ZAPMa"; // NOLINT
+  std::mt19937 random{42};
+  for (const auto &format : formats) {
+    const std::string valid = format[1];
+    std::uniform_int_distribution<std::size_t> position(0, valid.size() - 1);
+    std::uniform_int_distribution<std::size_t> letter(0, sizeof(alphabet) - 2);
+    for (int i = 0; i < 300; ++i) {
+      std::string date_str = valid;
+      date_str[position(random)] = alphabet[letter(random)]; // NOLINT
+      if (i % 5 == 0) {
+        date_str.resize(position(random));
+      }
+      check_same(format[0], date_str);
+    }
+  }
+}
+
+TEST_CASE("Incremental Parsing In A Byte Stream") {
+  incremental_parser<> parser{"{:%FT%T.%f}"};
+  CHECK(parser.feed("2023-04-30T16:") == feed_status::need_more);
+  CHECK(parser.consumed() == 14);
+  CHECK(parser.feed("22:18.12") == feed_status::need_more);
+  // The fraction ends at the first character that is not a digit
+  CHECK(parser.feed("5|next") == feed_status::done);
+  CHECK(parser.consumed() == 1);
+  CHECK(parser.result().position == 23);
+  CHECK(parser.time() == time_point{std::chrono::milliseconds{1682871738125}});
+  // Further input is ignored until reset()
+  CHECK(parser.feed("2023") == feed_status::done);
+  CHECK(parser.consumed() == 0);
+
+  parser.reset();
+  CHECK(parser.feed("2023-04-30T16:22:18.1") == feed_status::need_more);
+  CHECK(parser.finish() == feed_status::done);
+  CHECK(parser.time() == time_point{std::chrono::milliseconds{1682871738100}});
+
+  // A fixed-width last field ends without looking at the next byte
+  incremental_parser<> fixed{"{:%FT%T}"};
+  CHECK(fixed.feed("2023-04-30T16:22:18") == feed_status::done);
+  CHECK(fixed.consumed() == 19);
+
+  // A colon after an offset is read by the format only once a digit follows
+  incremental_parser<> offset{"{:%FT%T%z}"};
+  CHECK(offset.feed("2023-04-30T16:22:18+03:") == feed_status::need_more);
+  CHECK(offset.feed(" rest") == feed_status::done);
+  CHECK(offset.consumed() == 0);
+  CHECK(offset.result().position == 22);
+  CHECK(offset.time() == time_point{std::chrono::seconds{1682860938}});
+
+  parser.reset();
+  CHECK(parser.feed("2023-04-30X") == feed_status::error);
+  CHECK(parser.result().position == 10);
+  CHECK(parser.result().stage == parse_stage::separator);
+}
+
+TEST_CASE("Incremental Format Errors") {
+  incremental_parser<> invalid{"{:%FT%Q}"};
+  CHECK(invalid.error() == std::errc::invalid_argument);
+  CHECK(invalid.feed("2023-04-30T16:22:18") == feed_status::error);
+  CHECK(invalid.result().stage == parse_stage::format);
+
+  incremental_parser<> zone{"{:%F %T %Z}"};
+  CHECK(zone.error() == std::errc::not_supported);
+  CHECK(zone.finish() == feed_status::error);
+  CHECK(zone.result().specifier == 'Z');
+
+  const std::string long_format = "{:" + std::string(60, '-') + "%F}";
+  CHECK(incremental_parser<>{long_format}.error() == std::errc::value_too_large);
+}
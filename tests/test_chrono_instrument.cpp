@@ -0,0 +1,100 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/instrument.hpp"
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <thread>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::count_instrumentation;
+using mgutility::chrono::cycle_instrumentation;
+using mgutility::chrono::parse_counters;
+using mgutility::chrono::thread_counters;
+using clock_type = std::chrono::system_clock;
+
+TEST_CASE("Counting Specifiers") {
+  thread_counters().clear();
+  clock_type::time_point time_point{};
+  CHECK_FALSE(mgutility::chrono::parse<clock_type, count_instrumentation>(time_point, "{:%FT%T%z}",
+                                                                          "2023-04-30T16:22:18+0300"));
+  CHECK_FALSE(mgutility::chrono::parse<clock_type, count_instrumentation>(
+      time_point, mgutility::chrono::compile("{:%FT%T%z}"), "2023-04-30T16:22:18-0130"));
+  CHECK(mgutility::chrono::parse<clock_type, count_instrumentation>(time_point, "{:%FT%T%z}",
+                                                                    "2023-04-30T16:22:18+2500") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(mgutility::chrono::parse<clock_type, count_instrumentation>(time_point, "{:%FT%T}", "2023-04-30Tab:22:18",
+                                                                    mgutility::chrono::diagnostics)
+            .specifier == 'T');
+
+  const parse_counters &counters = thread_counters();
+  CHECK(counters.calls('F') == 4);
+  CHECK(counters.failures('F') == 0);
+  CHECK(counters.calls('T') == 4);
+  CHECK(counters.failures('T') == 1);
+  CHECK(counters.failures('T', std::errc::invalid_argument) == 1);
+  CHECK(counters.calls('z') == 3);
+  CHECK(counters.failures('z', std::errc::result_out_of_range) == 1);
+  CHECK(counters.failures('z', std::errc::invalid_argument) == 0);
+  CHECK(counters.calls('\0') == 2);
+  CHECK(counters.failures('\0') == 0);
+  // Counting alone leaves the histograms empty
+  CHECK(counters.cycles('F', 0) == 0);
+  CHECK(counters.calls('Y') == 0);
+
+  // The default policy records nothing
+  CHECK_FALSE(mgutility::chrono::parse(time_point, "{:%FT%T}", "2023-04-30T16:22:18"));
+  CHECK(counters.calls('F') == 4);
+}
+
+TEST_CASE("Cycle Histograms") {
+  thread_counters().clear();
+  clock_type::time_point time_point{};
+  for (int i = 0; i < 100; ++i) {
+    CHECK_FALSE(mgutility::chrono::parse<clock_type, cycle_instrumentation>(time_point, "{:%FT%T.%f}",
+                                                                            "2023-04-30T16:22:18.250"));
+  }
+  const parse_counters &counters = thread_counters();
+  for (const char specifier : {'F', 'T', 'f', '\0'}) {
+    uint64_t total = 0;
+    for (std::size_t bucket = 0; bucket < parse_counters::buckets; ++bucket) {
+      total += counters.cycles(specifier, bucket);
+    }
+    CHECK(total == 100);
+  }
+  CHECK(counters.cycles('F', parse_counters::buckets) == 0);
+
+  const std::string text = counters.dump();
+  CHECK(text.find("conversion calls=100") != std::string::npos);
+  CHECK(text.find("%F calls=100") != std::string::npos);
+  CHECK(text.find("%f calls=100") != std::string::npos);
+  CHECK(text.find("cycles[2^") != std::string::npos);
+  CHECK(text.find("%z") == std::string::npos);
+}
+
+TEST_CASE("Merging Thread Counters") {
+  thread_counters().clear();
+  parse_counters total;
+  std::thread worker([&total] {
+    clock_type::time_point time_point{};
+    for (int i = 0; i < 10; ++i) {
+      mgutility::chrono::parse<clock_type, count_instrumentation>(time_point, "{:%F %T}", "2023-04-30 16:22:18");
+    }
+    total.merge(thread_counters());
+  });
+  worker.join();
+  // The worker's counters are its own
+  CHECK(thread_counters().calls('F') == 0);
+  CHECK(total.calls('F') == 10);
+
+  clock_type::time_point time_point{};
+  mgutility::chrono::parse<clock_type, count_instrumentation>(time_point, "{:%F %T}", "2023-04-30 16:22:99");
+  total.merge(thread_counters());
+  CHECK(total.calls('T') == 11);
+  CHECK(total.failures('T', std::errc::result_out_of_range) == 1);
+
+  total.clear();
+  CHECK(total.calls('F') == 0);
+  CHECK(total.dump().empty());
+}
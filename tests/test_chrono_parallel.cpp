@@ -0,0 +1,66 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/parallel.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using time_point = std::chrono::system_clock::time_point;
+
+// A column with a malformed element every 97 elements.
+auto make_column(std::size_t count) -> std::vector<std::string> {
+  std::vector<std::string> column(count);
+  char buffer[32];
+  for (std::size_t i = 0; i < count; ++i) {
+    std::snprintf(buffer, sizeof(buffer), "2023-04-30T%02d:%02d:%02d.%03d", static_cast<int>(i / 3600 % 24),
+                  static_cast<int>(i / 60 % 60), static_cast<int>(i % 60), static_cast<int>(i % 1000));
+    column[i] = buffer;
+    if (i % 97 == 0) {
+      column[i][5] = 'x';
+    }
+  }
+  return column;
+}
+
+TEST_CASE("Parallel Parse Matches parse_many()") {
+  const auto column = make_column(10000);
+  const std::vector<mgutility::string_view> input(column.begin(), column.end());
+  std::vector<time_point> expected(input.size());
+  std::vector<std::errc> expected_errors(input.size());
+  const auto expected_failures =
+      mgutility::chrono::parse_many("{:%FT%T.%f}", input.data(), input.size(), expected.data(), expected_errors.data());
+  CHECK(expected_failures == 104);
+
+  const mgutility::chrono::parallel_options options[] = {{1, 0}, {4, 0}, {8, 7}, {3, 1}, {64, 100}, {0, 0}};
+  for (const auto &option : options) {
+    std::vector<time_point> output(input.size());
+    std::vector<std::errc> errors(input.size());
+    CHECK(mgutility::chrono::parallel_parse("{:%FT%T.%f}", input.data(), input.size(), output.data(), errors.data(),
+                                            option) == expected_failures);
+    CHECK(output == expected);
+    CHECK(errors == expected_errors);
+    CHECK(mgutility::chrono::parallel_parse("{:%FT%T.%f}", input.data(), input.size(), output.data(), nullptr,
+                                            option) == expected_failures);
+  }
+  CHECK(mgutility::chrono::parallel_parse("{:%FT%T.%f}", input.data(), 0, static_cast<time_point *>(nullptr)) == 0);
+}
+
+TEST_CASE("Parallel Parse Of Packed Records") {
+  const auto column = make_column(3000);
+  std::string records;
+  for (const auto &element : column) {
+    records += element.substr(0, 19);
+  }
+  std::vector<time_point> expected(column.size());
+  const auto expected_failures =
+      mgutility::chrono::parse_many("{:%FT%T}", records.data(), 19, column.size(), expected.data());
+
+  std::vector<time_point> output(column.size());
+  CHECK(mgutility::chrono::parallel_parse("{:%FT%T}", records.data(), 19, column.size(), output.data(), nullptr,
+                                          mgutility::chrono::parallel_options{6, 16}) == expected_failures);
+  CHECK(output == expected);
+}
@@ -2,6 +2,7 @@
 #include "doctest/doctest.h"
 #include "mgutility/chrono/parse.hpp"
 #include <chrono>
+#include <system_error>
 
 // trunk-ignore-all(clang-format)
 
@@ -28,6 +29,32 @@ TEST_CASE("Timezone Offset Handling") {
   CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2016-02-29T05:00:00-0000")) == milliseconds(1456722000000));
   CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2016-02-29T23:59:59+0000")) == milliseconds(1456790399000));
   CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2016-02-29T12:00:00-1200")) == milliseconds(1456790400000));
+
+  // The full +-14:00 range, hours alone and offsets with seconds
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2023-05-01T06:22:18+1400")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2023-04-30T02:22:18-14:00")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2023-04-30T19:22:18+03")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2023-04-30T17:22:48+01:00:30")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2023-04-30T17:22:48+010030")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z %Y}", "2023-04-30T19:22:18+03 2023")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z %Y}", "2023-04-30T16:22:18Z 2023")) == milliseconds(1682871738000));
+  // A literal or a field may follow the seconds of an extended offset
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%z:%f}", "2023-04-30T+02:18:22:5")) == milliseconds(1682804498500));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%z%f}", "2023-04-30T+02:18:225")) == milliseconds(1682804498500));
+  std::chrono::system_clock::time_point time_point;
+  const auto result = mgutility::chrono::parse(time_point, "{:%FT%z.%f}", "2023-04-30T+02:18:22:5", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 20);
+  CHECK(result.stage == mgutility::chrono::parse_stage::separator);
+
+  // Offsets no longer limit the year
+  int64_t count = 0;
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T%z}", "1899-12-31T23:00:00-0100") == std::error_code{});
+  CHECK(count == -2208988800);
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T%z}", "9999-12-31T23:00:00-0100") == std::error_code{});
+  CHECK(count == 253402300800);
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T%z}", "0000-01-01T00:00:00+0100") == std::error_code{});
+  CHECK(count == -62167222800);
 }
 
 TEST_CASE("AM/PM Handling") {
@@ -64,6 +91,139 @@ TEST_CASE("Leap Year and Date Boundaries") {
 
   CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "2020-02-29T12:00:00")) == milliseconds(1582977600000)); // Leap year
   CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "2021-03-01T00:00:00")) == milliseconds(1614556800000)); // Feb 28 + 1 day
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "2000-02-29T12:00:00")) == milliseconds(951825600000)); // Leap year divisible by 400
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2000-03-01T00:30:00+0100")) == milliseconds(951867000000)); // Rolls back into Feb 29
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T}", "1900-02-29T12:00:00")); // Not a leap year
+
+  // The year follows the day
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%m/%d/%Y}", "02/29/2024")) == milliseconds(1709164800000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%b %e %T %Y}", "Feb 29 00:00:00 2024")) == milliseconds(1709164800000));
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%m/%d/%Y}", "02/29/2023"));
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%m/%d/%Y}", "02/30/2024"));
+}
+
+TEST_CASE("Leap Seconds") {
+  using std::chrono::milliseconds;
+
+  // A leap second is the POSIX instant of the following midnight
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2016-12-31T23:59:60Z")) == milliseconds(1483228800000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T.%f%z}", "2016-12-31T23:59:60.5Z")) == milliseconds(1483228800500));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T%z}", "2017-01-01T08:59:60+0900")) == milliseconds(1483228800000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "1972-06-30T23:59:60")) == milliseconds(78796800000));
+
+  // Any other second 60 is out of range
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T}", "2016-12-31T23:58:60")); // Not the last minute
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T}", "2017-12-31T23:59:60")); // No leap second that day
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T%z}", "2016-12-31T23:59:60+0100"));
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T}", "2016-12-31T23:59:61"));
+
+  std::chrono::system_clock::time_point time_point{};
+  const auto result = mgutility::chrono::parse(time_point, "{:%FT%T}", "2023-04-30T16:22:60", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == mgutility::chrono::parse_stage::conversion);
+}
+
+TEST_CASE("Dates Before The Epoch") {
+  using std::chrono::milliseconds;
+
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "1969-12-31T23:59:59")) == milliseconds(-1000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T.%f}", "1969-12-31T23:59:59.250")) == milliseconds(-750));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "1900-01-01T00:00:00")) == milliseconds(-2208988800000));
+  CHECK(to_milliseconds(mgutility::chrono::parse("{:%FT%T}", "1800-01-01T00:00:00")) == milliseconds(-5364662400000));
+}
+
+// Counts days from 2000-01-01, so it needs clock_traits.
+struct y2k_clock {
+  using rep = int64_t;
+  using period = std::ratio<86400>;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<y2k_clock>;
+  static constexpr bool is_steady = false;
+};
+
+namespace mgutility {
+namespace chrono {
+template <> struct clock_traits<y2k_clock> {
+  static auto from_unix(y2k_clock::duration since_epoch) -> y2k_clock::time_point {
+    return y2k_clock::time_point{since_epoch - y2k_clock::duration{10957}};
+  }
+};
+} // namespace chrono
+} // namespace mgutility
+
+TEST_CASE("Epoch Counts And Clocks") {
+  int64_t count = 0;
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T}", "2023-04-30T16:22:18") == std::error_code{});
+  CHECK(count == 1682871738);
+  CHECK(mgutility::chrono::parse_epoch<std::micro>(count, "{:%FT%T.%f}", "2023-04-30T16:22:18.123456789") == std::error_code{});
+  CHECK(count == 1682871738123456);
+  CHECK(mgutility::chrono::parse_epoch<std::nano>(count, mgutility::chrono::compile("{:%FT%T.%f}"), "1969-12-31T23:59:59.25") == std::error_code{});
+  CHECK(count == -750000000);
+  // Rounds toward negative infinity
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T.%f}", "1969-12-31T23:59:59.25") == std::error_code{});
+  CHECK(count == -1);
+  CHECK(mgutility::chrono::parse_epoch<std::ratio<60>>(count, "{:%FT%T}", "1969-12-31T23:59:30") == std::error_code{});
+  CHECK(count == -1);
+  // Beyond the range of nanoseconds in int64_t, but not of seconds
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T}", "9999-12-31T23:59:59") == std::error_code{});
+  CHECK(count == 253402300799);
+  CHECK(mgutility::chrono::parse_epoch<std::nano>(count, "{:%FT%T}", "2263-01-01T00:00:00") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(mgutility::chrono::parse_epoch<std::nano>(count, "{:%FT%T}", "1677-01-01T00:00:00") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  CHECK(mgutility::chrono::parse_epoch(count, "{:%FT%T}", "2023-04-31T16:22:18") ==
+        std::make_error_code(std::errc::result_out_of_range));
+
+  std::chrono::microseconds microseconds{};
+  CHECK(mgutility::chrono::parse_epoch(microseconds, "{:%FT%T.%f}", "2023-04-30T16:22:18.5") == std::error_code{});
+  CHECK(microseconds.count() == 1682871738500000);
+  std::chrono::duration<int32_t> seconds{};
+  CHECK(mgutility::chrono::parse_epoch(seconds, "{:%FT%T}", "2038-01-19T03:14:07") == std::error_code{});
+  CHECK(seconds.count() == 2147483647);
+  CHECK(mgutility::chrono::parse_epoch(seconds, "{:%FT%T}", "2038-01-19T03:14:08") ==
+        std::make_error_code(std::errc::result_out_of_range));
+  std::chrono::duration<double> fractional{};
+  CHECK(mgutility::chrono::parse_epoch(fractional, mgutility::chrono::compile("{:%FT%T}"), "1970-01-01T00:01:00") == std::error_code{});
+  CHECK(fractional.count() == 60.0);
+
+  std::chrono::steady_clock::time_point steady{};
+  CHECK(mgutility::chrono::parse<std::chrono::steady_clock>(steady, "{:%FT%T}", "2023-04-30T16:22:18") == std::error_code{});
+  CHECK(to_milliseconds(steady).count() == 1682871738000);
+
+  y2k_clock::time_point days{};
+  CHECK(mgutility::chrono::parse<y2k_clock>(days, "{:%FT%T}", "2000-01-02T23:59:59") == std::error_code{});
+  CHECK(days.time_since_epoch().count() == 1);
+}
+
+TEST_CASE("Days From Civil") {
+  CHECK(mgutility::chrono::detail::days_from_civil(1970, 1, 1) == 0);
+  CHECK(mgutility::chrono::detail::days_from_civil(1969, 12, 31) == -1);
+  CHECK(mgutility::chrono::detail::days_from_civil(2000, 3, 1) == 11017);
+  CHECK(mgutility::chrono::detail::days_from_civil(1, 1, 1) == -719162);
+  CHECK(mgutility::chrono::detail::days_from_civil(9999, 12, 31) == 2932896);
+
+  std::tm time_struct{};
+  time_struct.tm_year = 9999 - 1900;
+  time_struct.tm_mon = 11;
+  time_struct.tm_mday = 31;
+  time_struct.tm_hour = 23;
+  time_struct.tm_min = 59;
+  time_struct.tm_sec = 59;
+  std::time_t seconds{};
+  CHECK(mgutility::chrono::detail::mktime(seconds, time_struct) == std::errc{});
+  CHECK(static_cast<int64_t>(seconds) == 253402300799);
+
+  for (int32_t days = -719162; days <= 2932896; days += 97) {
+    int32_t year = 0;
+    uint32_t month = 0;
+    uint32_t day = 0;
+    mgutility::chrono::detail::civil_from_days(days, year, month, day);
+    REQUIRE(mgutility::chrono::detail::days_from_civil(year, month, day) == days);
+  }
+
+#if MGUTILITY_CPLUSPLUS > 201103L
+  static_assert(mgutility::chrono::detail::days_from_civil(2023, 4, 30) == 19477, "constexpr");
+#endif
 }
 
 TEST_CASE("Error Handling") {
@@ -79,4 +239,179 @@ TEST_CASE("Error Handling") {
   REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%H:%M:%S %p}", "2023-04-30T12:00:00")); // Missing AM/PM
   REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T.%f}", "2023-04-30T16:22:18.")); // No digits after decimal
   REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T.%f}", "2023-04-30T16:22:18.A")); // Invalid fraction
-}
\ No newline at end of file
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%Y%m%d}", "27\v10120")); // Digits cut short
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%FT%T}", "2023-04-30T16:2 :18")); // Digits cut short
+  REQUIRE_THROWS(mgutility::chrono::parse("{:%Y-%m-%d}", "-023-04-30")); // Negative year
+}
+
+TEST_CASE("Compiled Format") {
+  using std::chrono::milliseconds;
+
+  MGUTILITY_CNSTXPR auto iso = mgutility::chrono::compile("{:%FT%T}");
+  MGUTILITY_CNSTXPR auto iso_fraction_tz = mgutility::chrono::compile("{:%FT%T.%f%z}");
+  MGUTILITY_CNSTXPR auto am_pm = mgutility::chrono::compile("{:%FT%H:%M:%S %p}");
+
+  CHECK(to_milliseconds(mgutility::chrono::parse(iso, "2023-04-30T16:22:18")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(mgutility::chrono::parse(iso_fraction_tz, "2023-04-30T18:22:18.123+0200")) == milliseconds(1682871738123));
+  CHECK(to_milliseconds(mgutility::chrono::parse(iso_fraction_tz, "2023-04-30T16:22:18.5Z")) == milliseconds(1682871738500));
+  CHECK(to_milliseconds(mgutility::chrono::parse(am_pm, "2023-04-30T11:59:59 PM")) == milliseconds(1682899199000));
+
+  REQUIRE_THROWS(mgutility::chrono::parse(iso, "2023-04-30 16:22:18")); // Format mismatch
+  REQUIRE_THROWS(mgutility::chrono::parse(iso, "2023-04-31T12:00:00")); // Invalid date (April 31)
+  REQUIRE_THROWS(mgutility::chrono::parse(iso_fraction_tz, "2023-04-30T16:22:18.")); // No digits after decimal
+  REQUIRE_THROWS(mgutility::chrono::parse(am_pm, "2023-04-30T12:00:00")); // Missing AM/PM
+
+  const auto invalid = mgutility::chrono::compile("{:%FT%Q}");
+  CHECK(invalid.error == std::errc::invalid_argument);
+  REQUIRE_THROWS(mgutility::chrono::parse(invalid, "2023-04-30T16:22:18")); // Unknown specifier
+
+#if MGUTILITY_CPLUSPLUS > 201103L
+  static_assert(iso.error == std::errc{}, "compiled at compile time");
+  static_assert(iso.size == 3, "%F, 'T' and %T");
+#endif
+
+#ifdef MGUTILITY_CHRONO_HAS_FIXED_STRING
+  constexpr auto iso_template = mgutility::chrono::compile<"{:%FT%T.%f%z}">();
+  CHECK(to_milliseconds(mgutility::chrono::parse(iso_template, "2023-04-30T18:22:18.123+0200")) == milliseconds(1682871738123));
+#endif
+}
+
+TEST_CASE("Parse Diagnostics") {
+  using mgutility::chrono::diagnostics;
+  using mgutility::chrono::parse_stage;
+  static_assert(std::is_trivially_copyable<mgutility::chrono::parse_result>::value, "parse_result must be trivially copyable");
+  static_assert(sizeof(mgutility::chrono::parse_result) <= 16, "parse_result must fit in two registers");
+
+  std::chrono::system_clock::time_point time_point;
+  auto result = mgutility::chrono::parse(time_point, "{:%F %T}", "2023-04-30 16:22:18", diagnostics);
+  CHECK(result.ok());
+  CHECK(result.position == 19);
+  CHECK(result.stage == parse_stage::none);
+  CHECK(to_milliseconds(time_point).count() == 1682871738000);
+
+  // The day of %F is out of range: the position is that of the day
+  result = mgutility::chrono::parse(time_point, "{:%F %T}", "2023-04-31 16:22:18", diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.position == 8);
+  CHECK(result.specifier == 'F');
+  CHECK(result.stage == parse_stage::field);
+
+  result = mgutility::chrono::parse(time_point, "{:%FT%T}", "2023-04-30X16:22:18", diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 10);
+  CHECK(result.stage == parse_stage::separator);
+
+  result = mgutility::chrono::parse(time_point, "{:%FT%T%z}", "2023-04-30T16:22:18+1401", diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.position == 19);
+  CHECK(result.specifier == 'z');
+
+  result = mgutility::chrono::parse(time_point, "{:%FT%T%z}", "2023-04-30T16:22:18+0160", diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.specifier == 'z');
+
+  result = mgutility::chrono::parse(time_point, "{:%FT%Q}", "2023-04-30T16:22:18", diagnostics);
+  CHECK(result.specifier == 'Q');
+  CHECK(result.stage == parse_stage::format);
+  CHECK(mgutility::chrono::parse(time_point, "{%F}", "2023-04-30", diagnostics).stage == parse_stage::format);
+
+  result = mgutility::chrono::parse(time_point, "{:%F %T %Z}", "2023-04-30 16:22:18 Europe/Istanbul", diagnostics);
+  CHECK(result.error == std::errc::not_supported);
+  CHECK(result.stage == parse_stage::conversion);
+
+  const auto iso = mgutility::chrono::compile("{:%FT%T.%f}");
+  result = mgutility::chrono::parse(time_point, iso, "2023-04-30T16:a2:18.123", diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 14);
+  CHECK(result.specifier == 'T');
+  CHECK(result.stage == parse_stage::field);
+  CHECK(mgutility::chrono::parse(time_point, iso, "2023-04-30T16:22:18.123", diagnostics).position == 23);
+}
+
+TEST_CASE("Names And Variable Width Fields") {
+  using std::chrono::milliseconds;
+  using mgutility::chrono::parse;
+
+  // RFC 7231 HTTP dates, RFC 850 dates and asctime()
+  CHECK(to_milliseconds(parse("{:%a, %d %b %Y %T %Z}", "Sun, 06 Nov 1994 08:49:37 GMT")) == milliseconds(784111777000));
+  CHECK(to_milliseconds(parse("{:%A, %d-%b-%y %T %Z}", "Sunday, 06-Nov-94 08:49:37 GMT")) == milliseconds(784111777000));
+  CHECK(to_milliseconds(parse("{:%a %b %e %T %Y}", "Sun Nov  6 08:49:37 1994")) == milliseconds(784111777000));
+  CHECK(to_milliseconds(parse("{:%a %b %e %T %Y}", "Wed Nov 16 08:49:37 1994")) == milliseconds(784975777000));
+  // syslog has no year
+  CHECK(to_milliseconds(parse("{:%b %e %T}", "Apr  3 14:05:01")) == milliseconds(-2200989299000));
+  CHECK(to_milliseconds(parse("{:%d %B %Y}", "30 APRIL 2023")) == milliseconds(1682812800000));
+  CHECK(to_milliseconds(parse("{:%F %I:%M:%S %p}", "2023-04-30 04:22:18 PM")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(parse("{:%y%m%d}", "680101")) == to_milliseconds(parse("{:%F}", "2068-01-01")));
+  CHECK(to_milliseconds(parse("{:%y%m%d}", "690101")) == to_milliseconds(parse("{:%F}", "1969-01-01")));
+
+  std::chrono::system_clock::time_point time_point;
+  CHECK(mgutility::chrono::parse(time_point, "{:%d %B %Y}", "30 Apri 2023") == std::make_error_code(std::errc::invalid_argument));
+  CHECK(mgutility::chrono::parse(time_point, "{:%A}", "Sundae") == std::make_error_code(std::errc::invalid_argument));
+  CHECK(mgutility::chrono::parse(time_point, "{:%b}", "Nv") == std::make_error_code(std::errc::invalid_argument));
+  CHECK(mgutility::chrono::parse(time_point, "{:%F %I}", "2023-04-30 13") == std::make_error_code(std::errc::result_out_of_range));
+  CHECK(mgutility::chrono::parse(time_point, "{:%b %e}", "Apr   3") == std::make_error_code(std::errc::invalid_argument));
+
+  // A weekday must agree with a date that has a year
+  auto result = mgutility::chrono::parse(time_point, "{:%a, %d %b %Y %T %Z}", "Mon, 06 Nov 1994 08:49:37 GMT", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.stage == mgutility::chrono::parse_stage::conversion);
+  CHECK(mgutility::chrono::parse(time_point, "{:%F %u}", "2023-04-30 3") == std::make_error_code(std::errc::invalid_argument));
+  CHECK(to_milliseconds(parse("{:%F %u}", "2023-04-30 7")) == milliseconds(1682812800000));
+  CHECK(to_milliseconds(parse("{:%Y-%j %a}", "2023-120 Sun")) == milliseconds(1682812800000));
+  CHECK(mgutility::chrono::parse(time_point, "{:%Y-%j %a}", "2023-120 Sat") == std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_CASE("Day Of Year And Week Dates") {
+  using std::chrono::milliseconds;
+  using mgutility::chrono::parse;
+  using mgutility::chrono::diagnostics;
+
+  CHECK(to_milliseconds(parse("{:%Y-%j}", "2024-060")) == milliseconds(1709164800000));
+  CHECK(to_milliseconds(parse("{:%Y-%jT%T%z}", "2023-120T16:22:18+0300")) == milliseconds(1682860938000));
+  CHECK(to_milliseconds(parse("{:%G-W%V-%u}", "2020-W53-7")) == milliseconds(1609632000000));
+  CHECK(to_milliseconds(parse("{:%G-W%V}", "2026-W01")) == milliseconds(1766966400000));
+  CHECK(to_milliseconds(parse("{:%G-W%V %a}", "2020-W53 Sun")) == milliseconds(1609632000000));
+
+  std::chrono::system_clock::time_point time_point;
+  auto result = parse(time_point, "{:%Y-%j}", "2023-366", diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.specifier == 'j');
+  CHECK(result.stage == mgutility::chrono::parse_stage::conversion);
+  result = parse(time_point, mgutility::chrono::compile("{:%G-W%V-%u}"), "2021-W53-1", diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.specifier == 'V');
+  CHECK(parse(time_point, "{:%G-W%V-%u}", "2021-W52-8") == std::make_error_code(std::errc::result_out_of_range));
+}
+
+TEST_CASE("Epoch Seconds") {
+  using std::chrono::milliseconds;
+  using mgutility::chrono::parse;
+
+  CHECK(to_milliseconds(parse("{:%s}", "1682871738")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(parse("{:%s}", "-1")) == milliseconds(-1000));
+  CHECK(to_milliseconds(parse("{:%s.%f}", "1682871738.250")) == milliseconds(1682871738250));
+  CHECK(to_milliseconds(parse(mgutility::chrono::compile("{:%s.%f}"), "0.5")) == milliseconds(500));
+
+  std::chrono::system_clock::time_point time_point;
+  CHECK(parse(time_point, "{:%s}", "253402300800") == std::make_error_code(std::errc::result_out_of_range));
+  CHECK(parse(time_point, "{:%s}", "-") == std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_CASE("Literal Runs") {
+  using std::chrono::milliseconds;
+  using mgutility::chrono::parse;
+  using mgutility::chrono::diagnostics;
+
+  CHECK(to_milliseconds(parse("{:[%F %T]}", "[2023-04-30 16:22:18]")) == milliseconds(1682871738000));
+  CHECK(to_milliseconds(parse(mgutility::chrono::compile("{:%F at %T}"), "2023-04-30 at 16:22:18")) ==
+        milliseconds(1682871738000));
+
+  std::chrono::system_clock::time_point time_point;
+  auto result = parse(time_point, "{:[%F]}", "2023-04-30]", diagnostics);
+  CHECK(result.error == std::errc::invalid_argument);
+  CHECK(result.position == 0);
+  CHECK(result.stage == mgutility::chrono::parse_stage::separator);
+  result = parse(time_point, "{:%F at %T}", "2023-04-30 on 16:22:18", diagnostics);
+  CHECK(result.position == 11);
+  CHECK(result.stage == mgutility::chrono::parse_stage::separator);
+}
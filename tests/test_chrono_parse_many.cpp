@@ -0,0 +1,83 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/parse_many.hpp"
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using time_point = std::chrono::system_clock::time_point;
+
+// Checks that parse_many() agrees with parse() for every input.
+static void check_matches_parse(mgutility::string_view format, const std::vector<mgutility::string_view> &input) {
+  std::vector<time_point> output(input.size());
+  std::vector<std::errc> errors(input.size());
+  const auto failures = mgutility::chrono::parse_many(format, input.data(), input.size(), output.data(), errors.data());
+
+  std::size_t expected_failures = 0;
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    time_point expected{};
+    const auto error = mgutility::chrono::parse(expected, format, input[i]);
+    expected_failures += error ? 1 : 0;
+    if (error) {
+      CHECK(std::make_error_code(errors[i]) == error);
+    } else {
+      CHECK(errors[i] == std::errc{});
+      CHECK(output[i] == expected);
+    }
+  }
+  CHECK(failures == expected_failures);
+}
+
+TEST_CASE("Fixed-Width Layouts Match parse()") {
+  check_matches_parse("{:%FT%T}", {"2023-04-30T16:22:18", "1969-12-31T23:59:59", "2000-02-29T12:00:00",
+                                   "2023-04-31T12:00:00", "2023-04-30 16:22:18", "2023/04/30T16:22:18",
+                                   "2023-04-30T24:00:00", "2023-04-30T16:22:1x", "not-a-date-at-all!!"});
+  check_matches_parse("{:%FT%T.%f}", {"2023-04-30T16:22:18.1", "2023-04-30T16:22:18.123", "2023-04-30T16:22:18.123456789",
+                                      "2023-04-30T16:22:18.1234567891", "1969-12-31T23:59:59.250", "2023-04-30T16:22:18.",
+                                      "2023-04-30T16:22:18.A"});
+  check_matches_parse("{:%FT%T%z}", {"2023-04-30T16:22:18Z", "2023-04-30T18:22:18+0200", "2023-04-30T16:22:18-0200",
+                                     "2023-04-30T18:22:18+02:00", "2016-02-29T12:00:00-1200", "2000-03-01T00:30:00+0100",
+                                     "2023-04-30T16:22:18+1300", "2023-04-30T16:22:18+0260", "2023-04-30T16:22:18X",
+                                     "2023-04-30T16:22:18-1400", "2023-04-30T16:22:18+14:01", "2023-04-30T16:22:18+03",
+                                     "2023-04-30T16:22:18+01:00:30", "2023-04-30T16:22:18+010030", "1899-12-31T23:00:00-0100"});
+  check_matches_parse("{:%FT%T.%f%z}", {"2023-04-30T18:22:18.123+0200", "2023-04-30T16:22:18.5Z", "2023-04-30T16:22:18.5"});
+}
+
+TEST_CASE("Other Formats Fall Back To get_time") {
+  check_matches_parse("{:%FT%H:%M:%S %p}", {"2023-04-30T12:00:00 AM", "2023-04-30T11:59:59 PM", "2023-04-30T13:00:00 AM"});
+  check_matches_parse("{:%Y/%m/%d}", {"2023/04/30", "2023/02/29"});
+}
+
+TEST_CASE("Packed Fixed-Width Records") {
+  using std::chrono::milliseconds;
+
+  const char records[] = "2023-04-30T16:22:18|"
+                         "2023-04-31T16:22:18|"
+                         "2022-12-31T23:59:59|";
+  time_point output[3]{};
+  std::errc errors[3]{};
+  CHECK(mgutility::chrono::parse_many("{:%FT%T}", records, 20, 3, output, errors) == 1);
+  CHECK(errors[0] == std::errc{});
+  CHECK(errors[1] == std::errc::result_out_of_range);
+  CHECK(errors[2] == std::errc{});
+  CHECK(std::chrono::duration_cast<milliseconds>(output[0].time_since_epoch()) == milliseconds(1682871738000));
+  CHECK(std::chrono::duration_cast<milliseconds>(output[2].time_since_epoch()) == milliseconds(1672531199000));
+}
+
+TEST_CASE("Fixed-Width Kernel") {
+  using mgutility::chrono::detail::iso_layout;
+
+  CHECK(mgutility::chrono::detail::detect_iso_layout("{:%FT%T}") == iso_layout::date_time);
+  CHECK(mgutility::chrono::detail::detect_iso_layout("{:%FT%T.%f%z}") == iso_layout::fraction_offset);
+  CHECK(mgutility::chrono::detail::detect_iso_layout("{:%F %T}") == iso_layout::none);
+
+  int64_t seconds = 0;
+  uint32_t nanoseconds = 0;
+  CHECK(mgutility::chrono::detail::parse_iso_fixed("2023-04-30T18:22:18.123+02:00", iso_layout::fraction_offset, seconds, nanoseconds));
+  CHECK(seconds == 1682871738);
+  CHECK(nanoseconds == 123000000);
+  CHECK_FALSE(mgutility::chrono::detail::parse_iso_fixed("2023-04-30T16:22:18", iso_layout::fraction, seconds, nanoseconds));
+  CHECK_FALSE(mgutility::chrono::detail::parse_iso_fixed("2023-04-30T16:22", iso_layout::date_time, seconds, nanoseconds));
+}
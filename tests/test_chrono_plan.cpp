@@ -0,0 +1,143 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/plan.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::make_parser;
+using mgutility::chrono::parse_plan;
+using mgutility::chrono::parse_stage;
+
+// Checks that a plan gives the same time point and diagnostics as the format string
+void check_same(mgutility::string_view format, mgutility::string_view date_str) {
+  INFO(std::string{format.data(), format.size()} << " " << std::string{date_str.data(), date_str.size()});
+  std::chrono::system_clock::time_point expected{};
+  std::chrono::system_clock::time_point actual{};
+  const auto plan = make_parser(format);
+  const auto expected_result = mgutility::chrono::parse(expected, format, date_str, mgutility::chrono::diagnostics);
+  const auto result = mgutility::chrono::parse(actual, plan, date_str, mgutility::chrono::diagnostics);
+  CHECK(result.error == expected_result.error);
+  CHECK(result.position == expected_result.position);
+  CHECK(result.specifier == expected_result.specifier);
+  CHECK(result.stage == expected_result.stage);
+  CHECK(actual == expected);
+}
+
+TEST_CASE("Fixed Width Layouts") {
+  CHECK(make_parser("{:%FT%T}").fixed_width());
+  CHECK(make_parser("{:%FT%T}").width() == 19);
+  CHECK(make_parser("{:%d.%m.%Y %I:%M:%S %p}").width() == 22);
+  CHECK(make_parser("{:%a, %d %b %Y %H%M%S}").width() == 23);
+  CHECK(make_parser("{:%G-W%V-%u}").width() == 10);
+  CHECK_FALSE(make_parser("{:%FT%T.%f}").fixed_width());
+  CHECK_FALSE(make_parser("{:%FT%T%z}").fixed_width());
+  CHECK_FALSE(make_parser("{:%e %B %Y}").fixed_width());
+  CHECK(make_parser("{:%FT%T.%f}").width() == 0);
+
+  check_same("{:%FT%T}", "2023-04-30T16:22:18");
+  check_same("{:%Y-%m-%d %H:%M:%S}", "2024-02-29 23:59:59");
+  check_same("{:%Y%m%d%H%M%S}", "20230430162218");
+  check_same("{:%d.%m.%Y %I:%M:%S %p}", "30.04.2023 12:22:18 AM");
+  check_same("{:%d.%m.%Y %I:%M:%S %p}", "30.04.2023 04:22:18 PM");
+  check_same("{:%a, %d %b %Y %H%M%S}", "Sun, 30 Apr 2023 162218");
+  check_same("{:%y%j}", "23120");
+  check_same("{:%G-W%V-%u}", "2020-W53-7");
+  check_same("{:%FT%T}", "2016-12-31T23:59:60");
+  check_same("{:%FT%T}", "2023-04-30T16:22:18 and the rest of the line");
+  check_same("{:%FT%T}", "1899-12-31T23:00:00");
+  check_same("{:[%F %T]}", "[2023-04-30 16:22:18]");
+}
+
+TEST_CASE("Fixed Width Failures Match parse()") {
+  check_same("{:%FT%T}", "2023-04-30T16:22:1");
+  check_same("{:%FT%T}", "2023-04-31T16:22:18");
+  check_same("{:%FT%T}", "2023-02-29T16:22:18");
+  check_same("{:%FT%T}", "2023-04-30X16:22:18");
+  check_same("{:%FT%T}", "2023-04-30T24:22:18");
+  check_same("{:%FT%T}", "2023-04-30T16:60:18");
+  check_same("{:%FT%T}", "2015-12-31T23:59:60");
+  check_same("{:%FT%T}", "2023-4-30T16:22:18 ");
+  check_same("{:%FT%T}", "+023-04-30T16:22:18");
+  check_same("{:%FT%T}", "");
+  check_same("{:%Y-%m-%d}", "2023-13-01");
+  check_same("{:%d.%m.%Y %I:%M:%S %p}", "30.04.2023 13:22:18 PM");
+  check_same("{:%d.%m.%Y %I:%M:%S %p}", "30.04.2023 04:22:18 XM");
+  check_same("{:%a, %d %b %Y %H%M%S}", "Sun, 30 Abc 2023 162218");
+  check_same("{:%y%j}", "23367");
+  check_same("{:%G-W%V-%u}", "2021-W53-1");
+  check_same("{:%G-W%V-%u}", "2021-W13-8");
+}
+
+TEST_CASE("Variable Width Layouts") {
+  check_same("{:%FT%T.%f%z}", "2023-04-16T00:05:23.999+0100");
+  check_same("{:%FT%T.%f%z}", "2023-04-16T00:05:23.+0100");
+  check_same("{:%e %B %Y %H:%M}", " 3 February 2023 10:30");
+  check_same("{:%F %T %Z}", "2023-04-30 16:22:18 UTC");
+  check_same("{:%s}", "-1");
+  check_same("{:%FT%T%z}", "2023-04-30T16:22:18+15:00");
+}
+
+TEST_CASE("Invalid Formats") {
+  CHECK(make_parser("{:%FT%T}").error() == std::errc{});
+  CHECK(make_parser("%FT%T").error() == std::errc::invalid_argument);
+  CHECK(make_parser("{:%FT%Q}").error() == std::errc::invalid_argument);
+  CHECK(make_parser("{:%FT%T%}").error() == std::errc::invalid_argument);
+  CHECK_FALSE(make_parser("{:%Q}").fixed_width());
+
+  const std::string too_long = "{:" + std::string(parse_plan::capacity + 1, '-') + "}";
+  CHECK(make_parser(too_long).error() == std::errc::value_too_large);
+  const std::string longest = "{:" + std::string(parse_plan::capacity, '-') + "}";
+  CHECK(make_parser(longest).error() == std::errc{});
+
+  std::chrono::system_clock::time_point time_point{};
+  const auto result = mgutility::chrono::parse(time_point, make_parser(too_long), "-", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::value_too_large);
+  CHECK(result.stage == parse_stage::format);
+
+  // As with compile(), an invalid format fails before reading the input
+  const auto invalid = mgutility::chrono::parse(time_point, make_parser("{:%FT%Q}"), "2023-04-30T16:22:18", mgutility::chrono::diagnostics);
+  CHECK(invalid.error == std::errc::invalid_argument);
+  CHECK(invalid.position == 0);
+  CHECK(invalid.stage == parse_stage::format);
+}
+
+TEST_CASE("Plan Overloads") {
+  const auto plan = make_parser("{:%d/%m/%Y %H:%M:%S}");
+  int64_t millis = 0;
+  CHECK(mgutility::chrono::parse_epoch<std::milli>(millis, plan, "30/04/2023 16:22:18") == std::error_code{});
+  CHECK(millis == 1682871738000);
+  std::chrono::duration<int32_t> seconds{};
+  const auto result = mgutility::chrono::parse_epoch(seconds, plan, "19/01/2038 03:14:08", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == parse_stage::conversion);
+
+  CHECK(mgutility::chrono::parse(plan, "30/04/2023 16:22:18").time_since_epoch() == std::chrono::seconds{1682871738});
+  REQUIRE_THROWS(mgutility::chrono::parse(plan, "31/04/2023 16:22:18"));
+}
+
+TEST_CASE("Plans Are Shared Between Threads") {
+  const auto plan = make_parser("{:%FT%T}");
+  const parse_plan copy = plan;
+  std::vector<int64_t> counts(4);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    threads.emplace_back([&copy, &counts, i] {
+      const std::string date_str = "2023-04-30T16:22:1" + std::to_string(i);
+      for (int repeat = 0; repeat < 1000; ++repeat) {
+        mgutility::chrono::parse_epoch(counts[i], copy, date_str);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    CHECK(counts[i] == 1682871730 + static_cast<int64_t>(i));
+  }
+}
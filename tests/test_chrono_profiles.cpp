@@ -0,0 +1,126 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/profiles.hpp"
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+
+// trunk-ignore-all(clang-format)
+
+namespace formats = mgutility::chrono::formats;
+using mgutility::chrono::parse_stage;
+using mgutility::chrono::profile;
+
+// Milliseconds since the epoch, or -1 if the input does not parse
+auto epoch_millis(const profile &format, mgutility::string_view date_str) -> int64_t {
+  int64_t count = 0;
+  return mgutility::chrono::parse_epoch<std::milli>(count, format, date_str, mgutility::chrono::diagnostics).ok() ? count
+                                                                                                                    : -1;
+}
+
+// Checks that a profile and a format string agree on an input
+void check_same(const profile &format, mgutility::string_view format_string, mgutility::string_view date_str) {
+  int64_t expected = 0;
+  REQUIRE(mgutility::chrono::parse_epoch<std::milli>(expected, format_string, date_str) == std::error_code{});
+  CHECK(epoch_millis(format, date_str) == expected);
+}
+
+TEST_CASE("RFC 3339") {
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18Z") == 1682871738000);
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T18:22:18.250+02:00") == 1682871738250);
+  CHECK(epoch_millis(formats::rfc3339, "1969-12-31T23:59:59.250-00:00") == -750);
+  check_same(formats::rfc3339, "{:%FT%T.%f%z}", "2016-02-29T12:00:00.123456789-12:00");
+  // Any number of fraction digits, truncated to nanoseconds
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18.1234567891Z") == 1682871738123);
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30T16:22:18.99999999999") == 1682871738999);
+
+  // Strict mode only accepts the layout of the specification
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18") == -1);          // No offset
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30t16:22:18Z") == -1);         // Lowercase t
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30 16:22:18Z") == -1);         // Space
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18z") == -1);         // Lowercase z
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T18:22:18+0200") == -1);     // No colon
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T18:22:18+02") == -1);       // Hours only
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18,250Z") == -1);     // Comma
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18.Z") == -1);        // No digits
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18Z ") == -1);        // Trailing space
+  CHECK(epoch_millis(formats::rfc3339, "2023-02-29T16:22:18Z") == -1);         // Not a leap year
+  CHECK(epoch_millis(formats::rfc3339, "2023-04-30T16:22:18+14:01") == -1);
+
+  // Lenient mode accepts the usual deviations
+  const auto lenient = formats::rfc3339.lenient();
+  CHECK(epoch_millis(lenient, "2023-04-30t16:22:18z") == 1682871738000);
+  CHECK(epoch_millis(lenient, "2023-04-30 18:22:18,250+0200") == 1682871738250);
+  CHECK(epoch_millis(lenient, "2023-04-30T18:22:18+02") == 1682871738000);
+  CHECK(epoch_millis(lenient, "2023-04-30T16:22:18") == 1682871738000);
+  CHECK(epoch_millis(lenient, "2023-04-30T16:22:18.2501234567Z") == 1682871738250);
+  CHECK(epoch_millis(lenient, "2023-04-30") == 1682812800000);
+  CHECK(epoch_millis(lenient, "2023-04-30T16:22Z") == -1);
+  CHECK(epoch_millis(lenient, "2023-04-30T16:22:18Zjunk") == -1);
+}
+
+TEST_CASE("ISO 8601 Extended And Basic") {
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30T16:22:18") == 1682871738000);
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30T18:22:18,250+02") == 1682871738250);
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30T18:22:18.250+02:00") == 1682871738250);
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30T18:22:18+0200") == -1);
+  CHECK(epoch_millis(formats::iso8601, "2023-04-30") == -1);
+  check_same(formats::iso8601, "{:%FT%T}", "1899-12-31T23:00:00");
+
+  CHECK(epoch_millis(formats::iso8601_basic, "20230430T162218Z") == 1682871738000);
+  CHECK(epoch_millis(formats::iso8601_basic, "20230430T182218.25+0200") == 1682871738250);
+  CHECK(epoch_millis(formats::iso8601_basic, "20230430T182218+02") == 1682871738000);
+  CHECK(epoch_millis(formats::iso8601_basic, "20230430T18:22:18+02") == -1);
+  CHECK(epoch_millis(formats::iso8601_basic, "20230430T182218+02:00") == -1);
+  CHECK(epoch_millis(formats::iso8601_basic, "2023-04-30T16:22:18Z") == -1);
+  CHECK(epoch_millis(formats::iso8601_basic, "20231330T162218Z") == -1);
+  check_same(formats::iso8601_basic, "{:%Y%m%dT%H%M%S%z}", "20000301T003000+0100");
+
+  const auto lenient = formats::iso8601_basic.lenient();
+  CHECK(epoch_millis(lenient, "20230430 182218+02:00") == 1682871738000);
+  CHECK(epoch_millis(lenient, "20230430") == 1682812800000);
+}
+
+TEST_CASE("ISO Week Dates") {
+  CHECK(epoch_millis(formats::iso_week_date, "2023-W17-7") == 1682812800000);
+  CHECK(epoch_millis(formats::iso_week_date, "2023-W17-7T16:22:18Z") == 1682871738000);
+  check_same(formats::iso_week_date, "{:%G-W%V-%u}", "2020-W53-7");
+  check_same(formats::iso_week_date, "{:%G-W%V-%u}", "2019-W01-1");
+  CHECK(epoch_millis(formats::iso_week_date, "2021-W53-1") == -1); // 2021 has 52 weeks
+  CHECK(epoch_millis(formats::iso_week_date, "2023-W17-8") == -1);
+  CHECK(epoch_millis(formats::iso_week_date, "2023-W17") == -1);
+  CHECK(epoch_millis(formats::iso_week_date, "2023W177") == -1);
+  CHECK(epoch_millis(formats::iso_week_date, "2023-w17-7") == -1);
+
+  const auto lenient = formats::iso_week_date.lenient();
+  CHECK(epoch_millis(lenient, "2023W177") == 1682812800000);
+  CHECK(epoch_millis(lenient, "2023-w17-7") == 1682812800000);
+  CHECK(epoch_millis(lenient, "2023-W17") == 1682294400000); // Monday
+  CHECK(epoch_millis(lenient, "2023-W17 16:22:18") == 1682353338000);
+}
+
+TEST_CASE("Profile Diagnostics And Overloads") {
+  std::chrono::system_clock::time_point time_point{};
+  auto result = mgutility::chrono::parse(time_point, formats::rfc3339, "2023-04-31T16:22:18Z", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.position == 8);
+  CHECK(result.specifier == 'd');
+  CHECK(result.stage == parse_stage::field);
+
+  result = mgutility::chrono::parse(time_point, formats::rfc3339, "2023-04-30X16:22:18Z", mgutility::chrono::diagnostics);
+  CHECK(result.position == 10);
+  CHECK(result.stage == parse_stage::separator);
+
+  result = mgutility::chrono::parse(time_point, formats::iso8601, "2023-04-30T16:22:18+03:00x", mgutility::chrono::diagnostics);
+  CHECK(result.position == 25);
+  CHECK(result.stage == parse_stage::separator);
+
+  CHECK(mgutility::chrono::parse(time_point, formats::rfc3339, "2023-04-30T16:22:18Z") == std::error_code{});
+  CHECK(mgutility::chrono::parse(formats::rfc3339, "2023-04-30T16:22:18Z") == time_point);
+  REQUIRE_THROWS(mgutility::chrono::parse(formats::rfc3339, "2023-04-30T16:22:18"));
+
+  std::chrono::duration<int32_t> seconds{};
+  result = mgutility::chrono::parse_epoch(seconds, formats::iso8601, "2038-01-19T03:14:08", mgutility::chrono::diagnostics);
+  CHECK(result.error == std::errc::result_out_of_range);
+  CHECK(result.stage == parse_stage::conversion);
+}
@@ -0,0 +1,129 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/format.hpp"
+#include "mgutility/chrono/seek.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using seconds_point = std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>;
+
+constexpr int64_t start_seconds = 1682812800; // 2023-04-30T00:00:00Z
+
+auto at(int64_t seconds) -> std::chrono::system_clock::time_point {
+  return std::chrono::system_clock::time_point{std::chrono::seconds{start_seconds + seconds}};
+}
+
+// A log with one line per second given as an offset from start_seconds, and
+// the start of each line. Every tenth line is followed by an unparseable one.
+struct test_log {
+  std::string data;
+  std::vector<std::pair<int64_t, std::size_t>> lines;
+};
+
+auto make_log(const std::vector<int64_t> &seconds) -> test_log {
+  test_log log;
+  char buffer[32]; // NOLINT
+  for (std::size_t i = 0; i < seconds.size(); ++i) {
+    log.lines.emplace_back(seconds[i], log.data.size());
+    const auto result = mgutility::chrono::format_to(buffer, "{:%FT%T}", seconds_point{std::chrono::seconds{start_seconds + seconds[i]}});
+    log.data.append(buffer, result.out);
+    log.data += " INFO request " + std::to_string(i) + "\n";
+    if (i % 10 == 9) {
+      log.data += "    at handler (server.cpp:42)\n";
+    }
+  }
+  return log;
+}
+
+// The start of the first line, in file order, at or after a time
+auto reference_bound(const test_log &log, int64_t seconds) -> std::size_t {
+  for (const auto &line : log.lines) {
+    if (line.first >= seconds) {
+      return line.second;
+    }
+  }
+  return log.data.size();
+}
+
+TEST_CASE("Seeking A Sorted Log") {
+  std::vector<int64_t> seconds;
+  for (int64_t i = 0; i < 100000; ++i) {
+    seconds.push_back(i);
+  }
+  const auto log = make_log(seconds);
+  const mgutility::string_view data{log.data};
+  auto seeker = mgutility::chrono::make_time_seeker("{:%FT%T}");
+
+  for (int64_t target : {-5, 0, 1, 9, 10, 11, 12345, 50000, 99990, 99999, 100000, 200000}) {
+    CHECK(seeker.lower_bound(data, at(target)) == reference_bound(log, target));
+  }
+
+  const auto before = seeker.probes();
+  const auto range = seeker.find(data, at(50700), at(51000));
+  CHECK(range.first == reference_bound(log, 50700));
+  CHECK(range.last == reference_bound(log, 51000));
+  CHECK(seeker.probes() - before < 80); // 2 * log2(100000) is 34
+  const std::string first_line = log.data.substr(range.first, 19);
+  CHECK(first_line == "2023-04-30T14:05:00");
+  // The range ends with the continuation line of its last record
+  CHECK(log.data.substr(range.last - 31, 31) == "    at handler (server.cpp:42)\n");
+
+  CHECK(seeker.find(data, at(51000), at(50700)).first == seeker.find(data, at(51000), at(50700)).last);
+  CHECK(seeker.find(mgutility::string_view{}, at(0), at(10)).last == 0);
+}
+
+TEST_CASE("Seeking With Unparseable And Out Of Order Lines") {
+  std::vector<int64_t> seconds;
+  for (int64_t i = 0; i < 20000; ++i) {
+    seconds.push_back(i);
+  }
+  // Neighbouring lines written by different threads, up to 3 seconds apart
+  for (std::size_t i = 100; i + 3 < seconds.size(); i += 97) {
+    std::swap(seconds[i], seconds[i + 3]);
+  }
+  auto log = make_log(seconds);
+  // A run of lines that never parse
+  const std::size_t junk = log.lines[7000].second;
+  log.data.insert(junk, std::string(200, '#') + "\n" + std::string(5000, 'x') + "\n");
+  for (std::size_t i = 7000; i < log.lines.size(); ++i) {
+    log.lines[i].second += 5202;
+  }
+
+  const mgutility::string_view data{log.data};
+  auto seeker = mgutility::chrono::make_time_seeker("{:%FT%T}", mgutility::chrono::at_offset(0), std::chrono::seconds{3});
+  for (int64_t target = 0; target < 20010; target += 7) {
+    CHECK(seeker.lower_bound(data, at(target)) == reference_bound(log, target));
+  }
+  CHECK(seeker.lower_bound(data, at(7000)) == log.lines[7000].second);
+}
+
+TEST_CASE("Seeking A Column Of A Mapped File") {
+  const std::string contents =
+      "web-1,2023-04-30 14:04:59,GET /\r\n"
+      "web-2,2023-04-30 14:05:00,GET /health\r\n"
+      "truncated\r\n"
+      "web-1,2023-04-30 14:09:59,POST /login\r\n"
+      "web-1,2023-04-30 14:10:00,GET /";
+  const std::string path = "test_chrono_seek.log";
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  REQUIRE(file != nullptr);
+  std::fwrite(contents.data(), 1, contents.size(), file);
+  std::fclose(file);
+
+  mgutility::chrono::mapped_file mapped;
+  REQUIRE(mgutility::chrono::mapped_file::open(path, mapped) == std::errc{});
+  auto seeker = mgutility::chrono::make_time_seeker(mgutility::chrono::compile("{:%F %T}"), mgutility::chrono::at_column(1, ','));
+  const auto range = seeker.find(mapped.view(), at(14 * 3600 + 5 * 60), at(14 * 3600 + 10 * 60));
+  CHECK(contents.substr(range.first, range.last - range.first) ==
+        "web-2,2023-04-30 14:05:00,GET /health\r\n"
+        "truncated\r\n"
+        "web-1,2023-04-30 14:09:59,POST /login\r\n");
+  mapped = mgutility::chrono::mapped_file{};
+  std::remove(path.c_str());
+}
@@ -0,0 +1,113 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/stream.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// trunk-ignore-all(clang-format)
+
+using record = std::pair<int64_t, std::string>;
+
+auto to_milliseconds(std::chrono::system_clock::time_point time_point) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
+}
+
+// Feeds input in chunks of the given size and collects the records.
+template <typename Reader>
+auto read_chunked(Reader &reader, const std::string &input, std::size_t chunk_size) -> std::vector<record> {
+  std::vector<record> records;
+  const auto on_record = [&](std::chrono::system_clock::time_point time_point, mgutility::string_view rest) {
+    records.emplace_back(to_milliseconds(time_point), std::string(rest.data(), rest.size()));
+  };
+  for (std::size_t i = 0; i < input.size(); i += chunk_size) {
+    reader.feed(mgutility::string_view{input.data() + i, std::min(chunk_size, input.size() - i)}, on_record);
+  }
+  reader.finish(on_record);
+  return records;
+}
+
+const std::string log_lines =
+    "2023-04-30T16:22:18 INFO service started\n"
+    "2023-04-30T16:22:19 WARN disk at 91%\r\n"
+    "garbage line\n"
+    "2023-04-30T16:22:20 INFO service stopped";
+
+TEST_CASE("Records At An Offset") {
+  auto reader = mgutility::chrono::make_record_reader("{:%FT%T}");
+  const auto records = read_chunked(reader, log_lines, log_lines.size());
+  REQUIRE(records.size() == 3);
+  CHECK(records[0] == record{1682871738000, "INFO service started"});
+  CHECK(records[1] == record{1682871739000, "WARN disk at 91%"});
+  CHECK(records[2] == record{1682871740000, "INFO service stopped"});
+  CHECK(reader.records() == 3);
+  CHECK(reader.failures() == 1);
+
+  auto offset_reader = mgutility::chrono::make_record_reader("{:%F %T}", mgutility::chrono::at_offset(4));
+  const auto offset_records = read_chunked(offset_reader, "[1] 2023-04-30 16:22:18 first\n", 64);
+  REQUIRE(offset_records.size() == 1);
+  CHECK(offset_records[0] == record{1682871738000, "first"});
+}
+
+TEST_CASE("Records Straddling Chunks") {
+  auto reader = mgutility::chrono::make_record_reader("{:%FT%T}");
+  const auto expected = read_chunked(reader, log_lines, log_lines.size());
+  for (std::size_t chunk_size = 1; chunk_size < log_lines.size(); ++chunk_size) {
+    auto chunked = mgutility::chrono::make_record_reader("{:%FT%T}");
+    CHECK(read_chunked(chunked, log_lines, chunk_size) == expected);
+    CHECK(chunked.failures() == 1);
+  }
+
+  // An empty chunk, even one without data, changes nothing
+  auto empty = mgutility::chrono::make_record_reader("{:%FT%T}");
+  std::vector<record> records;
+  const auto on_record = [&](std::chrono::system_clock::time_point time_point, mgutility::string_view rest) {
+    records.emplace_back(to_milliseconds(time_point), std::string(rest.data(), rest.size()));
+  };
+  empty.feed(mgutility::string_view{}, on_record);
+  empty.feed("2023-04-30T16:22:18 INFO", on_record);
+  empty.feed(mgutility::string_view{}, on_record);
+  empty.finish(on_record);
+  REQUIRE(records.size() == 1);
+  CHECK(records[0] == record{1682871738000, "INFO"});
+}
+
+TEST_CASE("Records At A Column") {
+  const auto format = mgutility::chrono::compile("{:%FT%T.%f}");
+  auto reader = mgutility::chrono::make_record_reader(format, mgutility::chrono::at_column(1, ','));
+  std::vector<std::pair<std::string, uint32_t>> errors;
+  const auto on_record = [](std::chrono::system_clock::time_point time_point, mgutility::string_view rest) {
+    CHECK(to_milliseconds(time_point) == 1682871738500);
+    CHECK(rest == "login");
+  };
+  const auto on_error = [&](mgutility::string_view line, mgutility::chrono::parse_result result) {
+    errors.emplace_back(std::string(line.data(), line.size()), result.position);
+  };
+  CHECK(reader.feed("7,2023-04-30T16:22:18.5,login\n8,2023-04-30T16:22:18.x,login\n9\n", on_record, on_error) == 3);
+  CHECK(reader.records() == 1);
+  REQUIRE(errors.size() == 2);
+  CHECK(errors[0] == std::make_pair(std::string("8,2023-04-30T16:22:18.x,login"), uint32_t{22}));
+  CHECK(errors[1].first == "9");
+}
+
+TEST_CASE("Records From A Mapped File") {
+  const std::string path = "test_chrono_stream.log";
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  REQUIRE(file != nullptr);
+  std::fwrite(log_lines.data(), 1, log_lines.size(), file);
+  std::fclose(file);
+
+  auto reader = mgutility::chrono::make_record_reader("{:%FT%T}");
+  std::vector<int64_t> time_points;
+  CHECK(mgutility::chrono::read_records(path, reader, [&](std::chrono::system_clock::time_point time_point, mgutility::string_view) {
+    time_points.push_back(to_milliseconds(time_point));
+  }) == std::errc{});
+  CHECK(time_points == std::vector<int64_t>{1682871738000, 1682871739000, 1682871740000});
+  CHECK(reader.failures() == 1);
+  std::remove(path.c_str());
+
+  CHECK(mgutility::chrono::read_records("test_chrono_stream.missing", reader, [](std::chrono::system_clock::time_point, mgutility::string_view) {}) ==
+        std::errc::no_such_file_or_directory);
+}
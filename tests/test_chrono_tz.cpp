@@ -0,0 +1,114 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest/doctest.h"
+#include "mgutility/chrono/tz.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// trunk-ignore-all(clang-format)
+
+using mgutility::chrono::get_tzdb;
+using mgutility::chrono::parse;
+
+auto to_milliseconds(std::chrono::system_clock::time_point time_point) -> int64_t {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_point.time_since_epoch()).count();
+}
+
+// The database is compiled from the system zoneinfo, which may be missing
+auto has_tzdb() -> bool { return get_tzdb().zone_count() != 0; }
+
+TEST_CASE("Zone Names Without A Database") {
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2023-04-30 16:22:18 UTC")) == 1682871738000);
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2023-04-30 16:22:18 Z")) == 1682871738000);
+  CHECK(to_milliseconds(parse("{:%FT%T%z %Z}", "2023-04-30T16:22:18+0300 Europe/Istanbul")) == 1682860938000);
+
+  std::chrono::system_clock::time_point time_point;
+  CHECK(parse(time_point, "{:%F %T %Z}", "2023-04-30 16:22:18 Europe/Istanbul") ==
+        std::make_error_code(std::errc::not_supported));
+  CHECK(parse(time_point, "{:%F %T %Z}", "2023-04-30 16:22:18 ") ==
+        std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_CASE("Named Zones") {
+  if (!has_tzdb()) {
+    return;
+  }
+  const auto &database = get_tzdb();
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-07-01 12:00:00 America/New_York", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2024-07-01T12:00:00-0400")));
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-01-15 12:00:00 America/New_York", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2024-01-15T12:00:00-0500")));
+  CHECK(to_milliseconds(parse("{:%FT%T.%f %Z}", "2023-04-30T16:22:18.250 Europe/Istanbul", database)) ==
+        1682860938250);
+  CHECK(to_milliseconds(parse(mgutility::chrono::compile("{:%F %T %Z}"), "2030-01-15 12:00:00 Australia/Sydney", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2030-01-15T12:00:00+1100")));
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2030-07-15 12:00:00 Australia/Sydney", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2030-07-15T12:00:00+1000")));
+  // Beyond the last transition, the POSIX rule of the zone applies
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2100-07-01 12:00:00 America/New_York", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2100-07-01T12:00:00-0400")));
+
+  std::chrono::system_clock::time_point time_point;
+  CHECK(parse(time_point, "{:%F %T %Z}", "2024-07-01 12:00:00 Nowhere/Zone", database) ==
+        std::make_error_code(std::errc::invalid_argument));
+}
+
+TEST_CASE("Gaps And Overlaps") {
+  if (!has_tzdb()) {
+    return;
+  }
+  const auto &database = get_tzdb();
+  // Skipped local time uses the offset before the transition
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-03-10 02:30:00 America/New_York", database)) ==
+        to_milliseconds(parse("{:%FT%T}", "2024-03-10T07:30:00")));
+  // Repeated local time resolves to the earliest instant
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-11-03 01:30:00 America/New_York", database)) ==
+        to_milliseconds(parse("{:%FT%T}", "2024-11-03T05:30:00")));
+
+  mgutility::chrono::time_zone zone;
+  REQUIRE(database.locate_zone("America/New_York", zone) == std::errc{});
+  CHECK(zone.name() == "America/New_York");
+  CHECK(zone.offset_at(1710053999) == -5 * 3600);
+  CHECK(zone.offset_at(1710054000) == -4 * 3600);
+  CHECK(zone.offset_at(4102444800) == -5 * 3600);
+}
+
+TEST_CASE("Abbreviations") {
+  if (!has_tzdb()) {
+    return;
+  }
+  const auto &database = get_tzdb();
+  // An abbreviation is a fixed offset, even when daylight saving time is in effect
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-07-01 12:00:00 CET", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2024-07-01T12:00:00+0100")));
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-07-01 12:00:00 CEST", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2024-07-01T12:00:00+0200")));
+
+  int32_t offset = 0;
+  CHECK(database.abbreviation_offset("EST", offset) == std::errc{});
+  CHECK(offset == -5 * 3600);
+  CHECK(database.abbreviation_offset("IST", offset) == std::errc::invalid_argument);
+}
+
+TEST_CASE("Database Image") {
+  if (!has_tzdb()) {
+    return;
+  }
+  const std::string path = "test_chrono_tz.tzdb";
+  REQUIRE(get_tzdb().save(path) == std::errc{});
+
+  mgutility::chrono::tzdb database;
+  REQUIRE(mgutility::chrono::tzdb::open(path, database) == std::errc{});
+  CHECK(database.zone_count() == get_tzdb().zone_count());
+  CHECK(database.size() == get_tzdb().size());
+  CHECK(to_milliseconds(parse("{:%F %T %Z}", "2024-07-01 12:00:00 Europe/Istanbul", database)) ==
+        to_milliseconds(parse("{:%FT%T%z}", "2024-07-01T12:00:00+0300")));
+
+  mgutility::chrono::tzdb moved{std::move(database)};
+  CHECK(database.zone_count() == 0);
+  CHECK(moved.zone_count() == get_tzdb().zone_count());
+  std::remove(path.c_str());
+
+  CHECK(mgutility::chrono::tzdb::open("test_chrono_tz.missing", database) ==
+        std::errc::no_such_file_or_directory);
+}